@@ -24,6 +24,7 @@ See license.txt for more information
 
 #include "blocking.h"
 #include "thread.h"
+#include "eventtrace.h"
 
 //---------------------------------------------------------------------------
 #if defined __FILE_ID__
@@ -36,12 +37,19 @@ See license.txt for more information
 void BlockingObject_Block( ThreadList_t *pstList_, Thread_t *pstThread_ )
 {
     KERNEL_ASSERT( pstThread_ );
-    KERNEL_TRACE_1( STR_THREAD_BLOCK_1, (K_USHORT)Thread_GetID( pstThread_ ) );
+    KERNEL_TRACE_1( TRACE_LEVEL_VERBOSE, STR_THREAD_BLOCK_1, (K_USHORT)Thread_GetID( pstThread_ ) );
+#if KERNEL_USE_EVENT_TRACE
+    EventTrace_Block( pstThread_, pstList_ );
+#endif
 	
     // Remove the thread from its current thread list (the "owner" list)
     // ... And add the thread to this object's block list    
     Scheduler_Remove( pstThread_ );
+#if KERNEL_USE_PRIORITY_WAITLISTS
+    ThreadList_AddPriority( pstList_, pstThread_ );
+#else
     ThreadList_Add( pstList_, pstThread_ );
+#endif
     
     // Set the "current" list location to the blocklist for this thread
     Thread_SetCurrent( pstThread_, pstList_ );
@@ -52,7 +60,10 @@ void BlockingObject_Block( ThreadList_t *pstList_, Thread_t *pstThread_ )
 void BlockingObject_UnBlock( Thread_t *pstThread_ )
 {
     KERNEL_ASSERT( pstThread_ );
-    KERNEL_TRACE_1( STR_THREAD_UNBLOCK_1, (K_USHORT)Thread_GetID( pstThread_ ) );
+    KERNEL_TRACE_1( TRACE_LEVEL_VERBOSE, STR_THREAD_UNBLOCK_1, (K_USHORT)Thread_GetID( pstThread_ ) );
+#if KERNEL_USE_EVENT_TRACE
+    EventTrace_UnBlock( pstThread_, Thread_GetCurrent( pstThread_ ) );
+#endif
     
 	// Remove the thread from its current thread list (the "owner" list)
     ThreadList_Remove( Thread_GetCurrent( pstThread_ ), pstThread_ );
@@ -0,0 +1,210 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   blockpool.c
+
+    \brief  Fixed-block memory pool
+*/
+
+#include "mark3cfg.h"
+#include "kerneltypes.h"
+#include "ksemaphore.h"
+#include "threadport.h"
+#include "kerneldebug.h"
+#include "blockpool.h"
+
+//---------------------------------------------------------------------------
+#if defined __FILE_ID__
+	#undef __FILE_ID__
+#endif
+#define __FILE_ID__ 	BLOCKPOOL_C       //!< File ID used in kernel trace calls
+
+#if KERNEL_USE_BLOCKPOOL
+
+//---------------------------------------------------------------------------
+void BlockPool_Init( BlockPool_t *pstPool_, void *pvBuffer_, K_USHORT usBufferSize_, K_USHORT usBlockSize_ )
+{
+    K_UCHAR *pucBlock;
+    K_USHORT i;
+
+    KERNEL_ASSERT( pvBuffer_ );
+    KERNEL_ASSERT( 0 == ((K_ADDR)pvBuffer_ & (sizeof(void*) - 1)) );
+
+    // Each free block holds the free-list link, so blocks must be at least
+    // pointer-sized and keep the pointers aligned.
+    if (usBlockSize_ < sizeof(void*))
+    {
+        usBlockSize_ = sizeof(void*);
+    }
+    usBlockSize_ = (usBlockSize_ + sizeof(void*) - 1) & ~(K_USHORT)(sizeof(void*) - 1);
+
+    pstPool_->usBlockSize = usBlockSize_;
+    pstPool_->usBlocks = usBufferSize_ / usBlockSize_;
+    pstPool_->usInUse = 0;
+    pstPool_->usHighWater = 0;
+    pstPool_->usFailures = 0;
+
+    KERNEL_ASSERT( pstPool_->usBlocks );
+
+    // Thread the free list through the blocks, in address order.
+    pucBlock = (K_UCHAR*)pvBuffer_;
+    pstPool_->pucStart = pucBlock;
+    pstPool_->pvFreeList = pucBlock;
+    for (i = 1; i < pstPool_->usBlocks; i++)
+    {
+        *(void**)pucBlock = (void*)(pucBlock + usBlockSize_);
+        pucBlock += usBlockSize_;
+    }
+    *(void**)pucBlock = NULL;
+    pstPool_->pucEnd = pucBlock + usBlockSize_;
+
+    Semaphore_Init( &(pstPool_->stSemaphore), pstPool_->usBlocks, pstPool_->usBlocks );
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief BlockPool_Take_i
+ *
+ * Finish an allocation after the caller has tried to take a count from the
+ * pool's semaphore.  Every count taken is backed by a block on the free
+ * list, which is unlinked and counted as in use.  An attempt that got no
+ * count is recorded as a failure instead.
+ *
+ * \param bCounted_ true if the caller took a count from the semaphore
+ * \return The allocated block, or NULL if no count was taken
+ */
+static void *BlockPool_Take_i( BlockPool_t *pstPool_, K_BOOL bCounted_ )
+{
+    void *pvBlock = NULL;
+
+    CS_ENTER();
+
+    if (bCounted_)
+    {
+        pvBlock = pstPool_->pvFreeList;
+        pstPool_->pvFreeList = *(void**)pvBlock;
+
+        pstPool_->usInUse++;
+        if (pstPool_->usInUse > pstPool_->usHighWater)
+        {
+            pstPool_->usHighWater = pstPool_->usInUse;
+        }
+    }
+    else
+    {
+        pstPool_->usFailures++;
+    }
+
+    CS_EXIT();
+    return pvBlock;
+}
+
+//---------------------------------------------------------------------------
+void *BlockPool_TryAlloc( BlockPool_t *pstPool_ )
+{
+    K_BOOL bCounted = (0 != Semaphore_TryPendN( &(pstPool_->stSemaphore), 1 ));
+    return BlockPool_Take_i( pstPool_, bCounted );
+}
+
+//---------------------------------------------------------------------------
+void *BlockPool_Alloc( BlockPool_t *pstPool_ )
+{
+    Semaphore_Pend( &(pstPool_->stSemaphore) );
+    return BlockPool_Take_i( pstPool_, true );
+}
+
+#if KERNEL_USE_TIMEOUTS
+//---------------------------------------------------------------------------
+void *BlockPool_TimedAlloc( BlockPool_t *pstPool_, K_ULONG ulTimeoutMS_ )
+{
+    K_BOOL bCounted = Semaphore_TimedPend( &(pstPool_->stSemaphore), ulTimeoutMS_ );
+    return BlockPool_Take_i( pstPool_, bCounted );
+}
+#endif
+
+//---------------------------------------------------------------------------
+void BlockPool_Free( BlockPool_t *pstPool_, void *pvBlock_ )
+{
+    KERNEL_ASSERT( pvBlock_ );
+    KERNEL_ASSERT( ((K_UCHAR*)pvBlock_ >= pstPool_->pucStart) &&
+                   ((K_UCHAR*)pvBlock_ < pstPool_->pucEnd) );
+
+    K_BOOL bFreed = false;
+
+    CS_ENTER();
+
+    // Freeing more blocks than are allocated means a block has been freed
+    // twice.  Linking it into the free list again would hand the same block
+    // to two later allocations, so leave the pool untouched.
+    KERNEL_ASSERT( pstPool_->usInUse );
+    if (pstPool_->usInUse)
+    {
+        *(void**)pvBlock_ = pstPool_->pvFreeList;
+        pstPool_->pvFreeList = pvBlock_;
+        pstPool_->usInUse--;
+        bFreed = true;
+    }
+
+    CS_EXIT();
+
+    // BlockPool_Take_i() unlinks the head of the free list without checking
+    // it, so a block must be on the list before its count is posted.
+    if (bFreed)
+    {
+        Semaphore_Post( &(pstPool_->stSemaphore) );
+    }
+}
+
+//---------------------------------------------------------------------------
+K_USHORT BlockPool_GetBlockSize( BlockPool_t *pstPool_ )
+{
+    return pstPool_->usBlockSize;
+}
+
+//---------------------------------------------------------------------------
+K_USHORT BlockPool_GetFree( BlockPool_t *pstPool_ )
+{
+    return Semaphore_GetCount( &(pstPool_->stSemaphore) );
+}
+
+//---------------------------------------------------------------------------
+K_USHORT BlockPool_GetInUse( BlockPool_t *pstPool_ )
+{
+    return pstPool_->usInUse;
+}
+
+//---------------------------------------------------------------------------
+K_USHORT BlockPool_GetHighWater( BlockPool_t *pstPool_ )
+{
+    return pstPool_->usHighWater;
+}
+
+//---------------------------------------------------------------------------
+K_USHORT BlockPool_GetFailures( BlockPool_t *pstPool_ )
+{
+    return pstPool_->usFailures;
+}
+
+//---------------------------------------------------------------------------
+void BlockPool_ResetStats( BlockPool_t *pstPool_ )
+{
+    // Blocks still allocated count towards the new high-water mark
+    CS_ENTER();
+    pstPool_->usHighWater = pstPool_->usInUse;
+    pstPool_->usFailures = 0;
+    CS_EXIT();
+}
+
+#endif // KERNEL_USE_BLOCKPOOL
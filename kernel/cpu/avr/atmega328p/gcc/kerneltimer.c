@@ -29,6 +29,15 @@ See license.txt for more information
 #define TIMER_IMSK        (1 << OCIE1A)
 #define TIMER_IFR        (1 << OCF1A)
 
+#if KERNEL_TIMERS_TICKLESS
+#define TIMER_PRESCALE   (256)
+#else
+#define TIMER_PRESCALE   (64)
+#endif
+
+//! Convert kernel timer counts to microseconds
+#define COUNTS_TO_US(x)  ((((K_ULONG)(x)) * TIMER_PRESCALE) / (SYSTEM_FREQ / 1000000))
+
 //---------------------------------------------------------------------------
 void KernelTimer_Config(void)
 {        
@@ -80,6 +89,22 @@ K_USHORT KernelTimer_Read(void)
 #endif
 }
 
+//---------------------------------------------------------------------------
+K_ULONG KernelTimer_ReadUs(void)
+{
+    K_ULONG ulCount = TCNT1;
+
+    // The counter has been reset by a compare match that hasn't been
+    // serviced yet - count the whole period, and re-read in case the
+    // match happened after the first read.  In CTC mode a period is
+    // OCR1A + 1 counts (0..OCR1A inclusive).
+    if (TIFR1 & TIMER_IFR)
+    {
+        ulCount = (K_ULONG)OCR1A + 1 + TCNT1;
+    }
+    return COUNTS_TO_US(ulCount);
+}
+
 //---------------------------------------------------------------------------
 K_ULONG KernelTimer_SubtractExpiry(K_ULONG ulInterval_)
 {
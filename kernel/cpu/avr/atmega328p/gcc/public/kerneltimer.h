@@ -144,6 +144,19 @@ void KernelTimer_ClearExpiry(void);
 */
 K_USHORT KernelTimer_Read(void);
 
+//---------------------------------------------------------------------------
+/*!
+    \fn K_ULONG KernelTimer_ReadUs(void)
+
+    Return the time elapsed since the last kernel timer interrupt was
+    serviced, in microseconds.  If the timer has expired but its interrupt
+    is still pending, the expired period is included.  Must be called with
+    interrupts disabled.
+
+    \return Microseconds elapsed since the last serviced timer interrupt
+*/
+K_ULONG KernelTimer_ReadUs(void);
+
 #ifdef __cplusplus
     }
 #endif
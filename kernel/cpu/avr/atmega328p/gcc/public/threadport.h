@@ -23,6 +23,7 @@ See license.txt for more information
 
 #include "kerneltypes.h"
 #include "thread.h"
+#include "csstats.h"
 
 #include <avr/io.h>
 #include <avr/interrupt.h>
@@ -139,6 +140,18 @@ ASM("pop r0"); \
 ASM("out __SREG__, r0"); \
 ASM("pop r0");
 
+//------------------------------------------------------------------------
+//! Time the critical section, if it's the one that disabled interrupts
+#if KERNEL_USE_CS_STATS
+#define CS_STATS_ENTER() \
+if (x & (1 << SREG_I)) { CSStats_Enter( __FILE_ID__, __LINE__ ); }
+#define CS_STATS_EXIT() \
+if (x & (1 << SREG_I)) { CSStats_Exit(); }
+#else
+#define CS_STATS_ENTER()
+#define CS_STATS_EXIT()
+#endif
+
 //------------------------------------------------------------------------
 //! These macros *must* be used in pairs !
 //------------------------------------------------------------------------
@@ -147,10 +160,12 @@ ASM("pop r0");
 { \
 volatile K_UCHAR x; \
 x = _SFR_IO8(SR_); \
-ASM("cli");
+ASM("cli"); \
+CS_STATS_ENTER();
 //------------------------------------------------------------------------
 //! Exit critical section (restore status register)
 #define CS_EXIT() \
+CS_STATS_EXIT(); \
 _SFR_IO8(SR_) = x;\
 }
 
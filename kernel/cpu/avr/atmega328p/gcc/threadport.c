@@ -29,6 +29,9 @@ See license.txt for more information
 #include "quantum.h"
 #include "kernel.h"
 #include "kernelaware.h"
+#include "threadstats.h"
+#include "eventtrace.h"
+#include "sampleprofiler.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
 
@@ -93,6 +96,12 @@ static void Thread_Switch(void)
     // If there's no next-thread-to-run...
     if (g_pstNext == Kernel_GetIdleThread())
     {
+#if KERNEL_USE_THREAD_STATS
+        ThreadStats_Switch();
+#endif
+#if KERNEL_USE_EVENT_TRACE
+        EventTrace_Switch();
+#endif
         g_pstCurrent = Kernel_GetIdleThread();
 
         // Disable the SWI, and re-enable interrupts -- enter nested interrupt
@@ -123,6 +132,12 @@ static void Thread_Switch(void)
         _SFR_IO8(SR_) = ucSR;
         KernelSWI_RI( true );        
     }
+#endif
+#if KERNEL_USE_THREAD_STATS
+    ThreadStats_Switch();
+#endif
+#if KERNEL_USE_EVENT_TRACE
+    EventTrace_Switch();
 #endif
     g_pstCurrent = (Thread_t*)g_pstNext;
 }
@@ -162,18 +177,75 @@ ISR(INT0_vect)
     ASM("reti");                // Return to the next task
 }
 
+#if KERNEL_USE_SAMPLE_PROFILER
+//---------------------------------------------------------------------------
+//! Program counter interrupted by the kernel timer, for the sampling profiler
+static volatile K_USHORT usSamplePC;
+
+//---------------------------------------------------------------------------
+/*!
+    Kernel timer entry point, with the sampling profiler.  The interrupted
+    program counter sits just above whatever the ISR pushes, so it's picked
+    up here, before the compiler-generated prologue of the ISR proper, which
+    is then jumped to.  On entry, the stack holds the return address:
+
+    [ PCL ]  SP+2
+    [ PCH ]  SP+1
+
+    The ISR proper isn't in the vector table, but still needs the "signal"
+    prologue and epilogue.  avr-gcc warns about any signal handler whose
+    name doesn't start with "__vector", so it's named to match.
+
+    \fn ISR(TIMER1_COMPA_vect) __attribute__ ( ( signal, naked ) );
+*/
+//---------------------------------------------------------------------------
+void __vector_kernel_timer( void ) __attribute__ ( ( signal, used ) );
+ISR(TIMER1_COMPA_vect) __attribute__ ( ( signal, naked ) );
+ISR(TIMER1_COMPA_vect)
+{
+    // Three registers pushed moves the return address to SP+4 and SP+5.
+    // None of these instructions touch SREG.
+    ASM("push r0");
+    ASM("push r30");
+    ASM("push r31");
+    ASM("in r30, 0x3D");
+    ASM("in r31, 0x3E");
+    ASM("ldd r0, Z+5");
+    ASM("sts usSamplePC, r0");
+    ASM("ldd r0, Z+4");
+    ASM("sts usSamplePC + 1, r0");
+    ASM("pop r31");
+    ASM("pop r30");
+    ASM("pop r0");
+    ASM("jmp __vector_kernel_timer");
+}
+#endif
+
 //---------------------------------------------------------------------------
 /*!
     Timer_t interrupt ISR - causes a tick, which may cause a context switch
     \fn ISR(TIMER1_COMPA_vect) ;
 */
 //---------------------------------------------------------------------------
+#if KERNEL_USE_SAMPLE_PROFILER
+void __vector_kernel_timer( void )
+#else
 ISR(TIMER1_COMPA_vect)
+#endif
 {
+#if KERNEL_USE_SAMPLE_PROFILER
+    SampleProfiler_Sample( usSamplePC );
+#endif
+#if KERNEL_USE_EVENT_TRACE
+    EventTrace_IsrEnter( EVENT_TRACE_ISR_KERNEL_TIMER );
+#endif
 #if KERNEL_USE_TIMERS    
     TimerScheduler_Process();
 #endif    
 #if KERNEL_USE_QUANTUM    
     Quantum_UpdateTimer();
 #endif
+#if KERNEL_USE_EVENT_TRACE
+    EventTrace_IsrExit( EVENT_TRACE_ISR_KERNEL_TIMER );
+#endif
 }
@@ -19,68 +19,273 @@ See license.txt for more information
 */
 
 #include "kerneltypes.h"
+#include "mark3cfg.h"
 #include "kerneltimer.h"
 #include "threadport.h"
 
+#if KERNEL_TIMERS_TICKLESS
+//---------------------------------------------------------------------------
+/*
+    Tickless operation uses SysTick as a one-shot timer, clocked from HCLK.
+    SysTick is a down-counter whose current period can't be adjusted once
+    it has been loaded - so to move the expiry, the counter is restarted
+    with a new period, and the time that elapsed in the interrupted period
+    is carried in ulEpochClocks.  The "epoch" is thus the time since the
+    last expiry, as it is on the AVR's CTC timer.
+
+    Once a period has been loaded, the reload register is parked at its
+    maximum value, so that a late interrupt never sees the counter run out
+    more than once.
+*/
+#define SYSTICK_MAX_RELOAD      ((K_ULONG)0x00FFFFFF)
+#define CLOCKS_PER_TICK         ((K_ULONG)(SYSTEM_FREQ / TIMER_FREQ))
+#define SYSTICK_MAX_TICKS       ((K_ULONG)(SYSTICK_MAX_RELOAD / CLOCKS_PER_TICK))
+
+//! SysTick clocks elapsed in the current epoch before the counter was last restarted
+static K_ULONG ulEpochClocks;
+
+//! Length of the counter's current period, in SysTick clocks (0 = no expiry set)
+static K_ULONG ulPeriodClocks;
+
+//! Current expiry, in ticks from the start of the epoch
+static K_ULONG ulExpiry;
+
+//! Shortest period the counter can be loaded with - a reload value of 0
+//! stops SysTick altogether.
+#define SYSTICK_MIN_PERIOD      ((K_ULONG)2)
+
+//---------------------------------------------------------------------------
+static K_ULONG KernelTimer_ElapsedClocks(void)
+{
+    K_ULONG ulVal = SysTick->VAL;
+
+    // The counter ran out but the expiry hasn't been serviced yet, so it has
+    // already reloaded from its parked maximum - count the whole period, plus
+    // the time since.  VAL is re-read, in case it ran out after the first
+    // read.
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        ulVal = SysTick->VAL;
+        if (ulVal)
+        {
+            ulVal = (SYSTICK_MAX_RELOAD + 1) - ulVal;
+        }
+        return ulEpochClocks + ulPeriodClocks + ulVal;
+    }
+
+    // Each period starts when the counter reads zero - either on underflow,
+    // or when the counter is restarted.
+    if (!ulVal)
+    {
+        return ulEpochClocks;
+    }
+    return ulEpochClocks + (ulPeriodClocks - ulVal);
+}
+
+//---------------------------------------------------------------------------
+static void KernelTimer_ParkReload(void)
+{
+    // Wait for the counter to pick up the new period, then make sure that
+    // the following period is as long as possible.
+    while (!SysTick->VAL) { /* Do nothing */ }
+    SysTick->LOAD = SYSTICK_MAX_RELOAD;
+}
+
+//---------------------------------------------------------------------------
+static void KernelTimer_Reload(K_ULONG ulClocks_)
+{
+    if (ulClocks_ < SYSTICK_MIN_PERIOD)
+    {
+        ulClocks_ = SYSTICK_MIN_PERIOD;
+    }
+
+    ulEpochClocks = KernelTimer_ElapsedClocks();
+    ulPeriodClocks = ulClocks_;
+    SysTick->LOAD = ulClocks_ - 1;
+    SysTick->VAL = 0;
+    if (SysTick->CTRL & SysTick_CTRL_ENABLE_Msk)
+    {
+        KernelTimer_ParkReload();
+    }
+}
+#endif
+
 //---------------------------------------------------------------------------
 void KernelTimer_Config(void)
 {
-	   
+#if KERNEL_TIMERS_TICKLESS
+    NVIC_SetPriority(SysTick_IRQn, (1 << __NVIC_PRIO_BITS) - 1);
+#endif
 }
 
 //---------------------------------------------------------------------------
 void KernelTimer_Start(void)
-{	
+{
+#if !KERNEL_TIMERS_TICKLESS
 	SysTick_Config(SYSTEM_FREQ / 1000); // 1KHz fixed clock...
 	NVIC_EnableIRQ(SysTick_IRQn);
+#else
+    // Nothing to do until an expiry has been set.
+    if (!ulPeriodClocks)
+    {
+        return;
+    }
+
+    // Restart the epoch using whatever expiry has been set
+    ulEpochClocks = 0;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk |
+                    SysTick_CTRL_TICKINT_Msk |
+                    SysTick_CTRL_ENABLE_Msk;
+    KernelTimer_ParkReload();
+#endif
 }
 
 //---------------------------------------------------------------------------
 void KernelTimer_Stop(void)
 {
 	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+#if KERNEL_TIMERS_TICKLESS
+    SysTick->CTRL &= ~SysTick_CTRL_TICKINT_Msk;
+    SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+    SysTick->LOAD = 0;
+    SysTick->VAL = 0;
+    ulEpochClocks = 0;
+    ulPeriodClocks = 0;
+    ulExpiry = 0;
+#endif
 }
 
 //---------------------------------------------------------------------------
 K_USHORT KernelTimer_Read(void)
 {
+#if KERNEL_TIMERS_TICKLESS
+    K_ULONG ulTicks;
+
+    CS_ENTER();
+    ulTicks = KernelTimer_ElapsedClocks() / CLOCKS_PER_TICK;
+    CS_EXIT();
+
+    if (ulTicks > 65535)
+    {
+        ulTicks = 65535;
+    }
+    return (K_USHORT)ulTicks;
+#else
 	// Not implemented in this port
 	return 0;
+#endif
+}
+
+//---------------------------------------------------------------------------
+K_ULONG KernelTimer_ReadUs(void)
+{
+    K_ULONG ulClocks;
+
+#if KERNEL_TIMERS_TICKLESS
+    // Includes an expiry that hasn't been serviced yet
+    ulClocks = KernelTimer_ElapsedClocks();
+#else
+    ulClocks = SysTick->LOAD - SysTick->VAL;
+
+    // Same again for a tick that hasn't been serviced yet.
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        ulClocks = (SysTick->LOAD + 1) + (SysTick->LOAD - SysTick->VAL);
+    }
+#endif
+    return ulClocks / (SYSTEM_FREQ / 1000000);
 }
 
 //---------------------------------------------------------------------------
 K_ULONG KernelTimer_SubtractExpiry(K_ULONG ulInterval_)
 {
+#if KERNEL_TIMERS_TICKLESS
+    return KernelTimer_SetExpiry(ulExpiry - ulInterval_);
+#else
 	return 0;
+#endif
 }
 
 //---------------------------------------------------------------------------
 K_ULONG KernelTimer_TimeToExpiry(void)
 {
+#if KERNEL_TIMERS_TICKLESS
+    K_USHORT usRead = KernelTimer_Read();
+
+    if (usRead >= ulExpiry)
+    {
+        return 0;
+    }
+    return ulExpiry - usRead;
+#else
 	return 0;
+#endif
 }
 
 //---------------------------------------------------------------------------
 K_ULONG KernelTimer_GetOvertime(void)
 {
-    return 0;
+    return KernelTimer_Read();
 }
 
 //---------------------------------------------------------------------------
 K_ULONG KernelTimer_SetExpiry(K_ULONG ulInterval_)
-{	
+{
+#if KERNEL_TIMERS_TICKLESS
+    K_ULONG ulElapsed;
+
+    if (ulInterval_ > SYSTICK_MAX_TICKS)
+    {
+        ulInterval_ = SYSTICK_MAX_TICKS;
+    }
+
+    CS_ENTER();
+    ulElapsed = KernelTimer_ElapsedClocks();
+
+    // If we're already past the requested expiry, expire on the next tick.
+    if ((ulInterval_ * CLOCKS_PER_TICK) <= ulElapsed)
+    {
+        ulInterval_ = (ulElapsed / CLOCKS_PER_TICK) + 1;
+    }
+
+    // Restart the counter so that it runs out exactly ulInterval_ ticks
+    // from the start of the epoch.
+    KernelTimer_Reload( (ulInterval_ * CLOCKS_PER_TICK) - ulElapsed );
+    ulExpiry = ulInterval_;
+    CS_EXIT();
+
+    return ulInterval_;
+#else
 	return 0;
+#endif
 }
 
 //---------------------------------------------------------------------------
 void KernelTimer_ClearExpiry(void)
 {
+#if KERNEL_TIMERS_TICKLESS
+    // Called on expiry - a new epoch began when the counter ran out, and
+    // the counter is already running on the longest possible period.
+    CS_ENTER();
+    ulEpochClocks = 0;
+    ulPeriodClocks = SYSTICK_MAX_RELOAD + 1;
+    ulExpiry = SYSTICK_MAX_TICKS;
+    CS_EXIT();
+#endif
 }
 
 //-------------------------------------------------------------------------
 K_UCHAR KernelTimer_DI(void)
 {
+#if KERNEL_TIMERS_TICKLESS
+    K_BOOL bEnabled = ((SysTick->CTRL & SysTick_CTRL_TICKINT_Msk) != 0);
+    SysTick->CTRL &= ~SysTick_CTRL_TICKINT_Msk;    // Disable interrupt
+    SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;            // Clear pending interrupt
+    return bEnabled;
+#else
 	return 0;
+#endif
 }
 
 //---------------------------------------------------------------------------
@@ -92,6 +297,16 @@ void KernelTimer_EI(void)
 //---------------------------------------------------------------------------
 void KernelTimer_RI(K_BOOL bEnable_)
 {
+#if KERNEL_TIMERS_TICKLESS
+    if (bEnable_)
+    {
+        SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;     // Enable interrupt
+    }
+    else
+    {
+        SysTick->CTRL &= ~SysTick_CTRL_TICKINT_Msk;
+    }
+#endif
 }
 
 //---------------------------------------------------------------------------
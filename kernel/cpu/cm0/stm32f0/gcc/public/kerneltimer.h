@@ -19,13 +19,18 @@ See license.txt for more information
 */
 
 #include "kerneltypes.h"
+#include "mark3cfg.h"
 
 #ifndef __KERNELTIMER_H_
 #define __KERNELTIMER_H_
 
 //---------------------------------------------------------------------------
 #define SYSTEM_FREQ		48000000
+#if KERNEL_TIMERS_TICKLESS
+#define TIMER_FREQ		100000      // 10us ticks, SysTick reprogrammed per-expiry
+#else
 #define TIMER_FREQ		1000	
+#endif
 
 //---------------------------------------------------------------------------
 /*!
@@ -130,4 +135,16 @@ void KernelTimer_ClearExpiry(void);
 */
 K_USHORT KernelTimer_Read(void);
 
+/*!
+    \fn K_ULONG KernelTimer_ReadUs(void)
+
+    Return the time elapsed since the last kernel timer interrupt was
+    serviced, in microseconds.  If the timer has expired but its interrupt
+    is still pending, the expired period is included.  Must be called with
+    interrupts disabled.
+
+    \return Microseconds elapsed since the last serviced timer interrupt
+*/
+K_ULONG KernelTimer_ReadUs(void);
+
 #endif //__KERNELTIMER_H_
@@ -23,6 +23,7 @@ See license.txt for more information
 
 #include "kerneltypes.h"
 #include "thread.h"
+#include "csstats.h"
 
 #include <stm32f0xx.h>
 
@@ -55,17 +56,31 @@ extern volatile K_ULONG g_ulCriticalCount;
 #define ENABLE_INTS()		{ xDMB(); xenable_irq(); }
 #define DISABLE_INTS()		{ xdisable_irq(); xDMB(); }
 
+//------------------------------------------------------------------------
+//! Time the outermost critical section of a nest
+#if KERNEL_USE_CS_STATS
+#define CS_STATS_ENTER() \
+    if( 1 == g_ulCriticalCount ) { CSStats_Enter( __FILE_ID__, __LINE__ ); }
+#define CS_STATS_EXIT() \
+    if( 1 == g_ulCriticalCount ) { CSStats_Exit(); }
+#else
+#define CS_STATS_ENTER()
+#define CS_STATS_EXIT()
+#endif
+
 //------------------------------------------------------------------------
 //! Enter critical section (copy current PRIMASK register value, disable interrupts)
 #define CS_ENTER()	\
 { \
     DISABLE_INTS(); \
     g_ulCriticalCount++;\
+    CS_STATS_ENTER(); \
 }
 //------------------------------------------------------------------------
 //! Exit critical section (restore previous PRIMASK status register value)
 #define CS_EXIT() \
 { \
+    CS_STATS_EXIT(); \
     g_ulCriticalCount--; \
     if( 0 == g_ulCriticalCount ) { \
         ENABLE_INTS(); \
@@ -27,12 +27,20 @@ See license.txt for more information
 #include "kerneltimer.h"
 #include "timerlist.h"
 #include "quantum.h"
+#include "threadstats.h"
+#include "eventtrace.h"
+#include "sampleprofiler.h"
 
 //---------------------------------------------------------------------------
 static void ThreadPort_StartFirstThread( void ) __attribute__ (( naked ));
 void SVC_Handler( void ) __attribute__ (( naked ));
 void PendSV_Handler( void ) __attribute__ (( naked ));
+#if KERNEL_USE_SAMPLE_PROFILER
+void SysTick_Handler( void ) __attribute__ (( naked ));
+void ThreadPort_KernelTimerIsr( K_ULONG ulPC_ );
+#else
 void SysTick_Handler( void );
+#endif
 
 //---------------------------------------------------------------------------
 volatile K_ULONG g_ulCriticalCount;
@@ -126,9 +134,30 @@ void ThreadPort_InitStack(Thread_t *pclThread_)
 	pclThread_->pwStackTop = pulStack;
 }
 
+#if KERNEL_USE_THREAD_STATS || KERNEL_USE_EVENT_TRACE
+//---------------------------------------------------------------------------
+/*!
+    Kernel instrumentation run on every context switch, immediately before
+    the current Thread_t is replaced by the next.  Called from PendSV_Handler
+    as well as Thread_Switch().
+*/
+void ThreadPort_SwitchHook(void)
+{
+#if KERNEL_USE_THREAD_STATS
+    ThreadStats_Switch();
+#endif
+#if KERNEL_USE_EVENT_TRACE
+    EventTrace_Switch();
+#endif
+}
+#endif
+
 //---------------------------------------------------------------------------
 void Thread_Switch(void)
 {
+#if KERNEL_USE_THREAD_STATS || KERNEL_USE_EVENT_TRACE
+    ThreadPort_SwitchHook();
+#endif
     g_pstCurrent = (Thread_t*)g_pstNext;
 }
 
@@ -293,6 +322,17 @@ void SVC_Handler(void)
 	);
 }
 
+//---------------------------------------------------------------------------
+//! Call out to the kernel instrumentation from the context switch, if enabled
+#if KERNEL_USE_THREAD_STATS || KERNEL_USE_EVENT_TRACE
+#define SWITCH_HOOK_ASM             " push {r0, lr} \n " \
+                                    " bl ThreadPort_SwitchHook \n " \
+                                    " pop {r0, r1} \n " \
+                                    " mov lr, r1 \n "
+#else
+#define SWITCH_HOOK_ASM             ""
+#endif
+
 //---------------------------------------------------------------------------
 /*
 	Context Switching:
@@ -300,8 +340,8 @@ void SVC_Handler(void)
 	On ARM Cortex parts, there's dedicated hardware that's used primarily to 
 	support RTOS (or RTOS-like) funcationlity.  This functionality includes
 	the SysTick timer, and the PendSV Exception.  SysTick is used for the 
-	kernel timer (I need to learn how to use it to see whether or not I can
-	do tickless timers), while the PendSV exception is used for triggering
+	kernel timer (either as a fixed 1kHz tick, or as a one-shot timer when
+	using tickless timers), while the PendSV exception is used for triggering
 	context switches.  In reality, it's a "special SVC" call that's designed
 	to be lower-overhead, in that it isn't mux'd with a bunch of other system
 	or application functionality.
@@ -352,6 +392,11 @@ void SVC_Handler(void)
 
 	This is the easy part - we just call a function to swap in the Thread_t "current" Thread_t
 	from the "next" Thread_t.
+
+	With KERNEL_USE_THREAD_STATS or KERNEL_USE_EVENT_TRACE, ThreadPort_SwitchHook()
+	is called first to charge the outgoing Thread_t's run time and record the
+	switch.  Only lr needs preserving across the call, since it holds the
+	EXC_RETURN value; r0-r3 are reloaded afterwards.
 	
 3)	Restore Context
 
@@ -386,6 +431,9 @@ void PendSV_Handler(void)
 	" mov r4, r8 \n "
 	" stmia r2!, {r4-r7} \n "
 		
+	// Run-time accounting and event trace, if enabled
+	SWITCH_HOOK_ASM
+
 	// Equivalent of Thread_Swap()
 	" ldr r1, CURR_ \n"
 	" ldr r0, NEXT_ \n"
@@ -423,9 +471,52 @@ void PendSV_Handler(void)
 	);
 }
 
+#if KERNEL_USE_SAMPLE_PROFILER
+//---------------------------------------------------------------------------
+/*
+    Kernel timer entry point, with the sampling profiler.
+
+    The interrupted program counter is in the exception stack frame - on the
+    PSP if a thread was interrupted, or on the MSP if it was another
+    exception handler, as told by bit 2 of the EXC_RETURN value in lr.  It's
+    passed in r0 to the rest of the ISR, which is branched to with lr
+    untouched, so that it returns from the exception as normal.
+*/
+void SysTick_Handler(void)
+{
+	ASM(
+	" mov r0, lr \n "
+	" mov r1, #4 \n "
+	" tst r0, r1 \n "
+	" beq SysTick_MSP_ \n "
+	" mrs r0, psp \n "
+	" b SysTick_PC_ \n "
+	"SysTick_MSP_: \n "
+	" mrs r0, msp \n "
+	"SysTick_PC_: \n "
+	// Stacked PC is the 7th word of the frame
+	" ldr r0, [r0, #24] \n "
+	" ldr r1, TIMER_ISR_ \n "
+	" bx r1 \n "
+
+	" .align 2 \n "
+	" TIMER_ISR_: .word ThreadPort_KernelTimerIsr \n "
+	);
+}
+
+//---------------------------------------------------------------------------
+void ThreadPort_KernelTimerIsr( K_ULONG ulPC_ )
+#else
 //---------------------------------------------------------------------------
 void SysTick_Handler(void)
+#endif
 {
+#if KERNEL_USE_SAMPLE_PROFILER
+    SampleProfiler_Sample( (K_ADDR)ulPC_ );
+#endif
+#if KERNEL_USE_EVENT_TRACE
+    EventTrace_IsrEnter( EVENT_TRACE_ISR_KERNEL_TIMER );
+#endif
 #if KERNEL_USE_TIMERS
     TimerScheduler_Process();
 #endif
@@ -433,6 +524,12 @@ void SysTick_Handler(void)
     Quantum_UpdateTimer();
 #endif
 
-	// Clear the systick interrupt pending bit.
+#if !KERNEL_TIMERS_TICKLESS
+	// Clear the systick interrupt pending bit.  In tickless mode, a new
+	// (short) expiry may already be pending by the time we get here.
 	SCB->ICSR |= SCB_ICSR_PENDSTCLR_Msk;
+#endif
+#if KERNEL_USE_EVENT_TRACE
+    EventTrace_IsrExit( EVENT_TRACE_ISR_KERNEL_TIMER );
+#endif
 }
@@ -0,0 +1,125 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   csstats.c
+
+    \brief  Critical section (interrupts-off time) instrumentation
+*/
+
+#include "mark3cfg.h"
+#include "kerneltypes.h"
+#include "threadport.h"
+#include "kerneltimer.h"
+#include "kerneldebug.h"
+#include "csstats.h"
+
+//---------------------------------------------------------------------------
+#if defined __FILE_ID__
+	#undef __FILE_ID__
+#endif
+#define __FILE_ID__ 	CSSTATS_C       //!< File ID used in kernel trace calls
+
+#if KERNEL_USE_CS_STATS
+
+//---------------------------------------------------------------------------
+static CSStats_t stStats;           //!< Statistics gathered so far
+
+static K_ULONG ulStartUs;           //!< Timer reading when the interval started
+static K_USHORT usStartFile;        //!< Where the interval started
+static K_USHORT usStartLine;
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief CSStats_Bucket_i
+ *
+ * \param ulUs_ Interval, in microseconds
+ * \return Histogram bucket for the interval - floor(log2), clamped
+ */
+static K_UCHAR CSStats_Bucket_i( K_ULONG ulUs_ )
+{
+    K_UCHAR ucBucket = 0;
+
+    while ((ulUs_ >>= 1) && (ucBucket < (CS_STATS_HISTOGRAM_BUCKETS - 1)))
+    {
+        ucBucket++;
+    }
+    return ucBucket;
+}
+
+//---------------------------------------------------------------------------
+// Both of these run with interrupts disabled, from the CS_ENTER()/CS_EXIT()
+// macros, so they mustn't use critical sections themselves.
+void CSStats_Enter( K_USHORT usFile_, K_USHORT usLine_ )
+{
+    usStartFile = usFile_;
+    usStartLine = usLine_;
+    ulStartUs = KernelTimer_ReadUs();
+}
+
+//---------------------------------------------------------------------------
+void CSStats_Exit( void )
+{
+    K_ULONG ulUs = KernelTimer_ReadUs();
+    K_USHORT *pusBucket;
+
+    // The timer can't be serviced while interrupts are off, so the reading
+    // only goes backwards if the timer was restarted in the meantime.
+    if (ulUs < ulStartUs)
+    {
+        return;
+    }
+    ulUs -= ulStartUs;
+
+    stStats.ulCount++;
+    if (ulUs > stStats.ulMaxUs)
+    {
+        stStats.ulMaxUs = ulUs;
+        stStats.usMaxFile = usStartFile;
+        stStats.usMaxLine = usStartLine;
+    }
+
+    pusBucket = &stStats.ausHistogram[ CSStats_Bucket_i( ulUs ) ];
+    if (*pusBucket != 0xFFFF)
+    {
+        (*pusBucket)++;
+    }
+}
+
+//---------------------------------------------------------------------------
+void CSStats_Get( CSStats_t *pstStats_ )
+{
+    CS_ENTER();
+    *pstStats_ = stStats;
+    CS_EXIT();
+}
+
+//---------------------------------------------------------------------------
+void CSStats_Reset( void )
+{
+    K_UCHAR i;
+
+    CS_ENTER();
+    stStats.ulMaxUs = 0;
+    stStats.usMaxFile = 0;
+    stStats.usMaxLine = 0;
+    stStats.ulCount = 0;
+    for (i = 0; i < CS_STATS_HISTOGRAM_BUCKETS; i++)
+    {
+        stStats.ausHistogram[i] = 0;
+    }
+    CS_EXIT();
+}
+
+#endif // KERNEL_USE_CS_STATS
@@ -0,0 +1,158 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   dpc.c
+
+    \brief  Deferred procedure calls
+*/
+
+#include "mark3cfg.h"
+#include "kerneltypes.h"
+#include "thread.h"
+#include "threadport.h"
+#include "kerneldebug.h"
+#include "dpc.h"
+
+//---------------------------------------------------------------------------
+#if defined __FILE_ID__
+	#undef __FILE_ID__
+#endif
+#define __FILE_ID__ 	DPC_C       //!< File ID used in kernel trace calls
+
+#if KERNEL_USE_DPC
+
+//---------------------------------------------------------------------------
+static Thread_t stDpcThread;
+static K_WORD awDpcStack[DPC_STACK_SIZE / sizeof(K_WORD)];
+
+static Dpc_t *pstHead;      //!< Next DPC to run
+static Dpc_t *pstTail;      //!< Most recently queued DPC
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief DpcQueue_Pop_i
+ *
+ * Remove the DPC at the head of the queue.  Interrupts are only disabled
+ * for the unlink, never while a DPC runs.
+ *
+ * \return The next DPC to run, or NULL if the queue is empty
+ */
+static Dpc_t *DpcQueue_Pop_i( void )
+{
+    Dpc_t *pstDpc;
+
+    CS_ENTER();
+    pstDpc = pstHead;
+    if (pstDpc)
+    {
+        pstHead = pstDpc->pstNext;
+        if (!pstHead)
+        {
+            pstTail = NULL;
+        }
+        pstDpc->bQueued = false;
+    }
+    CS_EXIT();
+
+    return pstDpc;
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief DpcQueue_Thread
+ *
+ * Entry point of the DPC thread.  Sleeps on its notification value until a
+ * DPC is queued, then drains the queue.
+ */
+static void DpcQueue_Thread( void *unused_ )
+{
+    Dpc_t *pstDpc;
+
+    while (1)
+    {
+        Thread_NotifyWait( 0, NULL );
+
+        // The callback may queue itself again; it'll be picked up on a
+        // later pass through this loop.
+        pstDpc = DpcQueue_Pop_i();
+        while (pstDpc)
+        {
+            pstDpc->pfCallback( pstDpc->pvData );
+            pstDpc = DpcQueue_Pop_i();
+        }
+    }
+}
+
+//---------------------------------------------------------------------------
+void DpcQueue_Init( void )
+{
+    pstHead = NULL;
+    pstTail = NULL;
+
+    Thread_Init( &stDpcThread, awDpcStack, sizeof(awDpcStack), DPC_THREAD_PRIORITY,
+                 DpcQueue_Thread, NULL );
+    Thread_Start( &stDpcThread );
+}
+
+//---------------------------------------------------------------------------
+void Dpc_Init( Dpc_t *pstDpc_, DpcCallback_t pfCallback_, void *pvData_ )
+{
+    KERNEL_ASSERT( pfCallback_ );
+
+    pstDpc_->pstNext = NULL;
+    pstDpc_->pfCallback = pfCallback_;
+    pstDpc_->pvData = pvData_;
+    pstDpc_->bQueued = false;
+}
+
+//---------------------------------------------------------------------------
+K_BOOL Dpc_Queue( Dpc_t *pstDpc_ )
+{
+    K_BOOL bQueued = false;
+
+    CS_ENTER();
+    if (!pstDpc_->bQueued)
+    {
+        pstDpc_->pstNext = NULL;
+        if (pstTail)
+        {
+            pstTail->pstNext = pstDpc_;
+        }
+        else
+        {
+            pstHead = pstDpc_;
+        }
+        pstTail = pstDpc_;
+        pstDpc_->bQueued = true;
+        bQueued = true;
+    }
+    CS_EXIT();
+
+    if (bQueued)
+    {
+        Thread_Notify( &stDpcThread, 0, NOTIFY_ACTION_NONE );
+    }
+    return bQueued;
+}
+
+#if KERNEL_USE_TIMERS
+//---------------------------------------------------------------------------
+void Dpc_TimerCallback( Thread_t *pstOwner_, void *pvData_ )
+{
+    Dpc_Queue( (Dpc_t*)pvData_ );
+}
+#endif
+
+#endif // KERNEL_USE_DPC
@@ -21,6 +21,7 @@ See license.txt for more information
 #include "kernel.h"
 #include "thread.h"
 #include "eventflag.h"
+#include "multiwait.h"
 #include "kernelaware.h"
 
 #if KERNEL_USE_EVENTFLAG
@@ -28,7 +29,6 @@ See license.txt for more information
 #if KERNEL_USE_TIMEOUTS
 #include "timerlist.h"
 
-#if KERNEL_USE_TIMEOUTS
 /*!
     * \brief WakeMe
     *
@@ -43,26 +43,26 @@ static void EventFlag_WakeMe( EventFlag_t *pstFlag_, Thread_t *pstOwner_);
     *
     * Interal abstraction used to manage both timed and untimed wait operations
     *
-    * \param usMask_ - 16-bit bitmask to block on
+    * \param tMask_ - Bitmask to block on
     * \param eMode_ - EVENT_FLAG_ANY:  Thread_t will block on any of the bits in the mask
     *               - EVENT_FLAG_ALL:  Thread_t will block on all of the bits in the mask
     * \param ulTimeMS_ - Time to block (in ms)
     *
     * \return Bitmask condition that caused the thread to unblock, or 0 on error or timeout
     */
-static K_USHORT EventFlag_Wait_i( EventFlag_t *pstFlag_, K_USHORT usMask_, EventFlagOperation_t eMode_, K_ULONG ulTimeMS_);
+static K_FLAG_MASK EventFlag_Wait_i( EventFlag_t *pstFlag_, K_FLAG_MASK tMask_, EventFlagOperation_t eMode_, K_ULONG ulTimeMS_);
 #else
 /*!
     * \brief Wait_i
     * Interal abstraction used to manage wait operations
     *
-    * \param usMask_ - 16-bit bitmask to block on
+    * \param tMask_ - Bitmask to block on
     * \param eMode_ - EVENT_FLAG_ANY:  Thread_t will block on any of the bits in the mask
     *               - EVENT_FLAG_ALL:  Thread_t will block on all of the bits in the mask
     *
     * \return Bitmask condition that caused the thread to unblock.
     */
-static K_USHORT EventFlag_Wait_i( EventFlag_t *pstFlag_, K_USHORT usMask_, EventFlagOperation_t eMode_);
+static K_FLAG_MASK EventFlag_Wait_i( EventFlag_t *pstFlag_, K_FLAG_MASK tMask_, EventFlagOperation_t eMode_);
 #endif
 
 /*!
@@ -70,10 +70,25 @@ static K_USHORT EventFlag_Wait_i( EventFlag_t *pstFlag_, K_USHORT usMask_, Event
  */
 void EventFlag_Init( EventFlag_t *pstFlag_ ) 
 { 
-    pstFlag_->usSetMask = 0;
+    pstFlag_->tSetMask = 0;
 	ThreadList_Init( (ThreadList_t*)pstFlag_ );
+#if KERNEL_USE_MULTIWAIT
+    pstFlag_->pstMultiWait = NULL;
+#endif
+
+#if KERNEL_USE_EVENTFLAG_INDEX
+    {
+        K_UCHAR i;
+        pstFlag_->tAnyMask = 0;
+        for (i = 0; i < KERNEL_EVENTFLAG_BITS; i++)
+        {
+            ThreadList_Init( &(pstFlag_->astIndex[i]) );
+        }
+    }
+#endif
 }
 
+#if KERNEL_USE_TIMEOUTS
 //---------------------------------------------------------------------------
 /*!
  * \brief TimedEventFlag_Callback
@@ -104,19 +119,84 @@ void TimedEventFlag_Callback(Thread_t *pstOwner_, void *pvData_)
 //---------------------------------------------------------------------------
 void EventFlag_WakeMe( EventFlag_t *pstFlag_, Thread_t *pstChosenOne_)
 {
+    // The thread is removed from whichever of the object's lists it's on
     BlockingObject_UnBlock( pstChosenOne_ );
 }
 #endif
 
+#if KERNEL_USE_EVENTFLAG_INDEX
+//---------------------------------------------------------------------------
+/*!
+ * \brief EventFlag_LowestBit_i
+ *
+ * \param tMask_ Non-zero bitmask
+ * \return Index of the least-significant set bit in the mask
+ */
+static K_UCHAR EventFlag_LowestBit_i( K_FLAG_MASK tMask_ )
+{
+    K_UCHAR ucBit = 0;
+    while (!(tMask_ & 1))
+    {
+        tMask_ >>= 1;
+        ucBit++;
+    }
+    return ucBit;
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief EventFlag_GetWaitList_i
+ *
+ * Select the list a thread should block on, given its wait condition and
+ * the flags currently set in the object.  Must be called from within a
+ * critical section.
+ *
+ * "All" waiters are keyed on a bit from their mask that isn't yet set, as
+ * nothing can satisfy them until that bit is set.  "Any" waiters are keyed
+ * on their bit if they wait on exactly one; otherwise they're placed on the
+ * object's main list, and their bits are added to the set that cause the
+ * main list to be walked.
+ *
+ * \param tMask_ Thread's event-flag mask
+ * \param eMode_ Thread's event-flag mode
+ * \return Pointer to the thread-list to block the thread on
+ */
+static ThreadList_t *EventFlag_GetWaitList_i( EventFlag_t *pstFlag_, K_FLAG_MASK tMask_, EventFlagOperation_t eMode_ )
+{
+    K_FLAG_MASK tKey;
+
+    if ((eMode_ == EVENT_FLAG_ALL) || (eMode_ == EVENT_FLAG_ALL_CLEAR))
+    {
+        tKey = tMask_ & ~(pstFlag_->tSetMask);
+    }
+    else if (tMask_ && !(tMask_ & (tMask_ - 1)))
+    {
+        tKey = tMask_;
+    }
+    else
+    {
+        tKey = 0;
+    }
+
+    if (!tKey)
+    {
+        pstFlag_->tAnyMask |= tMask_;
+        return (ThreadList_t*)pstFlag_;
+    }
+    return &(pstFlag_->astIndex[ EventFlag_LowestBit_i( tKey ) ]);
+}
+#endif
+
 //---------------------------------------------------------------------------
 #if KERNEL_USE_TIMEOUTS
-    K_USHORT EventFlag_Wait_i( EventFlag_t *pstFlag_, K_USHORT usMask_, EventFlagOperation_t eMode_, K_ULONG ulTimeMS_)
+    K_FLAG_MASK EventFlag_Wait_i( EventFlag_t *pstFlag_, K_FLAG_MASK tMask_, EventFlagOperation_t eMode_, K_ULONG ulTimeMS_)
 #else
-    K_USHORT EventFlag_Wait_i( EventFlag_t *pstFlag_, K_USHORT usMask_, EventFlagOperation_t eMode_)
+    K_FLAG_MASK EventFlag_Wait_i( EventFlag_t *pstFlag_, K_FLAG_MASK tMask_, EventFlagOperation_t eMode_)
 #endif
 {
     K_BOOL bThreadYield = false;
     K_BOOL bMatch = false;
+    ThreadList_t *pstList;
 
 #if KERNEL_USE_TIMEOUTS
     Timer_t stEventTimer;
@@ -129,26 +209,26 @@ void EventFlag_WakeMe( EventFlag_t *pstFlag_, Thread_t *pstChosenOne_)
 
     // Check to see whether or not the current mask matches any of the
     // desired bits.
-	Thread_SetEventFlagMask( g_pstCurrent, usMask_ );
+	Thread_SetEventFlagMask( g_pstCurrent, tMask_ );
 
     if ((eMode_ == EVENT_FLAG_ALL) || (eMode_ == EVENT_FLAG_ALL_CLEAR))
     {
         // Check to see if the flags in their current state match all of
         // the set flags in the event flag group, with this mask.
-        if ((pstFlag_->usSetMask & usMask_) == usMask_)
+        if ((pstFlag_->tSetMask & tMask_) == tMask_)
         {
             bMatch = true;
-			Thread_SetEventFlagMask( g_pstCurrent, usMask_ );
+			Thread_SetEventFlagMask( g_pstCurrent, tMask_ );
         }
     }
     else if ((eMode_ == EVENT_FLAG_ANY) || (eMode_ == EVENT_FLAG_ANY_CLEAR))
     {
         // Check to see if the existing flags match any of the set flags in
         // the event flag group  with this mask
-        if (pstFlag_->usSetMask & usMask_)
+        if (pstFlag_->tSetMask & tMask_)
         {
             bMatch = true;
-            Thread_SetEventFlagMask( g_pstCurrent, pstFlag_->usSetMask & usMask_);
+            Thread_SetEventFlagMask( g_pstCurrent, pstFlag_->tSetMask & tMask_);
         }
     }
 
@@ -156,7 +236,7 @@ void EventFlag_WakeMe( EventFlag_t *pstFlag_, Thread_t *pstChosenOne_)
     if (!bMatch)
     {
         // Reset the current thread's event flag mask & mode
-		Thread_SetEventFlagMask( g_pstCurrent, usMask_ );
+		Thread_SetEventFlagMask( g_pstCurrent, tMask_ );
 		Thread_SetEventFlagMode( g_pstCurrent, eMode_ );
 
 #if KERNEL_USE_TIMEOUTS
@@ -171,7 +251,12 @@ void EventFlag_WakeMe( EventFlag_t *pstFlag_, Thread_t *pstChosenOne_)
 #endif
 
         // Add the thread to the object's block-list.
-        BlockingObject_Block( (ThreadList_t*)pstFlag_, g_pstCurrent);
+#if KERNEL_USE_EVENTFLAG_INDEX
+        pstList = EventFlag_GetWaitList_i( pstFlag_, tMask_, eMode_ );
+#else
+        pstList = (ThreadList_t*)pstFlag_;
+#endif
+        BlockingObject_Block( pstList, g_pstCurrent);
 
         // Trigger that
         bThreadYield = true;
@@ -204,126 +289,219 @@ void EventFlag_WakeMe( EventFlag_t *pstFlag_, Thread_t *pstChosenOne_)
 }
 
 //---------------------------------------------------------------------------
-K_USHORT EventFlag_Wait( EventFlag_t *pstFlag_, K_USHORT usMask_, EventFlagOperation_t eMode_)
+K_FLAG_MASK EventFlag_Wait( EventFlag_t *pstFlag_, K_FLAG_MASK tMask_, EventFlagOperation_t eMode_)
 {
 #if KERNEL_USE_TIMEOUTS
-    return EventFlag_Wait_i( pstFlag_, usMask_, eMode_, 0);
+    return EventFlag_Wait_i( pstFlag_, tMask_, eMode_, 0);
 #else
-    return EventFlag_Wait_i( pstFlag_, usMask_, eMode_);
+    return EventFlag_Wait_i( pstFlag_, tMask_, eMode_);
 #endif
 }
 
 #if KERNEL_USE_TIMEOUTS
 //---------------------------------------------------------------------------
-K_USHORT EventFlag_TimedWait( EventFlag_t *pstFlag_, K_USHORT usMask_, EventFlagOperation_t eMode_, K_ULONG ulTimeMS_)
+K_FLAG_MASK EventFlag_TimedWait( EventFlag_t *pstFlag_, K_FLAG_MASK tMask_, EventFlagOperation_t eMode_, K_ULONG ulTimeMS_)
 {
-    return EventFlag_Wait_i( pstFlag_, usMask_, eMode_, ulTimeMS_);
+    return EventFlag_Wait_i( pstFlag_, tMask_, eMode_, ulTimeMS_);
 }
 #endif
 
 //---------------------------------------------------------------------------
-void EventFlag_Set( EventFlag_t *pstFlag_, K_USHORT usMask_)
+/*!
+ * \brief EventFlag_Match_i
+ *
+ * Check whether the object's current flags satisfy a blocked thread's wait
+ * condition.  If they do, the thread's event-flag mask is updated with the
+ * bits that woke it, and any bits to be cleared by the "clear" variants are
+ * added to *ptClear_.
+ *
+ * \param pstThread_ Blocked thread to check
+ * \param tMask_     Bits being set by the current EventFlag_Set() call
+ * \param ptClear_   Bits to clear once all waiters have been processed
+ * \return true if the thread should be unblocked
+ */
+static K_BOOL EventFlag_Match_i( EventFlag_t *pstFlag_, Thread_t *pstThread_, K_FLAG_MASK tMask_, K_FLAG_MASK *ptClear_ )
 {
-    Thread_t *pstPrev;
-    Thread_t *pstCurrent;
-    K_BOOL bReschedule = false;
-    K_USHORT usNewMask;
+    // Read the thread's event mask/mode
+    K_FLAG_MASK tThreadMask = Thread_GetEventFlagMask( pstThread_ );
+    EventFlagOperation_t eThreadMode = Thread_GetEventFlagMode( pstThread_ );
 
-    CS_ENTER();
+    // For the "any" mode - unblock the blocked threads if one or more bits
+    // in the thread's bitmask match the object's bitmask
+    if ((EVENT_FLAG_ANY == eThreadMode) || (EVENT_FLAG_ANY_CLEAR == eThreadMode))
+    {
+        if (tThreadMask & pstFlag_->tSetMask)
+        {
+            Thread_SetEventFlagMode( pstThread_, EVENT_FLAG_PENDING_UNBLOCK );
+            Thread_SetEventFlagMask( pstThread_, pstFlag_->tSetMask & tThreadMask );
 
-    // Walk through the whole block list, checking to see whether or not
-    // the current flag set now matches any/all of the masks and modes of
-    // the threads involved.
+            // If the "clear" variant is set, then clear the bits in the mask
+            // that caused the thread to unblock.
+            if (EVENT_FLAG_ANY_CLEAR == eThreadMode)
+            {
+                *ptClear_ |= (tThreadMask & tMask_);
+            }
+            return true;
+        }
+    }
+    // For the "all" mode, every set bit in the thread's requested bitmask must
+    // match the object's flag mask.
+    else if ((EVENT_FLAG_ALL == eThreadMode) || (EVENT_FLAG_ALL_CLEAR == eThreadMode))
+    {
+        if ((tThreadMask & pstFlag_->tSetMask) == tThreadMask)
+        {
+            Thread_SetEventFlagMode( pstThread_, EVENT_FLAG_PENDING_UNBLOCK );
+            Thread_SetEventFlagMask( pstThread_, tThreadMask);
+
+            // If the "clear" variant is set, then clear the bits in the mask
+            // that caused the thread to unblock.
+            if (EVENT_FLAG_ALL_CLEAR == eThreadMode)
+            {
+                *ptClear_ |= (tThreadMask & tMask_);
+            }
+            return true;
+        }
+    }
+    return false;
+}
 
-    pstFlag_->usSetMask |= usMask_;
-    usNewMask = pstFlag_->usSetMask;
+//---------------------------------------------------------------------------
+/*!
+ * \brief EventFlag_ProcessList_i
+ *
+ * Walk one of the object's block-lists, unblocking every thread whose wait
+ * condition is now satisfied.  With KERNEL_USE_EVENTFLAG_INDEX, threads
+ * left on a per-bit list are moved to the list for another of their
+ * outstanding bits, and the main list's wait mask is recomputed.
+ *
+ * \param pstList_  Block-list to process
+ * \param tMask_    Bits being set by the current EventFlag_Set() call
+ * \param ptClear_  Bits to clear once all waiters have been processed
+ * \return true if any threads were unblocked
+ */
+static K_BOOL EventFlag_ProcessList_i( EventFlag_t *pstFlag_, ThreadList_t *pstList_, K_FLAG_MASK tMask_, K_FLAG_MASK *ptClear_ )
+{
+    Thread_t *pstThread;
+    Thread_t *pstNext;
+    K_BOOL bIsTail;
+    K_BOOL bReschedule = false;
 
-    // Start at the head of the list, and iterate through until we hit the
-    // "head" element in the list again.  Ensure that we handle the case where
-    // we remove the first or last elements in the list, or if there's only
-    // one element in the list.
-    pstCurrent = (Thread_t*)(LinkList_GetHead( (LinkList_t*)pstFlag_ ));
+    // Do nothing when there are no threads blocking.
+    pstNext = (Thread_t*)(LinkList_GetHead( (LinkList_t*)pstList_ ));
+    if (!pstNext)
+    {
+        return false;
+    }
+
+#if KERNEL_USE_EVENTFLAG_INDEX
+    if (pstList_ == (ThreadList_t*)pstFlag_)
+    {
+        pstFlag_->tAnyMask = 0;
+    }
+#endif
 
-    // Do nothing when there are no objects blocking.
-    if (pstCurrent)
+    // Check each thread in turn, noting whether it's the tail before it is
+    // (potentially) removed from the list.
+    do
     {
-        // First loop - process every thread in the block-list and check to
-        // see whether or not the current flags match the event-flag conditions
-        // on the thread.
-        do
+        pstThread = pstNext;
+        pstNext = (Thread_t*)(LinkListNode_GetNext( (LinkListNode_t*)pstThread ));
+        bIsTail = (pstThread == (Thread_t*)(LinkList_GetTail( (LinkList_t*)pstList_ )));
+
+        if (EventFlag_Match_i( pstFlag_, pstThread, tMask_, ptClear_ ))
+        {
+            BlockingObject_UnBlock( pstThread );
+            bReschedule = true;
+        }
+#if KERNEL_USE_EVENTFLAG_INDEX
+        else if (pstList_ == (ThreadList_t*)pstFlag_)
+        {
+            pstFlag_->tAnyMask |= Thread_GetEventFlagMask( pstThread );
+        }
+        else
         {
-            pstPrev = pstCurrent;
-            pstCurrent = (Thread_t*)(LinkListNode_GetNext( (LinkListNode_t*)pstCurrent ) );
+            // An "all" waiter with bits still outstanding - none of which
+            // are being set now, so it can't be visited twice in this pass.
+            ThreadList_t *pstNewList = EventFlag_GetWaitList_i( pstFlag_,
+                                            Thread_GetEventFlagMask( pstThread ),
+                                            Thread_GetEventFlagMode( pstThread ) );
+            ThreadList_Remove( pstList_, pstThread );
+    #if KERNEL_USE_PRIORITY_WAITLISTS
+            ThreadList_AddPriority( pstNewList, pstThread );
+    #else
+            ThreadList_Add( pstNewList, pstThread );
+    #endif
+            Thread_SetCurrent( pstThread, pstNewList );
+        }
+#endif
+    }
+    while (!bIsTail);
 
-            // Read the thread's event mask/mode
-            K_USHORT usThreadMask = Thread_GetEventFlagMask( pstPrev );
-            EventFlagOperation_t eThreadMode = Thread_GetEventFlagMode( pstPrev );
+    return bReschedule;
+}
 
-            // For the "any" mode - unblock the blocked threads if one or more bits
-            // in the thread's bitmask match the object's bitmask
-            if ((EVENT_FLAG_ANY == eThreadMode) || (EVENT_FLAG_ANY_CLEAR == eThreadMode))
-            {
-                if (usThreadMask & pstFlag_->usSetMask)
-                {
-                    Thread_SetEventFlagMode( pstPrev, EVENT_FLAG_PENDING_UNBLOCK );
-                    Thread_SetEventFlagMask( pstPrev, pstFlag_->usSetMask & usThreadMask );
-                    bReschedule = true;
-
-                    // If the "clear" variant is set, then clear the bits in the mask
-                    // that caused the thread to unblock.
-                    if (EVENT_FLAG_ANY_CLEAR == eThreadMode)
-                    {
-                        usNewMask &=~ (usThreadMask & usMask_);
-                    }
-                }
-            }
-            // For the "all" mode, every set bit in the thread's requested bitmask must
-            // match the object's flag mask.
-            else if ((EVENT_FLAG_ALL == eThreadMode) || (EVENT_FLAG_ALL_CLEAR == eThreadMode))
+//---------------------------------------------------------------------------
+void EventFlag_Set( EventFlag_t *pstFlag_, K_FLAG_MASK tMask_)
+{
+    K_BOOL bReschedule = false;
+    K_FLAG_MASK tClear = 0;
+#if KERNEL_USE_EVENTFLAG_INDEX
+    K_FLAG_MASK tBits;
+    K_UCHAR ucBit;
+#endif
+
+    CS_ENTER();
+
+    pstFlag_->tSetMask |= tMask_;
+
+#if KERNEL_USE_EVENTFLAG_INDEX
+    // Only threads keyed on one of the bits being set can have been
+    // satisfied by this call - leave the rest of the waiters alone.
+    tBits = tMask_;
+    ucBit = 0;
+    while (tBits)
+    {
+        if (tBits & 1)
+        {
+            if (EventFlag_ProcessList_i( pstFlag_, &(pstFlag_->astIndex[ucBit]), tMask_, &tClear ))
             {
-                if ((usThreadMask & pstFlag_->usSetMask) == usThreadMask)
-                {
-                    Thread_SetEventFlagMode( pstPrev, EVENT_FLAG_PENDING_UNBLOCK );
-                    Thread_SetEventFlagMask( pstPrev, usThreadMask);
-                    bReschedule = true;
-
-                    // If the "clear" variant is set, then clear the bits in the mask
-                    // that caused the thread to unblock.
-                    if (EVENT_FLAG_ALL_CLEAR == eThreadMode)
-                    {
-                        usNewMask &=~ (usThreadMask & usMask_);
-                    }
-                }
+                bReschedule = true;
             }
         }
-        // To keep looping, ensure that there's something in the list, and
-        // that the next item isn't the head of the list.
-        while (pstPrev != (Thread_t*)LinkList_GetTail( (LinkList_t*)pstFlag_ ) );
-
-        // Second loop - go through and unblock all of the threads that
-        // were tagged for unblocking.
-        pstCurrent = (Thread_t*)(LinkList_GetHead( (LinkList_t*)pstFlag_ ));
-        K_BOOL bIsTail = false;
-        do
+        tBits >>= 1;
+        ucBit++;
+    }
+
+    // Threads waiting on any of several bits live on the main list
+    if (pstFlag_->tAnyMask & tMask_)
+    {
+        if (EventFlag_ProcessList_i( pstFlag_, (ThreadList_t*)pstFlag_, tMask_, &tClear ))
         {
-            pstPrev = pstCurrent;
-            pstCurrent = (Thread_t*)(LinkListNode_GetNext( (LinkListNode_t*)pstCurrent ));
+            bReschedule = true;
+        }
+    }
+#else
+    // Walk through the whole block list, checking to see whether or not
+    // the current flag set now matches any/all of the masks and modes of
+    // the threads involved.
+    bReschedule = EventFlag_ProcessList_i( pstFlag_, (ThreadList_t*)pstFlag_, tMask_, &tClear );
+#endif
 
-            // Check to see if this is the condition to terminate the loop
-            if (pstPrev == (Thread_t*)(LinkList_GetTail( (LinkList_t*)pstFlag_ )))
-            {
-                bIsTail = true;
-            }
+    // Update the bitmask based on any "clear" operations performed along
+    // the way
+    pstFlag_->tSetMask &= ~tClear;
 
-            // If the first pass indicated that this thread should be
-            // unblocked, then unblock the thread
-            if (Thread_GetEventFlagMode( pstPrev ) == EVENT_FLAG_PENDING_UNBLOCK)
-            {
-                BlockingObject_UnBlock( pstPrev );
-            }
+#if KERNEL_USE_MULTIWAIT
+    // Wake any threads waiting on this among other objects, once the
+    // final state of the flags is known.
+    if (pstFlag_->pstMultiWait)
+    {
+        if (MultiWait_Signal_i( pstFlag_->pstMultiWait ))
+        {
+            bReschedule = true;
         }
-        while (!bIsTail);
     }
+#endif
 
     // If we awoke any threads, re-run the scheduler
     if (bReschedule)
@@ -331,34 +509,30 @@ void EventFlag_Set( EventFlag_t *pstFlag_, K_USHORT usMask_)
         Thread_Yield();
     }
 
-    // Update the bitmask based on any "clear" operations performed along
-    // the way
-    pstFlag_->usSetMask = usNewMask;
-
     // Restore interrupts - will potentially cause a context switch if a
     // thread is unblocked.
     CS_EXIT();
 }
 
 //---------------------------------------------------------------------------
-void EventFlag_Clear( EventFlag_t *pstFlag_, K_USHORT usMask_)
+void EventFlag_Clear( EventFlag_t *pstFlag_, K_FLAG_MASK tMask_)
 {
     // Just clear the bitfields in the local object.
     CS_ENTER();
-    pstFlag_->usSetMask &= ~usMask_;
+    pstFlag_->tSetMask &= ~tMask_;
     CS_EXIT();
 }
 
 //---------------------------------------------------------------------------
-K_USHORT EventFlag_GetMask( EventFlag_t *pstFlag_ )
+K_FLAG_MASK EventFlag_GetMask( EventFlag_t *pstFlag_ )
 {
     // Return the presently held event flag values in this object.  Ensure
     // we get this within a critical section to guarantee atomicity.
-    K_USHORT usReturn;
+    K_FLAG_MASK tReturn;
     CS_ENTER();
-    usReturn = pstFlag_->usSetMask;
+    tReturn = pstFlag_->tSetMask;
     CS_EXIT();
-    return usReturn;
+    return tReturn;
 }
 
 #endif // KERNEL_USE_EVENTFLAG
@@ -0,0 +1,161 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   eventtrace.c
+
+    \brief  Timestamped scheduling event trace
+*/
+
+#include "mark3cfg.h"
+#include "kerneltypes.h"
+#include "kernel.h"
+#include "thread.h"
+#include "threadport.h"
+#include "writebuf16.h"
+#include "kerneldebug.h"
+#include "eventtrace.h"
+
+//---------------------------------------------------------------------------
+#if defined __FILE_ID__
+	#undef __FILE_ID__
+#endif
+#define __FILE_ID__ 	EVENTTRACE_C       //!< File ID used in kernel trace calls
+
+#if KERNEL_USE_EVENT_TRACE
+
+//---------------------------------------------------------------------------
+static WriteBuffer16_t stBuffer;                        //!< Ring buffer holding the records
+static K_USHORT ausBuffer[ EVENT_TRACE_BUFFER_SIZE ];   //!< Storage for the ring buffer
+static volatile K_BOOL bTraceEnabled;                   //!< Whether events are being recorded
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief EventTrace_Write_i
+ *
+ * Timestamp and record an event.  The timestamp is taken in the same
+ * critical section that reserves the record, so that records are always
+ * in time order.
+ *
+ * \param ucEvent_ Event type
+ * \param ucId_    Thread, ISR or user ID
+ * \param usArg_   Event-specific argument
+ */
+static void EventTrace_Write_i( K_UCHAR ucEvent_, K_UCHAR ucId_, K_USHORT usArg_ )
+{
+    K_USHORT ausRecord[ EVENT_TRACE_RECORD_SIZE ];
+    K_ULONG ulTime;
+
+    if (!bTraceEnabled)
+    {
+        return;
+    }
+
+    ausRecord[0] = ((K_USHORT)ucEvent_ << 8) | (K_USHORT)ucId_;
+    ausRecord[3] = usArg_;
+
+    CS_ENTER();
+    ulTime = (K_ULONG)Kernel_GetTime();
+    ausRecord[1] = (K_USHORT)(ulTime & 0xFFFF);
+    ausRecord[2] = (K_USHORT)(ulTime >> 16);
+    WriteBuffer16_WriteData( &stBuffer, ausRecord, EVENT_TRACE_RECORD_SIZE );
+    CS_EXIT();
+}
+
+//---------------------------------------------------------------------------
+void EventTrace_Init( void )
+{
+    WriteBuffer16_SetBuffers( &stBuffer, ausBuffer, EVENT_TRACE_BUFFER_SIZE );
+    WriteBuffer16_SetCallback( &stBuffer, 0 );
+    bTraceEnabled = false;
+}
+
+//---------------------------------------------------------------------------
+void EventTrace_SetCallback( WriteBufferCallback pfCallback_ )
+{
+    WriteBuffer16_SetCallback( &stBuffer, pfCallback_ );
+}
+
+//---------------------------------------------------------------------------
+void EventTrace_Enable( K_BOOL bEnable_ )
+{
+    bTraceEnabled = bEnable_;
+}
+
+//---------------------------------------------------------------------------
+void EventTrace_Flush( void )
+{
+    // Records are written with interrupts disabled, so none can be part-way
+    // through being written here.
+    CS_ENTER();
+    WriteBuffer16_Flush( &stBuffer );
+    CS_EXIT();
+}
+
+//---------------------------------------------------------------------------
+void EventTrace_Switch( void )
+{
+    K_UCHAR ucPrev = EVENT_TRACE_NO_THREAD;
+
+    if (g_pstCurrent)
+    {
+        ucPrev = Thread_GetID( g_pstCurrent );
+    }
+    EventTrace_Write_i( EVENT_TRACE_SWITCH, Thread_GetID( g_pstNext ),
+                        ((K_USHORT)Thread_GetCurPriority( g_pstNext ) << 8) | ucPrev );
+}
+
+//---------------------------------------------------------------------------
+void EventTrace_Block( Thread_t *pstThread_, void *pvObject_ )
+{
+    EventTrace_Write_i( EVENT_TRACE_BLOCK, Thread_GetID( pstThread_ ), (K_USHORT)(K_ADDR)pvObject_ );
+}
+
+//---------------------------------------------------------------------------
+void EventTrace_UnBlock( Thread_t *pstThread_, void *pvObject_ )
+{
+    EventTrace_Write_i( EVENT_TRACE_UNBLOCK, Thread_GetID( pstThread_ ), (K_USHORT)(K_ADDR)pvObject_ );
+}
+
+//---------------------------------------------------------------------------
+void EventTrace_IsrEnter( K_UCHAR ucIsr_ )
+{
+    EventTrace_Write_i( EVENT_TRACE_ISR_ENTER, ucIsr_, 0 );
+}
+
+//---------------------------------------------------------------------------
+void EventTrace_IsrExit( K_UCHAR ucIsr_ )
+{
+    EventTrace_Write_i( EVENT_TRACE_ISR_EXIT, ucIsr_, 0 );
+}
+
+//---------------------------------------------------------------------------
+void EventTrace_Timer( Timer_t *pstTimer_ )
+{
+    K_UCHAR ucOwner = EVENT_TRACE_NO_THREAD;
+
+    if (pstTimer_->pstOwner)
+    {
+        ucOwner = Thread_GetID( pstTimer_->pstOwner );
+    }
+    EventTrace_Write_i( EVENT_TRACE_TIMER, ucOwner, (K_USHORT)(K_ADDR)pstTimer_ );
+}
+
+//---------------------------------------------------------------------------
+void EventTrace_User( K_UCHAR ucCode_, K_USHORT usArg_ )
+{
+    EventTrace_Write_i( EVENT_TRACE_USER, ucCode_, usArg_ );
+}
+
+#endif // KERNEL_USE_EVENT_TRACE
@@ -26,6 +26,7 @@ See license.txt for more information
 #include "thread.h"
 #include "threadport.h"
 #include "timerlist.h"
+#include "timerscheduler.h"
 #include "message.h"
 #include "driver.h"
 #include "profile.h"
@@ -34,6 +35,10 @@ See license.txt for more information
 #include "kerneldebug.h"
 #include "kernelaware.h"
 #include "debugtokens.h"
+#include "dpc.h"
+#include "threadstats.h"
+#include "eventtrace.h"
+#include "sampleprofiler.h"
 
 K_BOOL bIsStarted;
 K_BOOL bIsPanic;
@@ -62,6 +67,9 @@ void Kernel_Init(void)
     g_bIsKernelAware = g_bIsKernelAware;
 #endif
 
+#if KERNEL_USE_DEBUG
+    TraceBuffer_SetMaskAll( KERNEL_TRACE_DEFAULT_LEVELS );
+#endif
 #if KERNEL_USE_DEBUG & !KERNEL_AWARE_SIMULATION
 	TraceBuffer_Init();
 #endif
@@ -71,7 +79,7 @@ void Kernel_Init(void)
 	pfIdle = 0;
 #endif
 	
-	KERNEL_TRACE( STR_MARK3_INIT );
+	KERNEL_TRACE( TRACE_LEVEL_INFO, STR_MARK3_INIT );
 
     // Initialize the global kernel data - scheduler, timer-scheduler, and
     // the global message pool.	
@@ -88,15 +96,27 @@ void Kernel_Init(void)
 #if KERNEL_USE_PROFILER
 	Profiler_Init();
 #endif
+#if KERNEL_USE_THREAD_STATS
+    ThreadStats_Init();
+#endif
+#if KERNEL_USE_EVENT_TRACE
+    EventTrace_Init();
+#endif
+#if KERNEL_USE_SAMPLE_PROFILER
+    SampleProfiler_Init();
+#endif
+#if KERNEL_USE_DPC
+    DpcQueue_Init();
+#endif
 }
     
 //---------------------------------------------------------------------------
 void Kernel_Start(void)
 {
-	KERNEL_TRACE( STR_THREAD_START );    
+	KERNEL_TRACE( TRACE_LEVEL_INFO, STR_THREAD_START );    
     bIsStarted = true;
     ThreadPort_StartThreads();
-	KERNEL_TRACE( STR_START_ERROR );
+	KERNEL_TRACE( TRACE_LEVEL_ERROR, STR_START_ERROR );
 }
 
 //---------------------------------------------------------------------------
@@ -133,6 +153,14 @@ K_BOOL Kernel_IsPanic( void )
 {   
 	return bIsPanic;   
 }
+
+#if KERNEL_USE_TIMERS
+//---------------------------------------------------------------------------
+K_ULONGLONG Kernel_GetTime( void )
+{
+    return TimerScheduler_GetTime();
+}
+#endif
 	
 #if KERNEL_USE_IDLE_FUNC
 //---------------------------------------------------------------------------
@@ -140,6 +168,12 @@ void Kernel_SetIdleFunc( idle_func_t pfIdle_ )
 {   
 	pfIdle = pfIdle_; 
 }
+
+//---------------------------------------------------------------------------
+idle_func_t Kernel_GetIdleFunc( void )
+{
+    return pfIdle;
+}
 	
 //---------------------------------------------------------------------------
 void Kernel_IdleFunc( void ) 
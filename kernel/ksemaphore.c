@@ -25,6 +25,7 @@ See license.txt for more information
 #include "ksemaphore.h"
 #include "blocking.h"   
 #include "kerneldebug.h"
+#include "multiwait.h"
 //---------------------------------------------------------------------------
 #if defined __FILE_ID__
 	#undef __FILE_ID__
@@ -137,6 +138,9 @@ void Semaphore_Init( Semaphore_t *pstSe, K_USHORT usInitVal_, K_USHORT usMaxVal_
     // the initial count.  Clear the wait list for this object.
     pstSe->usValue = usInitVal_;
     pstSe->usMaxValue = usMaxVal_;    
+#if KERNEL_USE_MULTIWAIT
+    pstSe->pstMultiWait = NULL;
+#endif
 
 	ThreadList_Init( (ThreadList_t*)pstSe );
 }
@@ -144,7 +148,7 @@ void Semaphore_Init( Semaphore_t *pstSe, K_USHORT usInitVal_, K_USHORT usMaxVal_
 //---------------------------------------------------------------------------
 K_BOOL Semaphore_Post( Semaphore_t *pstSe )
 {
-	KERNEL_TRACE_1( STR_SEMAPHORE_POST_1, (K_USHORT)Thread_GetID( g_pstCurrent ));
+	KERNEL_TRACE_1( TRACE_LEVEL_VERBOSE, STR_SEMAPHORE_POST_1, (K_USHORT)Thread_GetID( g_pstCurrent ));
 	
     K_BOOL bThreadWake = 0;
     K_BOOL bBail = false;
@@ -162,6 +166,14 @@ K_BOOL Semaphore_Post( Semaphore_t *pstSe )
         {
             // Increment the count value
             pstSe->usValue++;
+
+#if KERNEL_USE_MULTIWAIT
+            // Wake any threads waiting on this among other objects
+            if (pstSe->pstMultiWait)
+            {
+                bThreadWake = MultiWait_Signal_i( pstSe->pstMultiWait );
+            }
+#endif
         }
         else
         {
@@ -194,6 +206,71 @@ K_BOOL Semaphore_Post( Semaphore_t *pstSe )
     return true;
 }
 
+//---------------------------------------------------------------------------
+K_USHORT Semaphore_PostN( Semaphore_t *pstSe, K_USHORT usCount_ )
+{
+    K_USHORT usPosted = 0;
+    K_BOOL bThreadWake = false;
+
+    CS_ENTER();
+
+    // Wake one waiting thread per count, highest priority first.
+    while ((usPosted < usCount_) && (LinkList_GetHead( (LinkList_t*)pstSe ) != NULL))
+    {
+        if (Semaphore_WakeNext( pstSe ))
+        {
+            bThreadWake = true;
+        }
+        usPosted++;
+    }
+
+    // Add whatever is left to the count, up to the maximum value.
+    if (usPosted < usCount_)
+    {
+        K_USHORT usRoom = pstSe->usMaxValue - pstSe->usValue;
+        K_USHORT usLeft = usCount_ - usPosted;
+        if (usLeft > usRoom)
+        {
+            usLeft = usRoom;
+        }
+        pstSe->usValue += usLeft;
+        usPosted += usLeft;
+
+#if KERNEL_USE_MULTIWAIT
+        if (usLeft && pstSe->pstMultiWait)
+        {
+            if (MultiWait_Signal_i( pstSe->pstMultiWait ))
+            {
+                bThreadWake = true;
+            }
+        }
+#endif
+    }
+
+    CS_EXIT();
+
+    // Only switch once, no matter how many threads were woken
+    if (bThreadWake)
+    {
+        Thread_Yield();
+    }
+    return usPosted;
+}
+
+//---------------------------------------------------------------------------
+K_USHORT Semaphore_TryPendN( Semaphore_t *pstSe, K_USHORT usCount_ )
+{
+    CS_ENTER();
+    if (usCount_ > pstSe->usValue)
+    {
+        usCount_ = pstSe->usValue;
+    }
+    pstSe->usValue -= usCount_;
+    CS_EXIT();
+
+    return usCount_;
+}
+
 //---------------------------------------------------------------------------
 #if KERNEL_USE_TIMEOUTS
 K_BOOL Semaphore_Pend_i( Semaphore_t *pstSe, K_ULONG ulWaitTimeMS_ )
@@ -201,7 +278,7 @@ K_BOOL Semaphore_Pend_i( Semaphore_t *pstSe, K_ULONG ulWaitTimeMS_ )
 void Semaphore_Pend_i( void )
 #endif
 {
-    KERNEL_TRACE_1( STR_SEMAPHORE_PEND_1, (K_USHORT)Thread_GetID( g_pstCurrent ) );
+    KERNEL_TRACE_1( TRACE_LEVEL_VERBOSE, STR_SEMAPHORE_PEND_1, (K_USHORT)Thread_GetID( g_pstCurrent ) );
 
 #if KERNEL_USE_TIMEOUTS
     Timer_t stSemTimer;
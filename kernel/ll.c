@@ -92,6 +92,41 @@ void DoubleLinkList_Remove( DoubleLinkList_t *pstList_, LinkListNode_t *node_)
 
 
 
+//---------------------------------------------------------------------------
+void DoubleLinkList_InsertAfter( DoubleLinkList_t *pstList_, LinkListNode_t *node_, LinkListNode_t *pstPrev_ )
+{
+    KERNEL_ASSERT( node_ );
+
+    // Inserting at the head of the list
+    if (!pstPrev_)
+    {
+        node_->prev = NULL;
+        node_->next = pstList_->pstHead;
+        if (pstList_->pstHead)
+        {
+            pstList_->pstHead->prev = node_;
+        }
+        else
+        {
+            pstList_->pstTail = node_;
+        }
+        pstList_->pstHead = node_;
+        return;
+    }
+
+    node_->prev = pstPrev_;
+    node_->next = pstPrev_->next;
+    if (pstPrev_->next)
+    {
+        pstPrev_->next->prev = node_;
+    }
+    else
+    {
+        pstList_->pstTail = node_;
+    }
+    pstPrev_->next = node_;
+}
+
 //---------------------------------------------------------------------------
 void CircularLinkList_Add( CircularLinkList_t *pstList_, LinkListNode_t *node_)
 {
@@ -155,6 +190,36 @@ void CircularLinkList_Remove( CircularLinkList_t *pstList_, LinkListNode_t *node
     LinkListNode_Clear( node_ );
 }
 
+//---------------------------------------------------------------------------
+void CircularLinkList_InsertAfter( CircularLinkList_t *pstList_, LinkListNode_t *node_, LinkListNode_t *pstPrev_ )
+{
+    KERNEL_ASSERT( node_ );
+
+    // Inserting into an empty list is the same as adding to it
+    if (!pstList_->pstHead)
+    {
+        CircularLinkList_Add( pstList_, node_ );
+        return;
+    }
+
+    // Inserting at the head of a circular list links the node in between
+    // the tail and the old head.
+    if (!pstPrev_)
+    {
+        pstPrev_ = pstList_->pstTail;
+        pstList_->pstHead = node_;
+    }
+    else if (pstPrev_ == pstList_->pstTail)
+    {
+        pstList_->pstTail = node_;
+    }
+
+    node_->prev = pstPrev_;
+    node_->next = pstPrev_->next;
+    pstPrev_->next->prev = node_;
+    pstPrev_->next = node_;
+}
+
 //---------------------------------------------------------------------------
 void CircularLinkList_PivotForward( CircularLinkList_t *pstList_ )
 {
@@ -108,6 +108,135 @@ static bool MailBox_Receive_i( MailBox_t *pstMailBox_, const void *pvData_, bool
 static void MailBox_Receive_i( MailBox_t *pstMailBox_, const void *pvData_, bool bTail_ );
 #endif
 
+//---------------------------------------------------------------------------
+#if KERNEL_USE_TIMEOUTS
+/*!
+ * \brief Reserve_i
+ *
+ * Internal method which claims a free slot for a send operation.  On success,
+ * the scheduler is left disabled until the slot is committed.
+ *
+ * \param bTail_        true - claim at tail, false - claim at head
+ * \param ulTimeoutMS_  Time to wait for a free slot (in ms), 0 to not wait.
+ * \param pbSchedState_ Receives the scheduler state to pass to Commit_i(),
+ *                      or NULL to hold it in the mailbox for MailBox_Commit()
+ * \return              Pointer to the claimed slot, or NULL if none is free
+ */
+static void *MailBox_Reserve_i( MailBox_t *pstMailBox_, bool bTail_, K_ULONG ulTimeoutMS_, bool *pbSchedState_ );
+
+/*!
+ * \brief Peek_i
+ *
+ * Internal method which waits for, and claims, the next envelope for a read
+ * operation.  On success, the scheduler is left disabled until the slot is
+ * released.
+ *
+ * \param bTail_        true - read from tail, false - read from head
+ * \param ulWaitTimeMS_ Time to wait before timeout (in ms), 0 for infinite
+ * \param pbSchedState_ Receives the scheduler state to pass to Release_i(),
+ *                      or NULL to hold it in the mailbox for MailBox_Release()
+ * \return              Pointer to the envelope, or NULL on timeout
+ */
+static void *MailBox_Peek_i( MailBox_t *pstMailBox_, bool bTail_, K_ULONG ulWaitTimeMS_, bool *pbSchedState_ );
+#else
+/*!
+ * \brief Reserve_i
+ *
+ * Internal method which claims a free slot for a send operation.  On success,
+ * the scheduler is left disabled until the slot is committed.
+ *
+ * \param bTail_        true - claim at tail, false - claim at head
+ * \param pbSchedState_ Receives the scheduler state to pass to Commit_i(),
+ *                      or NULL to hold it in the mailbox for MailBox_Commit()
+ * \return              Pointer to the claimed slot, or NULL if none is free
+ */
+static void *MailBox_Reserve_i( MailBox_t *pstMailBox_, bool bTail_, bool *pbSchedState_ );
+
+/*!
+ * \brief Peek_i
+ *
+ * Internal method which waits for, and claims, the next envelope for a read
+ * operation.  The scheduler is left disabled until the slot is released.
+ *
+ * \param bTail_        true - read from tail, false - read from head
+ * \param pbSchedState_ Receives the scheduler state to pass to Release_i(),
+ *                      or NULL to hold it in the mailbox for MailBox_Release()
+ * \return              Pointer to the envelope
+ */
+static void *MailBox_Peek_i( MailBox_t *pstMailBox_, bool bTail_, bool *pbSchedState_ );
+#endif
+
+/*!
+ * \brief Commit_i
+ *
+ * Internal method which delivers the envelope in a reserved slot.
+ *
+ * \param bSchedState_  Scheduler state saved when the slot was reserved
+ */
+static void MailBox_Commit_i( MailBox_t *pstMailBox_, bool bSchedState_ );
+
+/*!
+ * \brief Release_i
+ *
+ * Internal method which returns the slot of a peeked envelope to the mailbox.
+ *
+ * \param bSchedState_  Scheduler state saved when the envelope was peeked
+ */
+static void MailBox_Release_i( MailBox_t *pstMailBox_, bool bSchedState_ );
+
+//---------------------------------------------------------------------------
+#if KERNEL_USE_TIMEOUTS
+/*!
+ * \brief SendN_i
+ *
+ * Internal method which implements all SendN() methods.
+ *
+ * \param pvData_       Pointer to an array of envelopes
+ * \param usCount_      Number of envelopes in the array
+ * \param bTail_        true - write to tail, false - write to head
+ * \param ulTimeoutMS_  Time to wait for a free slot (in ms), 0 to not wait.
+ * \return              Number of envelopes written
+ */
+static K_USHORT MailBox_SendN_i( MailBox_t *pstMailBox_, const void *pvData_, K_USHORT usCount_, bool bTail_, K_ULONG ulTimeoutMS_ );
+
+/*!
+ * \brief ReceiveN_i
+ *
+ * Internal method which implements all ReceiveN() methods.
+ *
+ * \param pvData_       Pointer to an array to receive envelopes into
+ * \param usCount_      Maximum number of envelopes to receive
+ * \param bTail_        true - read from tail, false - read from head
+ * \param ulWaitTimeMS_ Time to wait before timeout (in ms), 0 for infinite
+ * \return              Number of envelopes received, 0 on timeout
+ */
+static K_USHORT MailBox_ReceiveN_i( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_, bool bTail_, K_ULONG ulWaitTimeMS_ );
+#else
+/*!
+ * \brief SendN_i
+ *
+ * Internal method which implements all SendN() methods.
+ *
+ * \param pvData_       Pointer to an array of envelopes
+ * \param usCount_      Number of envelopes in the array
+ * \param bTail_        true - write to tail, false - write to head
+ * \return              Number of envelopes written
+ */
+static K_USHORT MailBox_SendN_i( MailBox_t *pstMailBox_, const void *pvData_, K_USHORT usCount_, bool bTail_ );
+
+/*!
+ * \brief ReceiveN_i
+ *
+ * Internal method which implements all ReceiveN() methods.
+ *
+ * \param pvData_       Pointer to an array to receive envelopes into
+ * \param usCount_      Maximum number of envelopes to receive
+ * \param bTail_        true - read from tail, false - read from head
+ * \return              Number of envelopes received
+ */
+static K_USHORT MailBox_ReceiveN_i( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_, bool bTail_ );
+#endif
+
 //---------------------------------------------------------------------------
 /*!
  * \brief CopyData
@@ -184,6 +313,88 @@ static void MailBox_MoveHeadBackward(MailBox_t *pstMailBox_ )
     pstMailBox_->usHead--;
 }
 
+//---------------------------------------------------------------------------
+/*!
+ * \brief IndexForward
+ *
+ * Advance a buffer index by a number of elements, wrapping at the end of the
+ * buffer.
+ *
+ * \param usIndex_ Index to advance
+ * \param usSteps_ Number of elements to advance by (at most usCount)
+ * \return         New index
+ */
+static K_USHORT MailBox_IndexForward( MailBox_t *pstMailBox_, K_USHORT usIndex_, K_USHORT usSteps_ )
+{
+    usIndex_ += usSteps_;
+    if (usIndex_ >= pstMailBox_->usCount)
+    {
+        usIndex_ -= pstMailBox_->usCount;
+    }
+    return usIndex_;
+}
+//---------------------------------------------------------------------------
+/*!
+ * \brief IndexBackward
+ *
+ * Move a buffer index back by a number of elements, wrapping at the start of
+ * the buffer.
+ *
+ * \param usIndex_ Index to move back
+ * \param usSteps_ Number of elements to move by (at most usCount)
+ * \return         New index
+ */
+static K_USHORT MailBox_IndexBackward( MailBox_t *pstMailBox_, K_USHORT usIndex_, K_USHORT usSteps_ )
+{
+    if (usIndex_ < usSteps_)
+    {
+        usIndex_ += pstMailBox_->usCount;
+    }
+    return usIndex_ - usSteps_;
+}
+//---------------------------------------------------------------------------
+/*!
+ * \brief CopyBlock
+ *
+ * Copy a run of envelopes between a caller's array and the mailbox buffer,
+ * starting at the given buffer index.  Envelopes are taken from the buffer
+ * in either increasing or decreasing index order, wrapping as required.
+ *
+ * \param pvData_   Pointer to the caller's array of envelopes
+ * \param usIndex_  Buffer index of the first envelope
+ * \param usCount_  Number of envelopes to copy
+ * \param bForward_ true - increasing buffer index, false - decreasing
+ * \param bWrite_   true - copy into the mailbox, false - copy out of it
+ */
+static void MailBox_CopyBlock( MailBox_t *pstMailBox_, const void *pvData_, K_USHORT usIndex_,
+                               K_USHORT usCount_, bool bForward_, bool bWrite_ )
+{
+    K_ADDR uData = (K_ADDR)pvData_;
+    while (usCount_--)
+    {
+        K_ADDR uSlot = (K_ADDR)pstMailBox_->pvBuffer;
+        uSlot += (K_ADDR)(pstMailBox_->usElementSize * usIndex_);
+        if (bWrite_)
+        {
+            MailBox_CopyData( (const void*)uData, (const void*)uSlot, pstMailBox_->usElementSize );
+        }
+        else
+        {
+            MailBox_CopyData( (const void*)uSlot, (const void*)uData, pstMailBox_->usElementSize );
+        }
+        uData += pstMailBox_->usElementSize;
+
+        if (bForward_)
+        {
+            usIndex_ = MailBox_IndexForward( pstMailBox_, usIndex_, 1 );
+        }
+        else
+        {
+            usIndex_ = MailBox_IndexBackward( pstMailBox_, usIndex_, 1 );
+        }
+    }
+}
+
 //---------------------------------------------------------------------------
 void MailBox_Init( MailBox_t *pstMailBox_, void *pvBuffer_, K_USHORT usBufferSize_, K_USHORT usElementSize_ )
 {
@@ -204,6 +415,9 @@ void MailBox_Init( MailBox_t *pstMailBox_, void *pvBuffer_, K_USHORT usBufferSiz
     // in the mailbox corresponding to a post/pend operation in the semaphore.
     Semaphore_Init( &pstMailBox_->stRecvSem, 0, pstMailBox_->usFree );
 
+    pstMailBox_->bSendReserved = false;
+    pstMailBox_->bRecvReserved = false;
+
 #if KERNEL_USE_TIMEOUTS
     // Binary semaphore is used to track any threads that are blocked on a
     // "send" due to lack of free slots.
@@ -297,14 +511,16 @@ bool MailBox_TimedSendTail( MailBox_t *pstMailBox_, void *pvData_, K_ULONG ulTim
 
 //---------------------------------------------------------------------------
 #if KERNEL_USE_TIMEOUTS
-bool MailBox_Send_i( MailBox_t *pstMailBox_, const void *pvData_, bool bTail_, K_ULONG ulTimeoutMS_)
+void *MailBox_Reserve_i( MailBox_t *pstMailBox_, bool bTail_, K_ULONG ulTimeoutMS_, bool *pbSchedState_ )
 #else
-bool MailBox_Send_i( MailBox_t *pstMailBox_, const void *pvData_, bool bTail_)
+void *MailBox_Reserve_i( MailBox_t *pstMailBox_, bool bTail_, bool *pbSchedState_ )
 #endif
 {
-    const void *pvDst;
+    void *pvDst = NULL;
+
+    // The mailbox holds the saved state of one MailBox_Reserve() at a time
+    KERNEL_ASSERT( pbSchedState_ || !pstMailBox_->bSendReserved );
 
-    bool bRet = false;
     bool bSchedState = Scheduler_SetScheduler( false );
 
 #if KERNEL_USE_TIMEOUTS
@@ -338,7 +554,6 @@ bool MailBox_Send_i( MailBox_t *pstMailBox_, const void *pvData_, bool bTail_)
                 MailBox_MoveHeadForward( pstMailBox_ );
                 pvDst = MailBox_GetHeadPointer( pstMailBox_ );
             }
-            bRet = true;
 #if KERNEL_USE_TIMEOUTS
             bDone = true;
 #endif
@@ -361,37 +576,88 @@ bool MailBox_Send_i( MailBox_t *pstMailBox_, const void *pvData_, bool bTail_)
     }
 #endif
 
-    // Copy data to the claimed slot, and post the counting semaphore
-    if (bRet)
+    // The scheduler stays disabled until the slot is committed, so that no
+    // other thread can touch the slot while it is being filled.
+    if (pvDst && pbSchedState_)
+    {
+        *pbSchedState_ = bSchedState;
+    }
+    else if (pvDst)
     {
-        MailBox_CopyData( pvData_, pvDst, pstMailBox_->usElementSize );
+        pstMailBox_->bSendSchedState = bSchedState;
+        pstMailBox_->bSendReserved = true;
+    }
+    else
+    {
+        Scheduler_SetScheduler( bSchedState );
     }
 
-    Scheduler_SetScheduler( bSchedState );
+    return pvDst;
+}
+
+//---------------------------------------------------------------------------
+void MailBox_Commit_i( MailBox_t *pstMailBox_, bool bSchedState_ )
+{
+    Scheduler_SetScheduler( bSchedState_ );
+
+    // The envelope is now complete - notify a receiver
+    Semaphore_Post( &pstMailBox_->stRecvSem );
+}
+
+//---------------------------------------------------------------------------
+void MailBox_Commit( MailBox_t *pstMailBox_ )
+{
+    KERNEL_ASSERT( pstMailBox_->bSendReserved );
+
+    pstMailBox_->bSendReserved = false;
+    MailBox_Commit_i( pstMailBox_, pstMailBox_->bSendSchedState );
+}
+
+//---------------------------------------------------------------------------
+#if KERNEL_USE_TIMEOUTS
+bool MailBox_Send_i( MailBox_t *pstMailBox_, const void *pvData_, bool bTail_, K_ULONG ulTimeoutMS_)
+#else
+bool MailBox_Send_i( MailBox_t *pstMailBox_, const void *pvData_, bool bTail_)
+#endif
+{
+    bool bSchedState;
+#if KERNEL_USE_TIMEOUTS
+    void *pvDst = MailBox_Reserve_i( pstMailBox_, bTail_, ulTimeoutMS_, &bSchedState );
+#else
+    void *pvDst = MailBox_Reserve_i( pstMailBox_, bTail_, &bSchedState );
+#endif
 
-    if (bRet)
+    if (!pvDst)
     {
-        Semaphore_Post( &pstMailBox_->stRecvSem );
+        return false;
     }
 
-    return bRet;
+    // Copy data to the claimed slot, and post the counting semaphore
+    MailBox_CopyData( pvData_, pvDst, pstMailBox_->usElementSize );
+    MailBox_Commit_i( pstMailBox_, bSchedState );
+
+    return true;
 }
 
 //---------------------------------------------------------------------------
 #if KERNEL_USE_TIMEOUTS
-bool MailBox_Receive_i( MailBox_t *pstMailBox_, const void *pvData_, bool bTail_, K_ULONG ulWaitTimeMS_ )
+void *MailBox_Peek_i( MailBox_t *pstMailBox_, bool bTail_, K_ULONG ulWaitTimeMS_, bool *pbSchedState_ )
 #else
-void MailBox_Receive_i( MailBox_t *pstMailBox_, const void *pvData_, bool bTail_ )
+void *MailBox_Peek_i( MailBox_t *pstMailBox_, bool bTail_, bool *pbSchedState_ )
 #endif
 {
-    const void *pvSrc;
+    void *pvSrc;
+    bool bSchedState;
+
+    // The mailbox holds the saved state of one MailBox_Peek() at a time
+    KERNEL_ASSERT( pbSchedState_ || !pstMailBox_->bRecvReserved );
 
 #if KERNEL_USE_TIMEOUTS
     if (!Semaphore_TimedPend( &pstMailBox_->stRecvSem, ulWaitTimeMS_ ))
     {
         // Failed to get the notification from the counting semaphore in the
         // time allotted.  Bail.
-        return false;
+        return NULL;
     }    
 #else
     Semaphore_Pend( &pstMailBox_->stRecvSem );
@@ -399,14 +665,15 @@ void MailBox_Receive_i( MailBox_t *pstMailBox_, const void *pvData_, bool bTail_
 
     // Disable the scheduler while we do this -- this ensures we don't have
     // multiple concurrent readers off the same queue, which could be problematic
-    // if multiple writes occur during reads, etc.
-    bool bSchedState = Scheduler_SetScheduler( false );
+    // if multiple writes occur during reads, etc.  The scheduler stays
+    // disabled until the slot is released.
+    bSchedState = Scheduler_SetScheduler( false );
 
     // Update the head/tail indexes, and get the associated data pointer for
-    // the read operation.
+    // the read operation.  The slot isn't marked as free until it has been
+    // released, so it can't be overwritten while it's being read.
     CS_ENTER();
 
-    pstMailBox_->usFree++;
     if (bTail_)
     {
         MailBox_MoveTailForward( pstMailBox_ );
@@ -420,18 +687,367 @@ void MailBox_Receive_i( MailBox_t *pstMailBox_, const void *pvData_, bool bTail_
 
     CS_EXIT();
 
-    MailBox_CopyData( pvSrc, pvData_, pstMailBox_->usElementSize );
+    if (pbSchedState_)
+    {
+        *pbSchedState_ = bSchedState;
+    }
+    else
+    {
+        pstMailBox_->bRecvSchedState = bSchedState;
+        pstMailBox_->bRecvReserved = true;
+    }
 
-    Scheduler_SetScheduler( bSchedState );
+    return pvSrc;
+}
+
+//---------------------------------------------------------------------------
+void MailBox_Release_i( MailBox_t *pstMailBox_, bool bSchedState_ )
+{
+    CS_ENTER();
+    pstMailBox_->usFree++;
+    CS_EXIT();
 
+    Scheduler_SetScheduler( bSchedState_ );
+
+#if KERNEL_USE_TIMEOUTS
     // Unblock a thread waiting for a free slot to send to
     Semaphore_Post( &pstMailBox_->stSendSem );
+#endif
+}
+
+//---------------------------------------------------------------------------
+void MailBox_Release( MailBox_t *pstMailBox_ )
+{
+    KERNEL_ASSERT( pstMailBox_->bRecvReserved );
+
+    pstMailBox_->bRecvReserved = false;
+    MailBox_Release_i( pstMailBox_, pstMailBox_->bRecvSchedState );
+}
+
+//---------------------------------------------------------------------------
+#if KERNEL_USE_TIMEOUTS
+bool MailBox_Receive_i( MailBox_t *pstMailBox_, const void *pvData_, bool bTail_, K_ULONG ulWaitTimeMS_ )
+#else
+void MailBox_Receive_i( MailBox_t *pstMailBox_, const void *pvData_, bool bTail_ )
+#endif
+{
+    bool bSchedState;
+#if KERNEL_USE_TIMEOUTS
+    void *pvSrc = MailBox_Peek_i( pstMailBox_, bTail_, ulWaitTimeMS_, &bSchedState );
+    if (!pvSrc)
+    {
+        return false;
+    }
+#else
+    void *pvSrc = MailBox_Peek_i( pstMailBox_, bTail_, &bSchedState );
+#endif
+
+    MailBox_CopyData( pvSrc, pvData_, pstMailBox_->usElementSize );
+    MailBox_Release_i( pstMailBox_, bSchedState );
 
 #if KERNEL_USE_TIMEOUTS
     return true;
 #endif
 }
 
+//---------------------------------------------------------------------------
+void *MailBox_Reserve( MailBox_t *pstMailBox_ )
+{
+#if KERNEL_USE_TIMEOUTS
+    return MailBox_Reserve_i( pstMailBox_, false, 0, NULL );
+#else
+    return MailBox_Reserve_i( pstMailBox_, false, NULL );
+#endif
+}
+
+//---------------------------------------------------------------------------
+void *MailBox_ReserveTail( MailBox_t *pstMailBox_ )
+{
+#if KERNEL_USE_TIMEOUTS
+    return MailBox_Reserve_i( pstMailBox_, true, 0, NULL );
+#else
+    return MailBox_Reserve_i( pstMailBox_, true, NULL );
+#endif
+}
+
+#if KERNEL_USE_TIMEOUTS
+//---------------------------------------------------------------------------
+void *MailBox_TimedReserve( MailBox_t *pstMailBox_, K_ULONG ulTimeoutMS_ )
+{
+    return MailBox_Reserve_i( pstMailBox_, false, ulTimeoutMS_, NULL );
+}
+
+//---------------------------------------------------------------------------
+void *MailBox_TimedReserveTail( MailBox_t *pstMailBox_, K_ULONG ulTimeoutMS_ )
+{
+    return MailBox_Reserve_i( pstMailBox_, true, ulTimeoutMS_, NULL );
+}
+#endif
+
+//---------------------------------------------------------------------------
+void *MailBox_Peek( MailBox_t *pstMailBox_ )
+{
+#if KERNEL_USE_TIMEOUTS
+    return MailBox_Peek_i( pstMailBox_, false, 0, NULL );
+#else
+    return MailBox_Peek_i( pstMailBox_, false, NULL );
+#endif
+}
+
+//---------------------------------------------------------------------------
+void *MailBox_PeekTail( MailBox_t *pstMailBox_ )
+{
+#if KERNEL_USE_TIMEOUTS
+    return MailBox_Peek_i( pstMailBox_, true, 0, NULL );
+#else
+    return MailBox_Peek_i( pstMailBox_, true, NULL );
+#endif
+}
+
+#if KERNEL_USE_TIMEOUTS
+//---------------------------------------------------------------------------
+void *MailBox_TimedPeek( MailBox_t *pstMailBox_, K_ULONG ulTimeoutMS_ )
+{
+    return MailBox_Peek_i( pstMailBox_, false, ulTimeoutMS_, NULL );
+}
+
+//---------------------------------------------------------------------------
+void *MailBox_TimedPeekTail( MailBox_t *pstMailBox_, K_ULONG ulTimeoutMS_ )
+{
+    return MailBox_Peek_i( pstMailBox_, true, ulTimeoutMS_, NULL );
+}
+#endif
+
+//---------------------------------------------------------------------------
+#if KERNEL_USE_TIMEOUTS
+K_USHORT MailBox_SendN_i( MailBox_t *pstMailBox_, const void *pvData_, K_USHORT usCount_, bool bTail_, K_ULONG ulTimeoutMS_ )
+#else
+K_USHORT MailBox_SendN_i( MailBox_t *pstMailBox_, const void *pvData_, K_USHORT usCount_, bool bTail_ )
+#endif
+{
+    K_USHORT usSent = 0;
+    K_USHORT usIndex = 0;
+
+    if (!usCount_)
+    {
+        return 0;
+    }
+
+    bool bSchedState = Scheduler_SetScheduler( false );
+
+#if KERNEL_USE_TIMEOUTS
+    bool bBlock = false;
+    bool bDone = false;
+    while (!bDone)
+    {
+        // Try to claim slots first before resorting to blocking.
+        if (bBlock)
+        {
+            bDone = true;
+            Scheduler_SetScheduler( bSchedState );
+            Semaphore_TimedPend( &pstMailBox_->stSendSem, ulTimeoutMS_ );
+            Scheduler_SetScheduler( false );
+        }
+#endif
+
+        // Claim as many slots as are free, up to the number requested, and
+        // move the head or tail past all of them at once.
+        CS_ENTER();
+        if (pstMailBox_->usFree)
+        {
+            usSent = usCount_;
+            if (usSent > pstMailBox_->usFree)
+            {
+                usSent = pstMailBox_->usFree;
+            }
+            pstMailBox_->usFree -= usSent;
+
+            if (bTail_)
+            {
+                usIndex = pstMailBox_->usTail;
+                pstMailBox_->usTail = MailBox_IndexBackward( pstMailBox_, pstMailBox_->usTail, usSent );
+            }
+            else
+            {
+                usIndex = MailBox_IndexForward( pstMailBox_, pstMailBox_->usHead, 1 );
+                pstMailBox_->usHead = MailBox_IndexForward( pstMailBox_, pstMailBox_->usHead, usSent );
+            }
+#if KERNEL_USE_TIMEOUTS
+            bDone = true;
+#endif
+        }
+
+#if KERNEL_USE_TIMEOUTS
+        else if (ulTimeoutMS_)
+        {
+            bBlock = true;
+        }
+        else
+        {
+            bDone = true;
+        }
+#endif
+
+        CS_EXIT();
+
+#if KERNEL_USE_TIMEOUTS
+    }
+#endif
+
+    // Envelopes are placed in the same slots that the equivalent sequence of
+    // single sends would have used.
+    if (usSent)
+    {
+        MailBox_CopyBlock( pstMailBox_, pvData_, usIndex, usSent, !bTail_, true );
+    }
+
+    Scheduler_SetScheduler( bSchedState );
+
+    // Notify receivers of all of the new envelopes at once
+    if (usSent)
+    {
+        Semaphore_PostN( &pstMailBox_->stRecvSem, usSent );
+    }
+
+    return usSent;
+}
+
+//---------------------------------------------------------------------------
+#if KERNEL_USE_TIMEOUTS
+K_USHORT MailBox_ReceiveN_i( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_, bool bTail_, K_ULONG ulWaitTimeMS_ )
+#else
+K_USHORT MailBox_ReceiveN_i( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_, bool bTail_ )
+#endif
+{
+    K_USHORT usRecv;
+    K_USHORT usIndex;
+
+    if (!usCount_)
+    {
+        return 0;
+    }
+
+    // Wait for the first envelope, then take whatever else is available
+    // without blocking.
+#if KERNEL_USE_TIMEOUTS
+    if (!Semaphore_TimedPend( &pstMailBox_->stRecvSem, ulWaitTimeMS_ ))
+    {
+        return 0;
+    }
+#else
+    Semaphore_Pend( &pstMailBox_->stRecvSem );
+#endif
+    usRecv = 1 + Semaphore_TryPendN( &pstMailBox_->stRecvSem, usCount_ - 1 );
+
+    bool bSchedState = Scheduler_SetScheduler( false );
+
+    CS_ENTER();
+    if (bTail_)
+    {
+        usIndex = MailBox_IndexForward( pstMailBox_, pstMailBox_->usTail, 1 );
+        pstMailBox_->usTail = MailBox_IndexForward( pstMailBox_, pstMailBox_->usTail, usRecv );
+    }
+    else
+    {
+        usIndex = pstMailBox_->usHead;
+        pstMailBox_->usHead = MailBox_IndexBackward( pstMailBox_, pstMailBox_->usHead, usRecv );
+    }
+    CS_EXIT();
+
+    MailBox_CopyBlock( pstMailBox_, pvData_, usIndex, usRecv, bTail_, false );
+
+    CS_ENTER();
+    pstMailBox_->usFree += usRecv;
+    CS_EXIT();
+
+    Scheduler_SetScheduler( bSchedState );
+
+#if KERNEL_USE_TIMEOUTS
+    // Unblock a waiting sender for each slot freed, not just the first
+    Semaphore_PostN( &pstMailBox_->stSendSem, usRecv );
+#endif
+
+    return usRecv;
+}
+
+//---------------------------------------------------------------------------
+K_USHORT MailBox_SendN( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_ )
+{
+    KERNEL_ASSERT( pvData_ );
+
+#if KERNEL_USE_TIMEOUTS
+    return MailBox_SendN_i( pstMailBox_, pvData_, usCount_, false, 0 );
+#else
+    return MailBox_SendN_i( pstMailBox_, pvData_, usCount_, false );
+#endif
+}
+
+//---------------------------------------------------------------------------
+K_USHORT MailBox_SendTailN( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_ )
+{
+    KERNEL_ASSERT( pvData_ );
+
+#if KERNEL_USE_TIMEOUTS
+    return MailBox_SendN_i( pstMailBox_, pvData_, usCount_, true, 0 );
+#else
+    return MailBox_SendN_i( pstMailBox_, pvData_, usCount_, true );
+#endif
+}
+
+//---------------------------------------------------------------------------
+K_USHORT MailBox_ReceiveN( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_ )
+{
+    KERNEL_ASSERT( pvData_ );
+
+#if KERNEL_USE_TIMEOUTS
+    return MailBox_ReceiveN_i( pstMailBox_, pvData_, usCount_, false, 0 );
+#else
+    return MailBox_ReceiveN_i( pstMailBox_, pvData_, usCount_, false );
+#endif
+}
+
+//---------------------------------------------------------------------------
+K_USHORT MailBox_ReceiveTailN( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_ )
+{
+    KERNEL_ASSERT( pvData_ );
+
+#if KERNEL_USE_TIMEOUTS
+    return MailBox_ReceiveN_i( pstMailBox_, pvData_, usCount_, true, 0 );
+#else
+    return MailBox_ReceiveN_i( pstMailBox_, pvData_, usCount_, true );
+#endif
+}
+
+#if KERNEL_USE_TIMEOUTS
+//---------------------------------------------------------------------------
+K_USHORT MailBox_TimedSendN( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_, K_ULONG ulTimeoutMS_ )
+{
+    KERNEL_ASSERT( pvData_ );
+    return MailBox_SendN_i( pstMailBox_, pvData_, usCount_, false, ulTimeoutMS_ );
+}
+
+//---------------------------------------------------------------------------
+K_USHORT MailBox_TimedSendTailN( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_, K_ULONG ulTimeoutMS_ )
+{
+    KERNEL_ASSERT( pvData_ );
+    return MailBox_SendN_i( pstMailBox_, pvData_, usCount_, true, ulTimeoutMS_ );
+}
+
+//---------------------------------------------------------------------------
+K_USHORT MailBox_TimedReceiveN( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_, K_ULONG ulTimeoutMS_ )
+{
+    KERNEL_ASSERT( pvData_ );
+    return MailBox_ReceiveN_i( pstMailBox_, pvData_, usCount_, false, ulTimeoutMS_ );
+}
+
+//---------------------------------------------------------------------------
+K_USHORT MailBox_TimedReceiveTailN( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_, K_ULONG ulTimeoutMS_ )
+{
+    KERNEL_ASSERT( pvData_ );
+    return MailBox_ReceiveN_i( pstMailBox_, pvData_, usCount_, true, ulTimeoutMS_ );
+}
+#endif
+
 K_USHORT MailBox_GetFreeSlots( MailBox_t *pstMailBox_ )
 {
     K_USHORT rc;
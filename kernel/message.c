@@ -40,7 +40,7 @@ See license.txt for more information
 #endif
 
 static Message_t aclMessagePool[GLOBAL_MESSAGE_POOL_SIZE];
-static DoubleLinkList_t stList;
+static MessagePool_t stGlobalPool;
 
 #if KERNEL_USE_TIMEOUTS
 /*!
@@ -70,6 +70,9 @@ void Message_Init( Message_t* pstMsg_ )
 	LinkListNode_Clear( (LinkListNode_t*)pstMsg_ );
 	pstMsg_->pvData = NULL; 
 	pstMsg_->usCode = 0; 
+#if KERNEL_USE_MESSAGE_PRIORITY
+	pstMsg_->ucPriority = 0;
+#endif
 }
     
 //---------------------------------------------------------------------------
@@ -96,53 +99,241 @@ K_USHORT Message_GetCode( Message_t* pstMsg_ )
 	return pstMsg_->usCode; 
 }
 
+#if KERNEL_USE_MESSAGE_PRIORITY
 //---------------------------------------------------------------------------
-void GlobalMessagePool_Init( void )
+void Message_SetPriority( Message_t* pstMsg_, K_UCHAR ucPriority_ )
 {
-	K_UCHAR i;
+	// The priority indexes the queue's per-level tails - clamp it, rather
+	// than relying on an assert that release builds compile out.
+	if (ucPriority_ >= MESSAGE_PRIORITY_LEVELS)
+	{
+		ucPriority_ = MESSAGE_PRIORITY_LEVELS - 1;
+	}
+	pstMsg_->ucPriority = ucPriority_;
+}
 
-	DoubleLinkList_Init( &stList );
-	
-    for (i = 0; i < GLOBAL_MESSAGE_POOL_SIZE; i++)
+//---------------------------------------------------------------------------
+K_UCHAR Message_GetPriority( Message_t* pstMsg_ )
+{
+	return pstMsg_->ucPriority;
+}
+#endif
+
+//---------------------------------------------------------------------------
+void MessagePool_Init( MessagePool_t *pstPool_, Message_t *pastMessages_, K_USHORT usCount_ )
+{
+	K_USHORT i;
+
+	KERNEL_ASSERT( pastMessages_ );
+
+	DoubleLinkList_Init( &(pstPool_->stList) );
+
+	for (i = 0; i < usCount_; i++)
 	{
-		Message_Init( &aclMessagePool[i] );
-		DoubleLinkList_Add( &stList, (LinkListNode_t*)&aclMessagePool[i]);	
+		Message_Init( &pastMessages_[i] );
+		DoubleLinkList_Add( &(pstPool_->stList), (LinkListNode_t*)&pastMessages_[i]);
 	}
+
+	Semaphore_Init( &(pstPool_->stSemaphore), usCount_, usCount_ );
+
+	pstPool_->usSize = usCount_;
+	pstPool_->usInUse = 0;
+	pstPool_->usHighWater = 0;
+	pstPool_->usFailures = 0;
 }
 
 //---------------------------------------------------------------------------
-void GlobalMessagePool_Push( Message_t *pstMessage_ )
+void MessagePool_Push( MessagePool_t *pstPool_, Message_t *pstMessage_ )
 {
 	KERNEL_ASSERT( pstMessage_ );
-	
+
 	CS_ENTER();
-	
-	DoubleLinkList_Add( &stList, (LinkListNode_t*)pstMessage_ );
+
+	DoubleLinkList_Add( &(pstPool_->stList), (LinkListNode_t*)pstMessage_ );
+
+	// A message that was never popped from this pool must not wrap the
+	// in-use count, and with it the high-water mark.
+	if (pstPool_->usInUse)
+	{
+		pstPool_->usInUse--;
+	}
 
 	CS_EXIT();
+
+	// Post only once the message is on the free list, so that a thread
+	// which acquires the count is guaranteed to find a message.
+	Semaphore_Post( &(pstPool_->stSemaphore) );
 }
-	
+
 //---------------------------------------------------------------------------
-Message_t *GlobalMessagePool_Pop( void )
+/*!
+ * \brief MessagePool_Claim_i
+ *
+ * Remove a message from the pool's free list once the caller has acquired
+ * a count from the pool's semaphore, updating the usage statistics.
+ *
+ * \return Pointer to the claimed message
+ */
+static Message_t *MessagePool_Claim_i( MessagePool_t *pstPool_ )
 {
 	Message_t *pstRet;
+
 	CS_ENTER();
-	
-	pstRet = (Message_t*)( LinkList_GetHead( (LinkList_t*)&stList ) );
-    if (0 != pstRet)
-    {
-		DoubleLinkList_Remove( &stList, (LinkListNode_t*)pstRet );
-    }
-	
+
+	pstRet = (Message_t*)( LinkList_GetHead( (LinkList_t*)&(pstPool_->stList) ) );
+	DoubleLinkList_Remove( &(pstPool_->stList), (LinkListNode_t*)pstRet );
+
+	pstPool_->usInUse++;
+	if (pstPool_->usInUse > pstPool_->usHighWater)
+	{
+		pstPool_->usHighWater = pstPool_->usInUse;
+	}
+
 	CS_EXIT();
+
+#if KERNEL_USE_MESSAGE_PRIORITY
+	// Don't let a stale priority from a previous user jump the queue
+	pstRet->ucPriority = 0;
+#endif
 	return pstRet;
 }
 
+//---------------------------------------------------------------------------
+/*!
+ * \brief MessagePool_Fail_i
+ *
+ * Record a failed allocation from the pool.
+ *
+ * \return NULL, for convenience
+ */
+static Message_t *MessagePool_Fail_i( MessagePool_t *pstPool_ )
+{
+	CS_ENTER();
+	pstPool_->usFailures++;
+	CS_EXIT();
+	return NULL;
+}
+
+//---------------------------------------------------------------------------
+Message_t *MessagePool_Pop( MessagePool_t *pstPool_ )
+{
+	if (0 == Semaphore_TryPendN( &(pstPool_->stSemaphore), 1 ))
+	{
+		return MessagePool_Fail_i( pstPool_ );
+	}
+	return MessagePool_Claim_i( pstPool_ );
+}
+
+//---------------------------------------------------------------------------
+Message_t *MessagePool_BlockingPop( MessagePool_t *pstPool_ )
+{
+	Semaphore_Pend( &(pstPool_->stSemaphore) );
+	return MessagePool_Claim_i( pstPool_ );
+}
+
+#if KERNEL_USE_TIMEOUTS
+//---------------------------------------------------------------------------
+Message_t *MessagePool_TimedPop( MessagePool_t *pstPool_, K_ULONG ulWaitTimeMS_ )
+{
+	if (0 == Semaphore_TimedPend( &(pstPool_->stSemaphore), ulWaitTimeMS_ ))
+	{
+		return MessagePool_Fail_i( pstPool_ );
+	}
+	return MessagePool_Claim_i( pstPool_ );
+}
+#endif
+
+//---------------------------------------------------------------------------
+K_USHORT MessagePool_GetFree( MessagePool_t *pstPool_ )
+{
+	return Semaphore_GetCount( &(pstPool_->stSemaphore) );
+}
+
+//---------------------------------------------------------------------------
+K_USHORT MessagePool_GetHighWater( MessagePool_t *pstPool_ )
+{
+	return pstPool_->usHighWater;
+}
+
+//---------------------------------------------------------------------------
+K_USHORT MessagePool_GetFailures( MessagePool_t *pstPool_ )
+{
+	return pstPool_->usFailures;
+}
+
+//---------------------------------------------------------------------------
+void MessagePool_ResetStats( MessagePool_t *pstPool_ )
+{
+	CS_ENTER();
+	pstPool_->usHighWater = pstPool_->usInUse;
+	pstPool_->usFailures = 0;
+	CS_EXIT();
+}
+
+//---------------------------------------------------------------------------
+void GlobalMessagePool_Init( void )
+{
+	MessagePool_Init( &stGlobalPool, aclMessagePool, GLOBAL_MESSAGE_POOL_SIZE );
+}
+
+//---------------------------------------------------------------------------
+void GlobalMessagePool_Push( Message_t *pstMessage_ )
+{
+	MessagePool_Push( &stGlobalPool, pstMessage_ );
+}
+	
+//---------------------------------------------------------------------------
+Message_t *GlobalMessagePool_Pop( void )
+{
+	return MessagePool_Pop( &stGlobalPool );
+}
+
+//---------------------------------------------------------------------------
+MessagePool_t *GlobalMessagePool_GetPool( void )
+{
+	return &stGlobalPool;
+}
+
 //---------------------------------------------------------------------------
 void MessageQueue_Init( MessageQueue_t *pstMsgQ_ ) 
 { 
-	Semaphore_Init( &(pstMsgQ_->stSemaphore), 0, GLOBAL_MESSAGE_POOL_SIZE);  
+	// A queue may carry messages from several pools, so don't cap its count
+	// at the size of any one of them.
+	Semaphore_Init( &(pstMsgQ_->stSemaphore), 0, 0xFFFF);  
 	DoubleLinkList_Init( &(pstMsgQ_->stLinkList) );  
+	pstMsgQ_->pstPool = &stGlobalPool;
+#if KERNEL_USE_MESSAGE_PRIORITY
+	{
+		K_UCHAR i;
+		for (i = 0; i < MESSAGE_PRIORITY_LEVELS; i++)
+		{
+			pstMsgQ_->apstPriTail[i] = NULL;
+		}
+	}
+	pstMsgQ_->bPriorityOrder = false;
+#endif
+}
+
+#if KERNEL_USE_MESSAGE_PRIORITY
+//---------------------------------------------------------------------------
+void MessageQueue_SetPriorityOrder( MessageQueue_t *pstMsgQ_, bool bEnable_ )
+{
+	KERNEL_ASSERT( !LinkList_GetHead( &(pstMsgQ_->stLinkList) ) );
+	pstMsgQ_->bPriorityOrder = bEnable_;
+}
+#endif
+
+//---------------------------------------------------------------------------
+void MessageQueue_SetPool( MessageQueue_t *pstMsgQ_, MessagePool_t *pstPool_ )
+{
+	KERNEL_ASSERT( pstPool_ );
+	pstMsgQ_->pstPool = pstPool_;
+}
+
+//---------------------------------------------------------------------------
+MessagePool_t *MessageQueue_GetPool( MessageQueue_t *pstMsgQ_ )
+{
+	return pstMsgQ_->pstPool;
 }
 
 //---------------------------------------------------------------------------
@@ -187,6 +378,14 @@ Message_t *MessageQueue_Receive_i(  MessageQueue_t *pstMsgQ_ )
 	// Pop the head of the message queue and return it
 	pstRet = (Message_t*)LinkList_GetHead( (LinkList_t*)&(pstMsgQ_->stLinkList) );
 	DoubleLinkList_Remove( (DoubleLinkList_t*)&(pstMsgQ_->stLinkList), (LinkListNode_t*)pstRet );
+
+#if KERNEL_USE_MESSAGE_PRIORITY
+	// If that was the last message at its priority, that level is now empty
+	if (pstMsgQ_->apstPriTail[ pstRet->ucPriority ] == (LinkListNode_t*)pstRet)
+	{
+		pstMsgQ_->apstPriTail[ pstRet->ucPriority ] = NULL;
+	}
+#endif
 	
 	CS_EXIT();
 	
@@ -200,8 +399,31 @@ void MessageQueue_Send( MessageQueue_t *pstMsgQ_, Message_t *pstSrc_ )
 	
 	CS_ENTER();
 	
-	// Add the message to the head of the linked list
-	DoubleLinkList_Add( (DoubleLinkList_t*)&(pstMsgQ_->stLinkList), (LinkListNode_t*)pstSrc_ );
+#if KERNEL_USE_MESSAGE_PRIORITY
+	if (pstMsgQ_->bPriorityOrder)
+	{
+		// The list is sorted highest-priority first.  Insert the message
+		// after the last message of the same priority, or failing that,
+		// after the last message of the nearest higher priority.  This
+		// bounds the search by the number of priority levels, not by the
+		// number of queued messages.
+		LinkListNode_t *pstPrev = NULL;
+		K_UCHAR ucPri = pstSrc_->ucPriority;
+		while (!pstPrev && (ucPri < MESSAGE_PRIORITY_LEVELS))
+		{
+			pstPrev = pstMsgQ_->apstPriTail[ucPri];
+			ucPri++;
+		}
+		DoubleLinkList_InsertAfter( (DoubleLinkList_t*)&(pstMsgQ_->stLinkList),
+									(LinkListNode_t*)pstSrc_, pstPrev );
+		pstMsgQ_->apstPriTail[ pstSrc_->ucPriority ] = (LinkListNode_t*)pstSrc_;
+	}
+	else
+#endif
+	{
+		// Add the message to the tail of the linked list
+		DoubleLinkList_Add( (DoubleLinkList_t*)&(pstMsgQ_->stLinkList), (LinkListNode_t*)pstSrc_ );
+	}
 		
 	// Post the Semaphore_t, waking the blocking thread for the queue.
 	Semaphore_Post( &(pstMsgQ_->stSemaphore) );
@@ -0,0 +1,385 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   multiwait.c
+
+    \brief  Wait on multiple blocking objects at once
+*/
+
+#include "mark3cfg.h"
+#include "kerneltypes.h"
+#include "blocking.h"
+#include "thread.h"
+#include "threadport.h"
+#include "kerneldebug.h"
+#include "multiwait.h"
+
+//---------------------------------------------------------------------------
+#if defined __FILE_ID__
+	#undef __FILE_ID__
+#endif
+#define __FILE_ID__ 	MULTIWAIT_C       //!< File ID used in kernel trace calls
+
+#if KERNEL_USE_MULTIWAIT
+
+#if KERNEL_USE_TIMEOUTS
+#include "timerlist.h"
+#endif
+
+//---------------------------------------------------------------------------
+void MultiWait_InitSemaphore( MultiWaitEntry_t *pstEntry_, Semaphore_t *pstSem_ )
+{
+    pstEntry_->pstNext = NULL;
+    pstEntry_->pstList = NULL;
+    pstEntry_->pvObject = (void*)pstSem_;
+    pstEntry_->eType = MULTIWAIT_SEMAPHORE;
+}
+
+#if KERNEL_USE_MAILBOX
+//---------------------------------------------------------------------------
+void MultiWait_InitMailBox( MultiWaitEntry_t *pstEntry_, MailBox_t *pstMailBox_ )
+{
+    pstEntry_->pstNext = NULL;
+    pstEntry_->pstList = NULL;
+    pstEntry_->pvObject = (void*)pstMailBox_;
+    pstEntry_->eType = MULTIWAIT_MAILBOX;
+}
+#endif
+
+#if KERNEL_USE_MESSAGE
+//---------------------------------------------------------------------------
+void MultiWait_InitMessageQueue( MultiWaitEntry_t *pstEntry_, MessageQueue_t *pstMsgQ_ )
+{
+    pstEntry_->pstNext = NULL;
+    pstEntry_->pstList = NULL;
+    pstEntry_->pvObject = (void*)pstMsgQ_;
+    pstEntry_->eType = MULTIWAIT_MESSAGE_QUEUE;
+}
+#endif
+
+#if KERNEL_USE_EVENTFLAG
+//---------------------------------------------------------------------------
+void MultiWait_InitEventFlag( MultiWaitEntry_t *pstEntry_, EventFlag_t *pstFlag_, K_FLAG_MASK tMask_, EventFlagOperation_t eMode_ )
+{
+    pstEntry_->pstNext = NULL;
+    pstEntry_->pstList = NULL;
+    pstEntry_->pvObject = (void*)pstFlag_;
+    pstEntry_->eType = MULTIWAIT_EVENTFLAG;
+    pstEntry_->tMask = tMask_;
+    pstEntry_->eMode = eMode_;
+}
+#endif
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief MultiWait_GetSemaphore_i
+ *
+ * Mailboxes and message queues signal waiting readers through an embedded
+ * semaphore, so readiness of all three object types is tracked by the
+ * semaphore's count.
+ *
+ * \param pstEntry_ Semaphore, mailbox or message-queue entry
+ * \return Pointer to the semaphore that tracks the object's readiness
+ */
+static Semaphore_t *MultiWait_GetSemaphore_i( MultiWaitEntry_t *pstEntry_ )
+{
+#if KERNEL_USE_MAILBOX
+    if (MULTIWAIT_MAILBOX == pstEntry_->eType)
+    {
+        return &(((MailBox_t*)pstEntry_->pvObject)->stRecvSem);
+    }
+#endif
+#if KERNEL_USE_MESSAGE
+    if (MULTIWAIT_MESSAGE_QUEUE == pstEntry_->eType)
+    {
+        return &(((MessageQueue_t*)pstEntry_->pvObject)->stSemaphore);
+    }
+#endif
+    return (Semaphore_t*)pstEntry_->pvObject;
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief MultiWait_GetHead_i
+ *
+ * \param pstEntry_ Entry to look up
+ * \return Pointer to the head of the entry list on the entry's object
+ */
+static MultiWaitEntry_t **MultiWait_GetHead_i( MultiWaitEntry_t *pstEntry_ )
+{
+#if KERNEL_USE_EVENTFLAG
+    if (MULTIWAIT_EVENTFLAG == pstEntry_->eType)
+    {
+        return &(((EventFlag_t*)pstEntry_->pvObject)->pstMultiWait);
+    }
+#endif
+    return &(MultiWait_GetSemaphore_i( pstEntry_ )->pstMultiWait);
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief MultiWait_IsReady_i
+ *
+ * Check whether an entry's object is ready.  Must be called from within a
+ * critical section.
+ *
+ * \param pstEntry_ Entry to check
+ * \return true if the object is ready
+ */
+static K_BOOL MultiWait_IsReady_i( MultiWaitEntry_t *pstEntry_ )
+{
+#if KERNEL_USE_EVENTFLAG
+    if (MULTIWAIT_EVENTFLAG == pstEntry_->eType)
+    {
+        K_FLAG_MASK tSet = ((EventFlag_t*)pstEntry_->pvObject)->tSetMask & pstEntry_->tMask;
+        if ((EVENT_FLAG_ALL == pstEntry_->eMode) || (EVENT_FLAG_ALL_CLEAR == pstEntry_->eMode))
+        {
+            return (tSet == pstEntry_->tMask);
+        }
+        return (tSet != 0);
+    }
+#endif
+    return (MultiWait_GetSemaphore_i( pstEntry_ )->usValue != 0);
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief MultiWait_Poll_i
+ *
+ * Must be called from within a critical section.
+ *
+ * \return Index of the first ready entry, or MULTIWAIT_TIMEOUT if none
+ */
+static K_UCHAR MultiWait_Poll_i( MultiWaitEntry_t *astEntries_, K_UCHAR ucCount_ )
+{
+    K_UCHAR i;
+    for (i = 0; i < ucCount_; i++)
+    {
+        if (MultiWait_IsReady_i( &astEntries_[i] ))
+        {
+            return i;
+        }
+    }
+    return MULTIWAIT_TIMEOUT;
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief MultiWait_Link_i
+ *
+ * Link each entry onto its object, so that the object wakes the thread
+ * blocked on pstList_ when it becomes ready.  The entries are recorded on
+ * the current thread, so they can be unlinked if it is stopped or exits
+ * while still waiting.  Must be called from within a critical section.
+ */
+static void MultiWait_Link_i( MultiWaitEntry_t *astEntries_, K_UCHAR ucCount_, ThreadList_t *pstList_ )
+{
+    MultiWaitEntry_t **ppstHead;
+    K_UCHAR i;
+
+    for (i = 0; i < ucCount_; i++)
+    {
+        ppstHead = MultiWait_GetHead_i( &astEntries_[i] );
+        astEntries_[i].pstList = pstList_;
+        astEntries_[i].pstNext = *ppstHead;
+        *ppstHead = &astEntries_[i];
+    }
+    g_pstCurrent->pstMultiWait = astEntries_;
+    g_pstCurrent->ucMultiWaitCount = ucCount_;
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief MultiWait_Unlink_i
+ *
+ * Remove each entry from its object's entry list.  Must be called from
+ * within a critical section.
+ */
+static void MultiWait_Unlink_i( MultiWaitEntry_t *astEntries_, K_UCHAR ucCount_ )
+{
+    MultiWaitEntry_t **ppstLink;
+    K_UCHAR i;
+
+    for (i = 0; i < ucCount_; i++)
+    {
+        ppstLink = MultiWait_GetHead_i( &astEntries_[i] );
+        while (*ppstLink != &astEntries_[i])
+        {
+            ppstLink = &((*ppstLink)->pstNext);
+        }
+        *ppstLink = astEntries_[i].pstNext;
+        astEntries_[i].pstNext = NULL;
+        astEntries_[i].pstList = NULL;
+    }
+}
+
+//---------------------------------------------------------------------------
+void MultiWait_Cancel_i( Thread_t *pstThread_ )
+{
+    if (pstThread_->pstMultiWait)
+    {
+        MultiWait_Unlink_i( pstThread_->pstMultiWait, pstThread_->ucMultiWaitCount );
+        pstThread_->pstMultiWait = NULL;
+        pstThread_->ucMultiWaitCount = 0;
+    }
+}
+
+//---------------------------------------------------------------------------
+K_BOOL MultiWait_Signal_i( MultiWaitEntry_t *pstHead_ )
+{
+    Thread_t *pstThread;
+    K_BOOL bReschedule = false;
+
+    while (pstHead_)
+    {
+        // A waiting thread may be linked onto several objects that become
+        // ready at once, but is only on its wait list until the first wakes it.
+        pstThread = (Thread_t*)LinkList_GetHead( (LinkList_t*)pstHead_->pstList );
+        if (pstThread && MultiWait_IsReady_i( pstHead_ ))
+        {
+            BlockingObject_UnBlock( pstThread );
+            if (Thread_GetCurPriority( pstThread ) >=
+                Thread_GetCurPriority( Scheduler_GetCurrentThread() ))
+            {
+                bReschedule = true;
+            }
+        }
+        pstHead_ = pstHead_->pstNext;
+    }
+    return bReschedule;
+}
+
+#if KERNEL_USE_TIMEOUTS
+//---------------------------------------------------------------------------
+/*!
+ * \brief TimedMultiWait_Callback
+ *
+ * Called from the timer-expired context when none of the objects in a
+ * multi-wait became ready in time.
+ *
+ * \param pstOwner_ Thread_t to wake
+ * \param pvData_   Pointer to the list the thread is blocked on
+ */
+static void TimedMultiWait_Callback( Thread_t *pstOwner_, void *pvData_ )
+{
+    Thread_SetExpired( pstOwner_, true );
+
+    // Only wake the thread if it hasn't already been woken by an object
+    if (Thread_GetCurrent( pstOwner_ ) == (ThreadList_t*)pvData_)
+    {
+        BlockingObject_UnBlock( pstOwner_ );
+        if (Thread_GetCurPriority( pstOwner_ ) >=
+            Thread_GetCurPriority( Scheduler_GetCurrentThread() ))
+        {
+            Thread_Yield();
+        }
+    }
+}
+#endif
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief MultiWait_Wait_i
+ *
+ * Internal function used to abstract timed and untimed multi-waits.
+ *
+ * \param ulTimeoutMS_ Time to wait in ms, 0 to wait forever
+ * \return Index of the first ready entry, or MULTIWAIT_TIMEOUT
+ */
+static K_UCHAR MultiWait_Wait_i( MultiWaitEntry_t *astEntries_, K_UCHAR ucCount_, K_ULONG ulTimeoutMS_ )
+{
+    ThreadList_t stList;
+    K_UCHAR ucReady;
+    K_BOOL bLinked = false;
+    K_BOOL bDone = false;
+#if KERNEL_USE_TIMEOUTS
+    K_BOOL bUseTimer = false;
+#endif
+
+    KERNEL_ASSERT( ucCount_ && (ucCount_ < MULTIWAIT_TIMEOUT) );
+
+    ThreadList_Init( &stList );
+
+    while (!bDone)
+    {
+        CS_ENTER();
+
+        ucReady = MultiWait_Poll_i( astEntries_, ucCount_ );
+#if KERNEL_USE_TIMEOUTS
+        if ((MULTIWAIT_TIMEOUT == ucReady) && bUseTimer && Thread_GetExpired( g_pstCurrent ))
+        {
+            bDone = true;
+        }
+        else
+#endif
+        if (MULTIWAIT_TIMEOUT == ucReady)
+        {
+            // Nothing ready - link onto the objects (the first time through)
+            // and block until one of them, or the timeout, wakes us.  We go
+            // around again afterwards, in case another thread got there first.
+            if (!bLinked)
+            {
+                MultiWait_Link_i( astEntries_, ucCount_, &stList );
+                bLinked = true;
+#if KERNEL_USE_TIMEOUTS
+                if (ulTimeoutMS_)
+                {
+                    Thread_SetExpired( g_pstCurrent, false );
+                    Timer_Start( Thread_GetTimer( g_pstCurrent ), false, ulTimeoutMS_,
+                                 TimedMultiWait_Callback, (void*)&stList );
+                    bUseTimer = true;
+                }
+#endif
+            }
+            BlockingObject_Block( &stList, g_pstCurrent );
+            Thread_Yield();
+        }
+        else
+        {
+            bDone = true;
+        }
+
+        if (bDone && bLinked)
+        {
+            MultiWait_Cancel_i( g_pstCurrent );
+        }
+
+        CS_EXIT();
+    }
+
+#if KERNEL_USE_TIMEOUTS
+    if (bUseTimer)
+    {
+        Timer_Stop( Thread_GetTimer( g_pstCurrent ) );
+    }
+#endif
+    return ucReady;
+}
+
+//---------------------------------------------------------------------------
+K_UCHAR MultiWait_Wait( MultiWaitEntry_t *astEntries_, K_UCHAR ucCount_ )
+{
+    return MultiWait_Wait_i( astEntries_, ucCount_, 0 );
+}
+
+#if KERNEL_USE_TIMEOUTS
+//---------------------------------------------------------------------------
+K_UCHAR MultiWait_TimedWait( MultiWaitEntry_t *astEntries_, K_UCHAR ucCount_, K_ULONG ulTimeoutMS_ )
+{
+    return MultiWait_Wait_i( astEntries_, ucCount_, ulTimeoutMS_ );
+}
+#endif
+
+#endif // KERNEL_USE_MULTIWAIT
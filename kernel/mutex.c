@@ -126,6 +126,21 @@ K_UCHAR Mutex_WakeNext( Mutex_t *pstMutex_ )
     // The chosen one now owns the Mutex_t
     pstMutex_->pstOwner = pstChosenOne;
 
+#if KERNEL_USE_PRIORITY_WAITLISTS
+    // Only the owner inherits the priority of the waiters.  The remaining
+    // waiters are sorted, so the next-highest waiter is at the head.
+    pstMutex_->ucMaxPri = Thread_GetPriority( pstChosenOne );
+    if (LinkList_GetHead( (LinkList_t*)pstMutex_ ))
+    {
+        Thread_t *pstNext = (Thread_t*)LinkList_GetHead( (LinkList_t*)pstMutex_ );
+        if (Thread_GetCurPriority( pstNext ) > Thread_GetCurPriority( pstChosenOne ))
+        {
+            pstMutex_->ucMaxPri = Thread_GetCurPriority( pstNext );
+            Thread_InheritPriority( pstChosenOne, pstMutex_->ucMaxPri );
+        }
+    }
+#endif
+
     // Signal a context switch if it's a greater than or equal to the current priority
     if ( Thread_GetCurPriority(pstChosenOne) >= 
 		 Thread_GetCurPriority( Scheduler_GetCurrentThread() ) )		
@@ -135,6 +150,82 @@ K_UCHAR Mutex_WakeNext( Mutex_t *pstMutex_ )
     return 0;
 }
 
+//---------------------------------------------------------------------------
+/*!
+ * \brief Mutex_TryFastClaim_i
+ *
+ * Claim the Mutex_t if it is free, or bump the lock count if the current
+ * thread already owns it.  Neither case involves any other thread, so no
+ * scheduler lock is needed.
+ *
+ * \return true if the Mutex_t was claimed, false if the caller must block
+ */
+static K_BOOL Mutex_TryFastClaim_i( Mutex_t *pstMutex_ )
+{
+    K_BOOL bRet = true;
+
+    CS_ENTER();
+    if (pstMutex_->bReady != 0)
+    {
+        pstMutex_->bReady = 0;
+        pstMutex_->ucRecurse = 0;
+        pstMutex_->ucMaxPri = Thread_GetPriority( g_pstCurrent );
+        pstMutex_->pstOwner = g_pstCurrent;
+    }
+    else if (g_pstCurrent == pstMutex_->pstOwner)
+    {
+        // Ensure that we haven't exceeded the maximum recursive-lock count
+        KERNEL_ASSERT( (pstMutex_->ucRecurse < 255) );
+        pstMutex_->ucRecurse++;
+    }
+    else
+    {
+        bRet = false;
+    }
+    CS_EXIT();
+
+    return bRet;
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief Mutex_TryFastRelease_i
+ *
+ * Release a recursive lock, or free the Mutex_t if no thread is waiting on
+ * it and the owner isn't running at an inherited priority.
+ *
+ * \return true if the release is complete, false if waiters have to be
+ *         woken or the owner's priority restored
+ */
+static K_BOOL Mutex_TryFastRelease_i( Mutex_t *pstMutex_ )
+{
+    K_BOOL bRet = true;
+
+    CS_ENTER();
+
+    // This thread had better be the one that owns the Mutex_t currently...
+    KERNEL_ASSERT( (g_pstCurrent == pstMutex_->pstOwner) );
+
+    if (pstMutex_->ucRecurse)
+    {
+        pstMutex_->ucRecurse--;
+    }
+    else if ((LinkList_GetHead( (LinkList_t*)pstMutex_ ) == NULL) &&
+             (Thread_GetCurPriority( g_pstCurrent ) == Thread_GetPriority( g_pstCurrent )))
+    {
+        pstMutex_->bReady = 1;
+        pstMutex_->ucMaxPri = 0;
+        pstMutex_->pstOwner = NULL;
+    }
+    else
+    {
+        bRet = false;
+    }
+    CS_EXIT();
+
+    return bRet;
+}
+
 //---------------------------------------------------------------------------
 void Mutex_Init( Mutex_t *pstMutex_ )
 {
@@ -154,16 +245,29 @@ K_BOOL Mutex_Claii( Mutex_t *pstMutex_, K_ULONG ulWaitTimeMS_)
 void Mutex_Claii( Mutex_t *pstMutex_ )
 #endif
 {
-    KERNEL_TRACE_1( STR_MUTEX_CLAIM_1, (K_USHORT)Thread_GetID( g_pstCurrent ) );
+    KERNEL_TRACE_1( TRACE_LEVEL_VERBOSE, STR_MUTEX_CLAIM_1, (K_USHORT)Thread_GetID( g_pstCurrent ) );
 
 #if KERNEL_USE_TIMEOUTS
     Timer_t stTimer;
     K_BOOL bUseTimer = false;
 #endif
 
+    // Fast path: a free Mutex_t, or a recursive claim by the owner, only
+    // touches the Mutex_t itself and can be handled in a single short
+    // critical section.
+    if (Mutex_TryFastClaim_i( pstMutex_ ))
+    {
+#if KERNEL_USE_TIMEOUTS
+        return true;
+#else
+        return;
+#endif
+    }
+
     // Disable the scheduler while claiming the Mutex_t - we're dealing with all
     // sorts of private thread data, can't have a thread switch while messing
-    // with internal data structures.
+    // with internal data structures.  The Mutex_t may have been released
+    // since the fast-path check, so the state is re-examined below.
     Scheduler_SetScheduler( false );
 
     // Check to see if the Mutex_t is claimed or not
@@ -218,6 +322,17 @@ void Mutex_Claii( Mutex_t *pstMutex_ )
     // Check if priority inheritence is necessary.  We do this in order
     // to ensure that we don't end up with priority inversions in case
     // multiple threads are waiting on the same resource.
+#if KERNEL_USE_PRIORITY_WAITLISTS
+    // The wait list is kept sorted, so only the owner has to be boosted.
+    if (pstMutex_->ucMaxPri < Thread_GetCurPriority( g_pstCurrent ) )
+    {
+        pstMutex_->ucMaxPri = Thread_GetCurPriority( g_pstCurrent );
+        if (Thread_GetCurPriority( pstMutex_->pstOwner ) < pstMutex_->ucMaxPri)
+        {
+            Thread_InheritPriority( pstMutex_->pstOwner, pstMutex_->ucMaxPri );
+        }
+    }
+#else
     if(pstMutex_->ucMaxPri <= Thread_GetPriority( g_pstCurrent ) )
     {
         pstMutex_->ucMaxPri = Thread_GetPriority( g_pstCurrent );
@@ -234,6 +349,7 @@ void Mutex_Claii( Mutex_t *pstMutex_ )
         }
         Thread_InheritPriority( pstMutex_->pstOwner, pstMutex_->ucMaxPri );
     }
+#endif
 
     // Done with thread data -reenable the scheduler
     Scheduler_SetScheduler( true );
@@ -272,10 +388,16 @@ K_BOOL Mutex_TimedClaim( Mutex_t *pstMutex_, K_ULONG ulWaitTimeMS_ )
 //---------------------------------------------------------------------------
 void Mutex_Release( Mutex_t *pstMutex_ )
 {
-	KERNEL_TRACE_1( STR_MUTEX_RELEASE_1, (K_USHORT)Thread_GetID( g_pstCurrent ) );
+	KERNEL_TRACE_1( TRACE_LEVEL_VERBOSE, STR_MUTEX_RELEASE_1, (K_USHORT)Thread_GetID( g_pstCurrent ) );
 
     K_BOOL bSchedule = 0;
 
+    // Fast path: no waiters and no inherited priority to undo.
+    if (Mutex_TryFastRelease_i( pstMutex_ ))
+    {
+        return;
+    }
+
     // Disable the scheduler while we deal with internal data structures.
     Scheduler_SetScheduler( false );
 
@@ -0,0 +1,159 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   priomap.c
+
+    \brief  Priority bitmap used by the scheduler
+
+*/
+
+#include "kerneltypes.h"
+#include "priomap.h"
+#include "kerneldebug.h"
+//---------------------------------------------------------------------------
+#if defined __FILE_ID__
+    #undef __FILE_ID__
+#endif
+#define __FILE_ID__     PRIOMAP_C   //!< File ID used in kernel trace calls
+
+#if PRIO_MAP_WORD_BITS == 8
+//---------------------------------------------------------------------------
+/*!
+ * This implements a 4-bit "Count-leading-zeros" operation using a lookup
+ * table.  It is used to efficiently perform a CLZ operation under the
+ * assumption that a native CLZ instruction is unavailable.  This table is
+ * further optimized to provide a 0xFF result in the event that the index value
+ * is itself zero, allowing us to quickly identify whether or not subsequent
+ * 4-bit LUT operations are required.
+ */
+static const K_UCHAR aucCLZ[16] ={255,0,1,1,2,2,2,2,3,3,3,3,3,3,3,3};
+
+//---------------------------------------------------------------------------
+/*!
+ * Return the index of the most-significant set bit in an 8-bit word, or
+ * PRIO_MAP_NONE if no bits are set.
+ */
+static K_UCHAR PriorityMap_HighestBit( PRIO_TYPE tWord_ )
+{
+    K_UCHAR ucBit = aucCLZ[ tWord_ >> 4 ];
+    if (ucBit == 0xFF)
+    {
+        return aucCLZ[ tWord_ & 0x0F ];
+    }
+    return ucBit + 4;
+}
+
+#elif PRIO_MAP_WORD_BITS == 32
+//---------------------------------------------------------------------------
+/*!
+ * Lookup table used to convert a 32-bit word with all bits below its most-
+ * significant set bit filled in, multiplied by the de Bruijn constant
+ * 0x07C4ACDD, into the index of that most-significant bit.
+ */
+static const K_UCHAR aucDeBruijn[32] =
+{
+     0,  9,  1, 10, 13, 21,  2, 29, 11, 14, 16, 18, 22, 25,  3, 30,
+     8, 12, 20, 28, 15, 17, 24,  7, 19, 27, 23,  6, 26,  5,  4, 31
+};
+
+//---------------------------------------------------------------------------
+/*!
+ * Return the index of the most-significant set bit in a 32-bit word, or
+ * PRIO_MAP_NONE if no bits are set.  Runs in a fixed number of cycles on
+ * cores without a CLZ instruction (i.e. Cortex-M0).
+ */
+static K_UCHAR PriorityMap_HighestBit( PRIO_TYPE tWord_ )
+{
+    if (!tWord_)
+    {
+        return PRIO_MAP_NONE;
+    }
+
+    // Smear the most-significant set bit into all lower bit positions
+    tWord_ |= tWord_ >> 1;
+    tWord_ |= tWord_ >> 2;
+    tWord_ |= tWord_ >> 4;
+    tWord_ |= tWord_ >> 8;
+    tWord_ |= tWord_ >> 16;
+
+    return aucDeBruijn[ (K_ULONG)(tWord_ * 0x07C4ACDDUL) >> 27 ];
+}
+
+#else
+    #error "Unsupported PRIO_MAP_WORD_BITS"
+#endif
+
+//---------------------------------------------------------------------------
+void PriorityMap_Init( PriorityMap_t *pstMap_ )
+{
+    K_UCHAR i;
+    for (i = 0; i < PRIO_MAP_WORDS; i++)
+    {
+        pstMap_->atFlags[i] = 0;
+    }
+#if PRIO_MAP_MULTI_LEVEL
+    pstMap_->tWordMap = 0;
+#endif
+}
+
+//---------------------------------------------------------------------------
+void PriorityMap_Set( PriorityMap_t *pstMap_, K_UCHAR ucPriority_ )
+{
+#if PRIO_MAP_MULTI_LEVEL
+    K_UCHAR ucWord = ucPriority_ / PRIO_MAP_WORD_BITS;
+    K_UCHAR ucBit  = ucPriority_ % PRIO_MAP_WORD_BITS;
+
+    pstMap_->atFlags[ucWord] |= ((PRIO_TYPE)1 << ucBit);
+    pstMap_->tWordMap |= ((PRIO_TYPE)1 << ucWord);
+#else
+    pstMap_->atFlags[0] |= ((PRIO_TYPE)1 << ucPriority_);
+#endif
+}
+
+//---------------------------------------------------------------------------
+void PriorityMap_Clear( PriorityMap_t *pstMap_, K_UCHAR ucPriority_ )
+{
+#if PRIO_MAP_MULTI_LEVEL
+    K_UCHAR ucWord = ucPriority_ / PRIO_MAP_WORD_BITS;
+    K_UCHAR ucBit  = ucPriority_ % PRIO_MAP_WORD_BITS;
+
+    pstMap_->atFlags[ucWord] &= ~((PRIO_TYPE)1 << ucBit);
+
+    // Only clear the word's summary bit once the last priority in it is gone
+    if (!pstMap_->atFlags[ucWord])
+    {
+        pstMap_->tWordMap &= ~((PRIO_TYPE)1 << ucWord);
+    }
+#else
+    pstMap_->atFlags[0] &= ~((PRIO_TYPE)1 << ucPriority_);
+#endif
+}
+
+//---------------------------------------------------------------------------
+K_UCHAR PriorityMap_HighestPriority( PriorityMap_t *pstMap_ )
+{
+#if PRIO_MAP_MULTI_LEVEL
+    // Find the highest non-empty word, then the highest bit within it.
+    K_UCHAR ucWord = PriorityMap_HighestBit( pstMap_->tWordMap );
+    if (ucWord == PRIO_MAP_NONE)
+    {
+        return PRIO_MAP_NONE;
+    }
+    return (ucWord * PRIO_MAP_WORD_BITS)
+            + PriorityMap_HighestBit( pstMap_->atFlags[ucWord] );
+#else
+    return PriorityMap_HighestBit( pstMap_->atFlags[0] );
+#endif
+}
@@ -33,6 +33,47 @@ See license.txt for more information
 
 #if KERNEL_USE_PROFILER
 
+//---------------------------------------------------------------------------
+/*!
+    Update the min/max and histogram with a completed iteration.  Must be
+    called from within a critical section.
+*/
+static void ProfileTimer_Record_i( ProfileTimer_t *pstTimer_, K_ULONG ulTicks_ )
+{
+
+    if (ulTicks_ < pstTimer_->ulMin)
+    {
+        pstTimer_->ulMin = ulTicks_;
+    }
+    if (ulTicks_ > pstTimer_->ulMax)
+    {
+        pstTimer_->ulMax = ulTicks_;
+    }
+
+    if (pstTimer_->pusHistogram)
+    {
+        K_USHORT *pusBucket = &pstTimer_->pusHistogram[ ProfileTimer_GetBucket( ulTicks_ ) ];
+        if (*pusBucket != 0xFFFF)
+        {
+            (*pusBucket)++;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------
+K_UCHAR ProfileTimer_GetBucket( K_ULONG ulTicks_ )
+{
+    K_UCHAR ucBucket = 0;
+
+    // Bucket index is floor(log2(ticks)), clamped to the last bucket
+    while ((ulTicks_ > 1) && (ucBucket < (PROFILE_HISTOGRAM_BUCKETS - 1)))
+    {
+        ulTicks_ >>= 1;
+        ucBucket++;
+    }
+    return ucBucket;
+}
+
 //---------------------------------------------------------------------------
 void ProfileTimer_Init( ProfileTimer_t *pstTimer_ )
 {
@@ -40,6 +81,47 @@ void ProfileTimer_Init( ProfileTimer_t *pstTimer_ )
     pstTimer_->ulCurrentIteration = 0;
     pstTimer_->usIterations = 0;
     pstTimer_->bActive = 0;
+    pstTimer_->ulMin = 0xFFFFFFFF;
+    pstTimer_->ulMax = 0;
+    pstTimer_->pusHistogram = 0;
+}
+
+//---------------------------------------------------------------------------
+void ProfileTimer_SetHistogram( ProfileTimer_t *pstTimer_, K_USHORT *pusBuckets_ )
+{
+    K_UCHAR i;
+
+    if (pusBuckets_)
+    {
+        for (i = 0; i < PROFILE_HISTOGRAM_BUCKETS; i++)
+        {
+            pusBuckets_[i] = 0;
+        }
+    }
+
+    CS_ENTER();
+    pstTimer_->pusHistogram = pusBuckets_;
+    CS_EXIT();
+}
+
+//---------------------------------------------------------------------------
+void ProfileTimer_Reset( ProfileTimer_t *pstTimer_ )
+{
+    K_UCHAR i;
+
+    CS_ENTER();
+    pstTimer_->ulCumulative = 0;
+    pstTimer_->usIterations = 0;
+    pstTimer_->ulMin = 0xFFFFFFFF;
+    pstTimer_->ulMax = 0;
+    if (pstTimer_->pusHistogram)
+    {
+        for (i = 0; i < PROFILE_HISTOGRAM_BUCKETS; i++)
+        {
+            pstTimer_->pusHistogram[i] = 0;
+        }
+    }
+    CS_EXIT();
 }
 
 //---------------------------------------------------------------------------    
@@ -70,11 +152,34 @@ void ProfileTimer_Stop( ProfileTimer_t *pstTimer_ )
         pstTimer_->ulCurrentIteration = ProfileTimer_ComputeCurrentTicks( pstTimer_, usFinal, ulEpoch);
         pstTimer_->ulCumulative += pstTimer_->ulCurrentIteration;
         pstTimer_->usIterations++;
+        ProfileTimer_Record_i( pstTimer_, pstTimer_->ulCurrentIteration );
         CS_EXIT();
         pstTimer_->bActive = 0;
     }
 }
 
+//---------------------------------------------------------------------------
+K_ULONG ProfileTimer_GetMin( ProfileTimer_t *pstTimer_ )
+{
+    if (pstTimer_->usIterations)
+    {
+        return pstTimer_->ulMin;
+    }
+    return 0;
+}
+
+//---------------------------------------------------------------------------
+K_ULONG ProfileTimer_GetMax( ProfileTimer_t *pstTimer_ )
+{
+    return pstTimer_->ulMax;
+}
+
+//---------------------------------------------------------------------------
+K_USHORT ProfileTimer_GetIterations( ProfileTimer_t *pstTimer_ )
+{
+    return pstTimer_->usIterations;
+}
+
 //---------------------------------------------------------------------------    
 K_ULONG ProfileTimer_GetAverage( ProfileTimer_t *pstTimer_ )
 {
@@ -0,0 +1,191 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   blockpool.h
+
+    \brief  Fixed-block memory pool
+
+    A block pool carves a caller-supplied buffer into equally-sized blocks,
+    which can be allocated and freed in constant time.  Free blocks are kept
+    on a singly-linked list threaded through the blocks themselves, so the
+    pool has no per-block overhead.
+
+    Threads may block (with an optional timeout) until a block is returned
+    to the pool.  Blocks may be freed - and allocated without blocking -
+    from interrupt context.
+*/
+
+#ifndef __BLOCKPOOL_H__
+#define __BLOCKPOOL_H__
+
+#include "mark3cfg.h"
+#include "kerneltypes.h"
+#include "ksemaphore.h"
+
+#if KERNEL_USE_BLOCKPOOL
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//---------------------------------------------------------------------------
+typedef struct
+{
+    Semaphore_t stSemaphore;    //!< Counts free blocks, used to block allocating threads
+
+    void *pvFreeList;           //!< Head of the free-block list
+
+    K_UCHAR *pucStart;          //!< First byte of the block storage
+    K_UCHAR *pucEnd;            //!< One past the last byte of the block storage
+
+    K_USHORT usBlockSize;       //!< Size of each block, in bytes
+    K_USHORT usBlocks;          //!< Number of blocks in the pool
+    K_USHORT usInUse;           //!< Number of blocks currently allocated
+    K_USHORT usHighWater;       //!< Maximum number of blocks ever allocated at once
+    K_USHORT usFailures;        //!< Number of allocations that returned no block
+} BlockPool_t;
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief BlockPool_Init
+ *
+ * Initialize a block pool from a static buffer.  The block size is rounded
+ * up to a multiple of the pointer size, and the buffer must be aligned to
+ * the pointer size.
+ *
+ * \param pstPool_          Pointer to the pool object
+ * \param pvBuffer_         Buffer from which blocks are carved
+ * \param usBufferSize_     Size of the buffer, in bytes
+ * \param usBlockSize_      Size of each block, in bytes
+ */
+void BlockPool_Init( BlockPool_t *pstPool_, void *pvBuffer_, K_USHORT usBufferSize_, K_USHORT usBlockSize_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief BlockPool_TryAlloc
+ *
+ * Allocate a block without blocking.  Safe to call from interrupt context.
+ *
+ * \param pstPool_          Pointer to the pool object
+ * \return                  Pointer to the block, or NULL if the pool is empty
+ */
+void *BlockPool_TryAlloc( BlockPool_t *pstPool_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief BlockPool_Alloc
+ *
+ * Allocate a block, blocking the calling thread until one is available.
+ *
+ * \param pstPool_          Pointer to the pool object
+ * \return                  Pointer to the block
+ */
+void *BlockPool_Alloc( BlockPool_t *pstPool_ );
+
+#if KERNEL_USE_TIMEOUTS
+//---------------------------------------------------------------------------
+/*!
+ * \brief BlockPool_TimedAlloc
+ *
+ * Allocate a block, blocking the calling thread for up to the specified
+ * time until one is available.
+ *
+ * \param pstPool_          Pointer to the pool object
+ * \param ulTimeoutMS_      Maximum time to wait, in ms
+ * \return                  Pointer to the block, or NULL on timeout
+ */
+void *BlockPool_TimedAlloc( BlockPool_t *pstPool_, K_ULONG ulTimeoutMS_ );
+#endif
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief BlockPool_Free
+ *
+ * Return a block to the pool, waking the highest-priority thread waiting
+ * for a block.  Safe to call from interrupt context.  Freeing more blocks
+ * than are allocated triggers a kernel assert, and the pool is left as it
+ * was.
+ *
+ * \param pstPool_          Pointer to the pool the block was allocated from
+ * \param pvBlock_          Block to free
+ */
+void BlockPool_Free( BlockPool_t *pstPool_, void *pvBlock_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief BlockPool_GetBlockSize
+ *
+ * \param pstPool_          Pointer to the pool object
+ * \return                  Usable size of each block, in bytes
+ */
+K_USHORT BlockPool_GetBlockSize( BlockPool_t *pstPool_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief BlockPool_GetFree
+ *
+ * \param pstPool_          Pointer to the pool object
+ * \return                  Number of blocks available for allocation
+ */
+K_USHORT BlockPool_GetFree( BlockPool_t *pstPool_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief BlockPool_GetInUse
+ *
+ * \param pstPool_          Pointer to the pool object
+ * \return                  Number of blocks currently allocated
+ */
+K_USHORT BlockPool_GetInUse( BlockPool_t *pstPool_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief BlockPool_GetHighWater
+ *
+ * \param pstPool_          Pointer to the pool object
+ * \return                  Maximum number of blocks allocated at once since
+ *                          initialization or the last reset
+ */
+K_USHORT BlockPool_GetHighWater( BlockPool_t *pstPool_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief BlockPool_GetFailures
+ *
+ * \param pstPool_          Pointer to the pool object
+ * \return                  Number of allocations that failed or timed out
+ *                          since initialization or the last reset
+ */
+K_USHORT BlockPool_GetFailures( BlockPool_t *pstPool_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief BlockPool_ResetStats
+ *
+ * Start a new measurement window for sizing the pool.  The failure count
+ * is cleared, and the high-water mark restarts from the number of blocks
+ * that are still allocated, since those remain in use in the new window.
+ *
+ * \param pstPool_          Pointer to the pool object
+ */
+void BlockPool_ResetStats( BlockPool_t *pstPool_ );
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif // KERNEL_USE_BLOCKPOOL
+
+#endif // __BLOCKPOOL_H__
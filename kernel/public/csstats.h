@@ -0,0 +1,144 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   csstats.h
+
+    \brief  Critical section (interrupts-off time) instrumentation
+
+    When KERNEL_USE_CS_STATS is enabled, the ports' CS_ENTER() and CS_EXIT()
+    macros time every interval during which a critical section holds
+    interrupts off.  The longest interval is kept, along with the file and
+    line of the CS_ENTER() that started it, as well as a histogram of all
+    of the intervals.  The worst case sets the worst-case interrupt
+    response time of the system, so this is where to look first when it's
+    too long.
+
+    Locations are reported the same way as kernel trace messages - the
+    __FILE_ID__ from debugtokens.h, and __LINE__.  Code outside of the
+    kernel that doesn't define its own __FILE_ID__ reports the default from
+    kerneldebug.h.
+
+    \code
+        CSStats_t stStats;
+
+        CSStats_Reset();
+        Thread_Sleep(1000);
+        CSStats_Get( &stStats );
+        // stStats.ulMaxUs, at line stStats.usMaxLine of
+        // file stStats.usMaxFile
+    \endcode
+
+    Only the outermost critical section of a nest is timed; on AVR, so are
+    none of the critical sections entered from an interrupt, which already
+    runs with interrupts off.  Intervals are measured with the kernel timer,
+    so are only accurate up to a kernel timer period (1ms with a fixed
+    tick) - anything longer is a bug in its own right.
+
+    The instrumentation adds two function calls and a timer read to each
+    outermost critical section, so it's meant for development builds.
+*/
+
+#ifndef __CSSTATS_H__
+#define __CSSTATS_H__
+
+#include "kerneltypes.h"
+#include "mark3cfg.h"
+#include "debugtokens.h"
+
+#if KERNEL_USE_CS_STATS
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//---------------------------------------------------------------------------
+// CS_ENTER() is used by code that doesn't include kerneldebug.h, so give it
+// the same default file ID - defined identically, so that either header
+// can come first.
+#if !defined(__FILE_ID__)
+    #if KERNEL_USE_DEBUG
+        #define __FILE_ID__     STR_UNDEFINED
+    #else
+        #define __FILE_ID__     0
+    #endif
+#endif
+
+//---------------------------------------------------------------------------
+//! Number of histogram buckets.  Bucket n counts intervals of 2^n to
+//! 2^(n+1) - 1 microseconds (bucket 0 also counts 0us), with the last
+//! bucket counting everything longer.
+#define CS_STATS_HISTOGRAM_BUCKETS  (12)
+
+//---------------------------------------------------------------------------
+/*!
+    Snapshot of the critical section statistics
+*/
+typedef struct
+{
+    K_ULONG ulMaxUs;        //!< Longest interval with interrupts off, in microseconds
+    K_USHORT usMaxFile;     //!< __FILE_ID__ of the CS_ENTER() that started it
+    K_USHORT usMaxLine;     //!< __LINE__ of the CS_ENTER() that started it
+    K_ULONG ulCount;        //!< Number of intervals timed
+
+    //! Count of intervals in each bucket, saturating at 65535
+    K_USHORT ausHistogram[ CS_STATS_HISTOGRAM_BUCKETS ];
+} CSStats_t;
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief CSStats_Enter
+ *
+ * Start timing an interval.  Called by CS_ENTER() once interrupts are
+ * disabled - not for use by applications.
+ *
+ * \param usFile_ __FILE_ID__ of the caller
+ * \param usLine_ __LINE__ of the caller
+ */
+void CSStats_Enter( K_USHORT usFile_, K_USHORT usLine_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief CSStats_Exit
+ *
+ * Finish timing an interval.  Called by CS_EXIT() before interrupts are
+ * enabled - not for use by applications.
+ */
+void CSStats_Exit( void );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief CSStats_Get
+ *
+ * Take a consistent snapshot of the statistics.
+ *
+ * \param pstStats_ Structure to copy the statistics into
+ */
+void CSStats_Get( CSStats_t *pstStats_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief CSStats_Reset
+ *
+ * Clear the longest interval, count and histogram.
+ */
+void CSStats_Reset( void );
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif // KERNEL_USE_CS_STATS
+
+#endif // __CSSTATS_H__
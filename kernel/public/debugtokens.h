@@ -44,6 +44,15 @@ See license.txt for more information
 #define KPROFILE_C		0x0010		/* SUBSTITUTE="kernelprofile.c" */
 #define THREADPORT_C	0x0011		/* SUBSTITUTE="threadport.c" */
 #define TIMER_C         0x0012      /* SUBSTITUTE="timer.c" */
+#define PRIOMAP_C       0x0013      /* SUBSTITUTE="priomap.c" */
+#define RINGBUFFER_C    0x0014      /* SUBSTITUTE="ringbuffer.c" */
+#define BLOCKPOOL_C     0x0015      /* SUBSTITUTE="blockpool.c" */
+#define MULTIWAIT_C     0x0016      /* SUBSTITUTE="multiwait.c" */
+#define DPC_C           0x0017      /* SUBSTITUTE="dpc.c" */
+#define THREADSTATS_C   0x0018      /* SUBSTITUTE="threadstats.c" */
+#define EVENTTRACE_C    0x0019      /* SUBSTITUTE="eventtrace.c" */
+#define SAMPLEPROFILER_C 0x001A     /* SUBSTITUTE="sampleprofiler.c" */
+#define CSSTATS_C       0x001B      /* SUBSTITUTE="csstats.c" */
 
 //---------------------------------------------------------------------------
 /*! Header file names start at 0x1000 */
@@ -89,7 +98,7 @@ See license.txt for more information
 #define STR_MUTEX_CLAIM_1		0x200F		/* SUBSTITUTE="Mutex_t Claim: %1" */
 #define STR_MUTEX_RELEASE_1		0x2010		/* SUBSTITUTE="Mutex_t Release: %1" */
 #define STR_THREAD_BLOCK_1		0x2011		/* SUBSTITUTE="Thread_t %1 Blocked" */
-#define STR_THREAD_UNBLOCK_1	0x2012-2015		/* SUBSTITUTE="Thread_t %1 Unblocked" */
+#define STR_THREAD_UNBLOCK_1	0x2012		/* SUBSTITUTE="Thread_t %1 Unblocked" */
 #define STR_ASSERT_FAILED		0x2013		/* SUBSTITUTE="Assertion Failed" */
 #define STR_SCHEDULE_1			0x2014		/* SUBSTITUTE="Scheduler chose %1" */
 #define STR_THREAD_START_1		0x2015		/* SUBSTITUTE="Thread_t Start: %1" */
@@ -0,0 +1,153 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   dpc.h
+
+    \brief  Deferred procedure calls
+
+    A deferred procedure call (DPC) moves work out of interrupt context.
+    An interrupt handler - or a timer callback - queues a DPC in constant
+    time, and the callback is run later by a kernel service thread at
+    DPC_THREAD_PRIORITY, with interrupts enabled.  This keeps interrupt
+    handlers short regardless of how much work they trigger.
+
+    DPCs are run in the order they were queued.  A DPC that is queued again
+    before it has run is only run once.
+
+    \code
+        static Dpc_t stRxDpc;
+
+        static void RxWork( void *pvData_ )
+        {
+            // Runs in the DPC thread - may take as long as it needs, and
+            // may use any thread-safe kernel API
+        }
+
+        ISR(USART_RX_vect)
+        {
+            // Acknowledge the hardware, then defer the rest
+            Dpc_Queue( &stRxDpc );
+        }
+
+        void App_Init( void )
+        {
+            Dpc_Init( &stRxDpc, RxWork, NULL );
+        }
+    \endcode
+
+    Timers can defer their expiry handling by using Dpc_TimerCallback as
+    their callback, passing the DPC as the callback data:
+
+    \code
+        Timer_Start( &stPollTimer, true, 10, Dpc_TimerCallback, (void*)&stPollDpc );
+    \endcode
+*/
+
+#ifndef __DPC_H__
+#define __DPC_H__
+
+#include "kerneltypes.h"
+#include "mark3cfg.h"
+
+#if KERNEL_USE_DPC
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//---------------------------------------------------------------------------
+/*!
+    Function type used for deferred procedure calls
+*/
+typedef void (*DpcCallback_t)( void *pvData_ );
+
+//---------------------------------------------------------------------------
+/*!
+    Deferred procedure call object.  Owned by the caller, and linked into
+    the DPC queue while it is waiting to run.
+*/
+typedef struct _Dpc
+{
+    struct _Dpc *pstNext;       //!< Next DPC in the queue
+    DpcCallback_t pfCallback;   //!< Function to run
+    void *pvData;               //!< Argument passed to the function
+    K_BOOL bQueued;             //!< Whether the DPC is waiting to run
+} Dpc_t;
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief DpcQueue_Init
+ *
+ * Initialize the DPC queue and start the DPC thread.  Called by
+ * Kernel_Init() - not for use by applications.
+ */
+void DpcQueue_Init( void );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief Dpc_Init
+ *
+ * Initialize a DPC object.
+ *
+ * \param pstDpc_       Pointer to the DPC object
+ * \param pfCallback_   Function to run when the DPC is processed
+ * \param pvData_       Argument passed to the function
+ */
+void Dpc_Init( Dpc_t *pstDpc_, DpcCallback_t pfCallback_, void *pvData_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief Dpc_Queue
+ *
+ * Queue a DPC to be run by the DPC thread.  Runs in constant time, and is
+ * safe to call from interrupt context.
+ *
+ * \param pstDpc_       Pointer to the DPC object
+ * \return              true if the DPC was queued, false if it was already
+ *                      waiting to run
+ */
+K_BOOL Dpc_Queue( Dpc_t *pstDpc_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief Dpc_IsQueued
+ *
+ * \param pstDpc_       Pointer to the DPC object
+ * \return              true if the DPC is waiting to run
+ */
+#define Dpc_IsQueued( pstDpc_ )     ( ((Dpc_t*)pstDpc_)->bQueued )
+
+#if KERNEL_USE_TIMERS
+//---------------------------------------------------------------------------
+/*!
+ * \brief Dpc_TimerCallback
+ *
+ * Timer callback which queues the DPC passed as the timer's data, so that
+ * the timer's work is done in the DPC thread rather than in the timer
+ * interrupt.
+ *
+ * \param pstOwner_     Thread that owns the timer (unused)
+ * \param pvData_       Pointer to the DPC to queue
+ */
+void Dpc_TimerCallback( Thread_t *pstOwner_, void *pvData_ );
+#endif
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif // KERNEL_USE_DPC
+
+#endif // __DPC_H__
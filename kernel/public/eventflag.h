@@ -37,22 +37,41 @@ See license.txt for more information
  * Mutex_t, commonly used for synchronizing thread execution based on events
  * occurring within the system.
  *
- * Each EventFlag_t object contains a 16-bit bitmask, which is used to trigger
- * events on associated threads.  Threads wishing to block, waiting for
- * a specific event to occur can wait on any pattern within this 16-bit bitmask
- * to be set.  Here, we provide the ability for a thread to block, waiting
- * for ANY bits in a specified mask to be set, or for ALL bits within a
- * specific mask to be set.  Depending on how the object is configured, the
- * bits that triggered the wakeup can be automatically cleared once a match
- * has occurred.
+ * Each EventFlag_t object contains a 16 or 32-bit bitmask (depending on
+ * KERNEL_EVENTFLAG_BITS), which is used to trigger events on associated
+ * threads.  Threads wishing to block, waiting for a specific event to occur
+ * can wait on any pattern within this bitmask to be set.  Here, we provide
+ * the ability for a thread to block, waiting for ANY bits in a specified
+ * mask to be set, or for ALL bits within a specific mask to be set.
+ * Depending on how the object is configured, the bits that triggered the
+ * wakeup can be automatically cleared once a match has occurred.
  *
+ * With KERNEL_USE_EVENTFLAG_INDEX, blocked threads are indexed by bit:
+ * - A thread waiting for ALL of its bits is kept on the list of one bit in
+ *   its mask that is not yet set, and is only examined when that bit is set.
+ * - A thread waiting for ANY of a single bit is kept on that bit's list.
+ * - A thread waiting for ANY of several bits is kept on the object's main
+ *   list, which is only walked when one of its waiters' bits is set.
+ * Setting flags therefore only visits the threads that care about the bits
+ * being set, regardless of the total number of blocked threads.
  */
 typedef struct  
 {
 	// Inherit from BlockingObject -- must go first
     ThreadList_t stList;
 	
-    K_USHORT usSetMask;       //!< Event flags currently set in this object
+    K_FLAG_MASK tSetMask;       //!< Event flags currently set in this object
+
+#if KERNEL_USE_MULTIWAIT
+    struct _MultiWaitEntry *pstMultiWait;   //!< Multi-waits to signal when flags are set
+#endif
+
+#if KERNEL_USE_EVENTFLAG_INDEX
+    K_FLAG_MASK tAnyMask;       //!< Bits waited on by threads in stList (may be stale-high)
+
+    //! Threads blocked on each bit of the mask
+    ThreadList_t astIndex[KERNEL_EVENTFLAG_BITS];
+#endif
 } EventFlag_t;
 
 /*!
@@ -62,23 +81,23 @@ void EventFlag_Init( EventFlag_t *pstFlag_ );
 
 /*!
     * \brief Wait - Block a thread on the specific flags in this event flag group
-    * \param usMask_ - 16-bit bitmask to block on
+    * \param tMask_ - Bitmask to block on
     * \param eMode_ - EVENT_FLAG_ANY:  Thread_t will block on any of the bits in the mask
     *               - EVENT_FLAG_ALL:  Thread_t will block on all of the bits in the mask
     * \return Bitmask condition that caused the thread to unblock, or 0 on error or timeout
     */
-K_USHORT EventFlag_Wait( EventFlag_t *pstFlag_, K_USHORT usMask_, EventFlagOperation_t eMode_);
+K_FLAG_MASK EventFlag_Wait( EventFlag_t *pstFlag_, K_FLAG_MASK tMask_, EventFlagOperation_t eMode_);
 
 #if KERNEL_USE_TIMEOUTS
 /*!
     * \brief Wait - Block a thread on the specific flags in this event flag group
-    * \param usMask_ - 16-bit bitmask to block on
+    * \param tMask_ - Bitmask to block on
     * \param eMode_ - EVENT_FLAG_ANY:  Thread_t will block on any of the bits in the mask
     *               - EVENT_FLAG_ALL:  Thread_t will block on all of the bits in the mask
     * \param ulTimeMS_ - Time to block (in ms)
     * \return Bitmask condition that caused the thread to unblock, or 0 on error or timeout
     */
-K_USHORT EventFlag_TimedWait( EventFlag_t *pstFlag_, K_USHORT usMask_, EventFlagOperation_t eMode_, K_ULONG ulTimeMS_);
+K_FLAG_MASK EventFlag_TimedWait( EventFlag_t *pstFlag_, K_FLAG_MASK tMask_, EventFlagOperation_t eMode_, K_ULONG ulTimeMS_);
 
 
 #endif
@@ -86,21 +105,21 @@ K_USHORT EventFlag_TimedWait( EventFlag_t *pstFlag_, K_USHORT usMask_, EventFlag
 /*!
     * \brief Set - Set additional flags in this object (logical OR).  This API can potentially
     *              result in threads blocked on Wait() to be unblocked.
-    * \param usMask_ - Bitmask of flags to set.
+    * \param tMask_ - Bitmask of flags to set.
     */
-void EventFlag_Set( EventFlag_t *pstFlag_, K_USHORT usMask_);
+void EventFlag_Set( EventFlag_t *pstFlag_, K_FLAG_MASK tMask_);
 
 /*!
     * \brief ClearFlags - Clear a specific set of flags within this object, specific by bitmask
-    * \param usMask_ - Bitmask of flags to clear
+    * \param tMask_ - Bitmask of flags to clear
     */
-void EventFlag_Clear( EventFlag_t *pstFlag_, K_USHORT usMask_);
+void EventFlag_Clear( EventFlag_t *pstFlag_, K_FLAG_MASK tMask_);
 
 /*!
-    * \brief GetMask Returns the state of the 16-bit bitmask within this object
-    * \return The state of the 16-bit bitmask
+    * \brief GetMask Returns the state of the bitmask within this object
+    * \return The state of the bitmask
     */
-K_USHORT EventFlag_GetMask( EventFlag_t *pstFlag_ );
+K_FLAG_MASK EventFlag_GetMask( EventFlag_t *pstFlag_ );
 
 #ifdef __cplusplus
     }
@@ -0,0 +1,214 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   eventtrace.h
+
+    \brief  Timestamped scheduling event trace
+
+    When KERNEL_USE_EVENT_TRACE is enabled, the kernel records context
+    switches, threads blocking and unblocking, interrupt entry and exit, and
+    timer expiries into a RAM ring buffer.  Each event is a fixed 4-word
+    record:
+
+    \code
+        [0] (event << 8) | id       - id is a thread ID, ISR ID or user code
+        [1] timestamp, bits 0-15    - microseconds, from Kernel_GetTime()
+        [2] timestamp, bits 16-31
+        [3] argument                - event-specific, see EventTraceType_t
+    \endcode
+
+    Records are handed to the callback set with EventTrace_SetCallback() in
+    half-buffer chunks, as the buffer fills.  The callback runs in the
+    context of whatever generated the event - often an interrupt, or the
+    context switch itself - so it should only copy the data out, or hand
+    it to a driver.  scripts/trace2json.py converts a captured stream of
+    records into Chrome trace JSON, for viewing in Perfetto or
+    chrome://tracing.
+
+    \code
+        static void TraceOut( K_USHORT *pusData_, K_USHORT usSize_ )
+        {
+            Driver_Write( pstUART, usSize_ * 2, (K_UCHAR*)pusData_ );
+        }
+
+        EventTrace_SetCallback( TraceOut );
+        EventTrace_Enable( true );
+        ...
+        EventTrace_Enable( false );
+        EventTrace_Flush();
+    \endcode
+*/
+
+#ifndef __EVENTTRACE_H__
+#define __EVENTTRACE_H__
+
+#include "kerneltypes.h"
+#include "mark3cfg.h"
+#include "writebuf16.h"
+
+#if KERNEL_USE_EVENT_TRACE
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//---------------------------------------------------------------------------
+#define EVENT_TRACE_RECORD_SIZE     (4)     //!< Size of a record, in 16-bit words
+
+//! Size of the trace buffer in 16-bit words.  Must be a multiple of twice
+//! the record size, so that records never straddle the two halves.
+#define EVENT_TRACE_BUFFER_SIZE     (16 * EVENT_TRACE_RECORD_SIZE)
+
+#define EVENT_TRACE_ISR_KERNEL_TIMER (0)    //!< ISR ID of the kernel timer
+#define EVENT_TRACE_NO_THREAD       (0xFE)  //!< ID used for "no thread"
+
+//---------------------------------------------------------------------------
+/*!
+    Event types, stored in the top byte of each record
+*/
+typedef enum
+{
+    EVENT_TRACE_SWITCH = 1,     //!< id = next thread, arg = (next priority << 8) | previous thread
+    EVENT_TRACE_BLOCK,          //!< id = thread, arg = low 16 bits of the blocking object's address
+    EVENT_TRACE_UNBLOCK,        //!< id = thread, arg = low 16 bits of the blocking object's address
+    EVENT_TRACE_ISR_ENTER,      //!< id = ISR ID, arg = 0
+    EVENT_TRACE_ISR_EXIT,       //!< id = ISR ID, arg = 0
+    EVENT_TRACE_TIMER,          //!< id = timer's owner thread, arg = low 16 bits of the timer's address
+    EVENT_TRACE_USER,           //!< id = user code, arg = user data
+//--
+    EVENT_TRACE_EVENTS
+} EventTraceType_t;
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief EventTrace_Init
+ *
+ * Initialize the trace buffer.  Called by Kernel_Init() - not for use by
+ * applications.  Tracing starts out disabled.
+ */
+void EventTrace_Init( void );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief EventTrace_SetCallback
+ *
+ * Set the function that drains the trace buffer.  Called with each half of
+ * the buffer as it fills.
+ *
+ * \param pfCallback_ Callback to assign
+ */
+void EventTrace_SetCallback( WriteBufferCallback pfCallback_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief EventTrace_Enable
+ *
+ * Start or stop recording events.  Allows a trace to be captured around a
+ * particular window of interest.
+ *
+ * \param bEnable_ true to record events, false to stop
+ */
+void EventTrace_Enable( K_BOOL bEnable_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief EventTrace_Flush
+ *
+ * Hand any records not yet passed to the callback over now, rather than
+ * waiting for the current half of the buffer to fill.  Call after
+ * disabling the trace, to collect the end of a capture.
+ */
+void EventTrace_Flush( void );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief EventTrace_Switch
+ *
+ * Record a context switch from the current thread to the next.  Called by
+ * the port with interrupts disabled - not for use by applications.
+ */
+void EventTrace_Switch( void );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief EventTrace_Block
+ *
+ * Record a thread blocking on an object.
+ *
+ * \param pstThread_ Thread that is blocking
+ * \param pvObject_  Object the thread is blocking on
+ */
+void EventTrace_Block( Thread_t *pstThread_, void *pvObject_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief EventTrace_UnBlock
+ *
+ * Record a thread being released from an object.
+ *
+ * \param pstThread_ Thread that is being unblocked
+ * \param pvObject_  Object the thread was blocked on
+ */
+void EventTrace_UnBlock( Thread_t *pstThread_, void *pvObject_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief EventTrace_IsrEnter
+ *
+ * Record entry into an interrupt handler.  Called by the kernel timer
+ * ISR; application ISRs may call it with their own IDs.
+ *
+ * \param ucIsr_ ID of the interrupt
+ */
+void EventTrace_IsrEnter( K_UCHAR ucIsr_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief EventTrace_IsrExit
+ *
+ * Record exit from an interrupt handler.
+ *
+ * \param ucIsr_ ID of the interrupt
+ */
+void EventTrace_IsrExit( K_UCHAR ucIsr_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief EventTrace_Timer
+ *
+ * Record a timer expiring, immediately before its callback is run.
+ *
+ * \param pstTimer_ Timer that expired
+ */
+void EventTrace_Timer( Timer_t *pstTimer_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief EventTrace_User
+ *
+ * Record an application-defined marker.
+ *
+ * \param ucCode_ Application-defined event code
+ * \param usArg_  Application-defined data
+ */
+void EventTrace_User( K_UCHAR ucCode_, K_USHORT usArg_ );
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif // KERNEL_USE_EVENT_TRACE
+
+#endif // __EVENTTRACE_H__
@@ -102,6 +102,22 @@ K_BOOL Kernel_IsPanic( void );
     */
 void Kernel_Panic(K_USHORT usCause_);
 
+#if KERNEL_USE_TIMERS
+/*!
+    * \brief GetTime Return the time since the kernel was initialized, in
+    *        microseconds.  The value is monotonic and won't wrap within
+    *        the life of the system.  It combines the time at the last
+    *        kernel timer interrupt with the hardware timer's count, so its
+    *        resolution is that of the timer - 4us (tick-based) or 16us
+    *        (tickless) on AVR, and 1us on Cortex-M0.
+    *
+    *        Cheap enough to call from interrupt context or trace hooks.
+    *
+    * \return Current time, in microseconds
+    */
+K_ULONGLONG Kernel_GetTime( void );
+#endif
+
 #if KERNEL_USE_IDLE_FUNC
 /*!
     * \brief SetIdleFunc Set the function to be called when no active threads
@@ -110,6 +126,13 @@ void Kernel_Panic(K_USHORT usCause_);
     */
 void Kernel_SetIdleFunc( idle_func_t pfIdle_ );
 
+/*!
+    * \brief GetIdleFunc Return the function set by Kernel_SetIdleFunc(), so
+    *        that it can be restored after being replaced temporarily.
+    * \return Pointer to the idle function, or 0 if none is set
+    */
+idle_func_t Kernel_GetIdleFunc( void );
+
 /*!
     * \brief IdleFunc Call the low-priority idle function when no active
     *        threads are available to be scheduled.
@@ -26,6 +26,38 @@ See license.txt for more information
 #include "kernelaware.h"
 #include "paniccodes.h"
 #include "kernel.h"
+//---------------------------------------------------------------------------
+/*!
+    Trace severity levels.  Each kernel trace point has one, and is only
+    recorded if that level is enabled in its module's trace mask.
+*/
+#define TRACE_LEVEL_VERBOSE     (0x01)  //!< Hot-path events - scheduling, blocking, object operations
+#define TRACE_LEVEL_INFO        (0x02)  //!< Object lifecycle - kernel init, thread creation and exit
+#define TRACE_LEVEL_WARN        (0x04)  //!< Unexpected, but recoverable conditions
+#define TRACE_LEVEL_ERROR       (0x08)  //!< Errors
+#define TRACE_LEVEL_ALL         (0x0F)  //!< All of the above
+#define TRACE_LEVEL_NONE        (0x00)  //!< Module disabled
+
+//---------------------------------------------------------------------------
+#if KERNEL_USE_DEBUG
+
+//! Number of trace modules - source file IDs from debugtokens.h index the
+//! trace masks, with anything out of range sharing module 0.
+#define TRACE_MODULES           (32)
+
+//! Trace mask index for a file ID.  Resolved at compile time.
+#define TRACE_MODULE( id )      ((((K_USHORT)(id)) < TRACE_MODULES) ? (id) : 0)
+
+//! Per-module masks of the enabled trace levels.  See TraceBuffer_SetMask().
+extern volatile K_UCHAR g_aucTraceMask[ TRACE_MODULES ];
+
+//! Whether a trace level is enabled for the current file - a single load
+//! and branch, taken before any of the trace record is built.
+#define KERNEL_TRACE_ON( level ) \
+    (g_aucTraceMask[ TRACE_MODULE( __FILE_ID__ ) ] & (level))
+
+#endif
+
 //---------------------------------------------------------------------------
 #if (KERNEL_USE_DEBUG && !KERNEL_AWARE_SIMULATION)
 
@@ -33,42 +65,51 @@ See license.txt for more information
 #define __FILE_ID__			STR_UNDEFINED        //!< File ID used in kernel trace calls
 
 //---------------------------------------------------------------------------
-#define KERNEL_TRACE( x )	\
-{ 	\
-	K_USHORT ausMsg__[5]; \
-	ausMsg__[0] = 0xACDC;  \
-	ausMsg__[1] = __FILE_ID__; \
-	ausMsg__[2] = __LINE__; \
-    ausMsg__[3] = TraceBuffer_Increment() ; \
-	ausMsg__[4] = (K_USHORT)(x) ; \
-    TraceBuffer_Write(ausMsg__, 5); \
+#define KERNEL_TRACE( level, x )	\
+{ \
+    if (KERNEL_TRACE_ON( level )) \
+    { \
+        K_USHORT ausMsg__[5]; \
+        ausMsg__[0] = 0xACDC;  \
+        ausMsg__[1] = __FILE_ID__; \
+        ausMsg__[2] = __LINE__; \
+        ausMsg__[3] = TraceBuffer_Increment() ; \
+        ausMsg__[4] = (K_USHORT)(x) ; \
+        TraceBuffer_Write(ausMsg__, 5); \
+    } \
 };
 
 //---------------------------------------------------------------------------
-#define KERNEL_TRACE_1( x, arg1 ) \
-{ 	\
-	K_USHORT ausMsg__[6]; \
-	ausMsg__[0] = 0xACDC;  \
-	ausMsg__[1] = __FILE_ID__; \
-	ausMsg__[2] = __LINE__; \
-    ausMsg__[3] = TraceBuffer_Increment(); \
-	ausMsg__[4] = (K_USHORT)(x); \
-	ausMsg__[5] = arg1; \
-    TraceBuffer_Write(ausMsg__, 6); \
+#define KERNEL_TRACE_1( level, x, arg1 ) \
+{ \
+    if (KERNEL_TRACE_ON( level )) \
+    { \
+        K_USHORT ausMsg__[6]; \
+        ausMsg__[0] = 0xACDC;  \
+        ausMsg__[1] = __FILE_ID__; \
+        ausMsg__[2] = __LINE__; \
+        ausMsg__[3] = TraceBuffer_Increment(); \
+        ausMsg__[4] = (K_USHORT)(x); \
+        ausMsg__[5] = arg1; \
+        TraceBuffer_Write(ausMsg__, 6); \
+    } \
 }
 
 //---------------------------------------------------------------------------
-#define KERNEL_TRACE_2( x, arg1, arg2 ) \
-{ 	\
-	K_USHORT ausMsg__[7]; \
-	ausMsg__[0] = 0xACDC;  \
-	ausMsg__[1] = __FILE_ID__; \
-	ausMsg__[2] = __LINE__; \
-    ausMsg__[3] = TraceBuffer_Increment(); \
-	ausMsg__[4] = (K_USHORT)(x); \
-	ausMsg__[5] = arg1; \
-	ausMsg__[6] = arg2; \
-    TraceBuffer_Write(ausMsg__, 7); \
+#define KERNEL_TRACE_2( level, x, arg1, arg2 ) \
+{ \
+    if (KERNEL_TRACE_ON( level )) \
+    { \
+        K_USHORT ausMsg__[7]; \
+        ausMsg__[0] = 0xACDC;  \
+        ausMsg__[1] = __FILE_ID__; \
+        ausMsg__[2] = __LINE__; \
+        ausMsg__[3] = TraceBuffer_Increment(); \
+        ausMsg__[4] = (K_USHORT)(x); \
+        ausMsg__[5] = arg1; \
+        ausMsg__[6] = arg2; \
+        TraceBuffer_Write(ausMsg__, 7); \
+    } \
 }
 
 //---------------------------------------------------------------------------
@@ -92,21 +133,30 @@ See license.txt for more information
 #define __FILE_ID__			STR_UNDEFINED
 
 //---------------------------------------------------------------------------
-#define KERNEL_TRACE( x )	\
-{ 	\
-    KernelAware_Trace( __FILE_ID__, __LINE__, x ); \
+#define KERNEL_TRACE( level, x )	\
+{ \
+    if (KERNEL_TRACE_ON( level )) \
+    { \
+        KernelAware_Trace( __FILE_ID__, __LINE__, x ); \
+    } \
 };
 
 //---------------------------------------------------------------------------
-#define KERNEL_TRACE_1( x, arg1 ) \
-{ 	\
-    KernelAware_Trace1( __FILE_ID__, __LINE__, x, arg1 ); \
+#define KERNEL_TRACE_1( level, x, arg1 ) \
+{ \
+    if (KERNEL_TRACE_ON( level )) \
+    { \
+        KernelAware_Trace1( __FILE_ID__, __LINE__, x, arg1 ); \
+    } \
 }
 
 //---------------------------------------------------------------------------
-#define KERNEL_TRACE_2( x, arg1, arg2 ) \
-{ 	\
-    KernelAware_Trace2( __FILE_ID__, __LINE__, x, arg1, arg2 ); \
+#define KERNEL_TRACE_2( level, x, arg1, arg2 ) \
+{ \
+    if (KERNEL_TRACE_ON( level )) \
+    { \
+        KernelAware_Trace2( __FILE_ID__, __LINE__, x, arg1, arg2 ); \
+    } \
 }
 
 //---------------------------------------------------------------------------
@@ -127,11 +177,11 @@ See license.txt for more information
 //---------------------------------------------------------------------------
 #define __FILE_ID__			0           //!< Null ID
 //---------------------------------------------------------------------------
-#define KERNEL_TRACE( x )               //!< Null Kernel Trace Macro
+#define KERNEL_TRACE( level, x )               //!< Null Kernel Trace Macro
 //---------------------------------------------------------------------------
-#define KERNEL_TRACE_1( x, arg1 )       //!< Null Kernel Trace Macro
+#define KERNEL_TRACE_1( level, x, arg1 )       //!< Null Kernel Trace Macro
 //---------------------------------------------------------------------------
-#define KERNEL_TRACE_2( x, arg1, arg2 ) //!< Null Kernel Trace Macro
+#define KERNEL_TRACE_2( level, x, arg1, arg2 ) //!< Null Kernel Trace Macro
 //---------------------------------------------------------------------------
 #define KERNEL_ASSERT( x )              //!< Null Kernel Assert Macro
 
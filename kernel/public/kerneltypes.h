@@ -41,6 +41,7 @@ See license.txt for more information
 #define K_SHORT         int16_t             //!< The 16-bit signed integer type used by Mark3
 #define K_ULONG         uint32_t            //!< The 32-bit unsigned integer type used by Mark3
 #define K_LONG          int32_t             //!< The 32-bit signed integer type used by Mark3
+#define K_ULONGLONG     uint64_t            //!< The 64-bit unsigned integer type used by Mark3
 
 #if !defined(K_ADDR)
     #define K_ADDR      uint16_t            //!< Primative datatype representing address-size
@@ -49,11 +50,19 @@ See license.txt for more information
     #define K_WORD      uint8_t            //!< Primative datatype representing a data word
 #endif
 
+#if KERNEL_EVENTFLAG_BITS == 32
+    #define K_FLAG_MASK     uint32_t        //!< Event-flag bitmask type
+#else
+    #define K_FLAG_MASK     uint16_t        //!< Event-flag bitmask type
+#endif
+
 //---------------------------------------------------------------------------
 // Forward declarations
 struct _Thread;
 struct _ThreadList;
 struct _Timer;
+struct _PriorityMap;
+struct _MultiWaitEntry;
 
 //---------------------------------------------------------------------------
 /*!
@@ -77,6 +86,32 @@ typedef enum
     EVENT_FLAG_PENDING_UNBLOCK  //!< Special code.  Not used by user
 } EventFlagOperation_t;
 
+//---------------------------------------------------------------------------
+/*!
+ * This enumeration describes the ways in which a thread notification
+ * updates the target thread's notification value.
+ */
+typedef enum
+{
+    NOTIFY_ACTION_NONE,         //!< Leave the value unchanged, just signal the thread
+    NOTIFY_ACTION_SET_BITS,     //!< Bitwise-OR the supplied value into the thread's value
+    NOTIFY_ACTION_INCREMENT,    //!< Increment the thread's value, ignoring the supplied value
+    NOTIFY_ACTION_OVERWRITE,    //!< Replace the thread's value with the supplied value
+//---
+    NOTIFY_ACTIONS              //!< Count of notification actions.  Not used by user
+} NotifyAction_t;
+
+//---------------------------------------------------------------------------
+/*!
+ * Run-time statistics kept for each thread when KERNEL_USE_THREAD_STATS
+ * is enabled.
+ */
+typedef struct
+{
+    K_ULONGLONG ullRunTime;     //!< Time spent running, in microseconds
+    K_ULONG     ulSwitches;     //!< Number of times the thread was switched in
+} ThreadStats_t;
+
 //---------------------------------------------------------------------------
 /*!
     This object is used for building thread-management facilities, such as 
@@ -90,8 +125,56 @@ struct _ThreadList
     //! Priority of the threadlist
     K_UCHAR ucPriority;
 
-    //! Pointer to the bitmap/flag to set when used for scheduling.
-    K_UCHAR *pucFlag;
+    //! Pointer to the priority map to update when used for scheduling.
+    struct _PriorityMap *pstMap;
+};
+
+//---------------------------------------------------------------------------
+/*!
+ * Word type used to hold priority bitmaps.  This matches the native word
+ * size of the target, so that the highest-priority search operates on one
+ * machine word at a time.
+ */
+#if defined(AVR)
+    #define PRIO_TYPE               K_UCHAR     //!< Priority bitmap word type
+    #define PRIO_MAP_WORD_BITS      (8)         //!< Number of bits in PRIO_TYPE
+#else
+    #define PRIO_TYPE               K_ULONG     //!< Priority bitmap word type
+    #define PRIO_MAP_WORD_BITS      (32)        //!< Number of bits in PRIO_TYPE
+#endif
+
+//! Number of scheduler priority levels - the application's, plus the level
+//! reserved for the DPC thread, if enabled
+#define SCHED_NUM_PRIORITIES    (KERNEL_NUM_PRIORITIES + KERNEL_USE_DPC)
+
+#if (KERNEL_NUM_PRIORITIES < 1) || (SCHED_NUM_PRIORITIES > 64)
+    #error "KERNEL_NUM_PRIORITIES must be between 1 and 64 (63 with KERNEL_USE_DPC)"
+#endif
+
+//! Number of bitmap words required to track all scheduler priorities
+#define PRIO_MAP_WORDS      ((SCHED_NUM_PRIORITIES + PRIO_MAP_WORD_BITS - 1) / PRIO_MAP_WORD_BITS)
+
+#if PRIO_MAP_WORDS > 1
+    #define PRIO_MAP_MULTI_LEVEL    (1)         //!< Two-level bitmap required
+#else
+    #define PRIO_MAP_MULTI_LEVEL    (0)
+#endif
+
+//---------------------------------------------------------------------------
+/*!
+    Bitmap of priority levels that have ready threads, used by the scheduler
+    to find the highest ready priority in constant time.  When more priorities
+    are configured than fit in a single word, a second-level word records
+    which of the per-priority words are non-zero.
+*/
+struct _PriorityMap
+{
+    //! One bit per priority level, PRIO_MAP_WORD_BITS priorities per word
+    PRIO_TYPE atFlags[PRIO_MAP_WORDS];
+#if PRIO_MAP_MULTI_LEVEL
+    //! One bit per non-empty word in atFlags
+    PRIO_TYPE tWordMap;
+#endif
 };
 
 //---------------------------------------------------------------------------
@@ -210,7 +293,7 @@ struct _Thread
 
 #if KERNEL_USE_EVENTFLAG
     //! Event-flag mask
-    K_USHORT usFlagMask;
+    K_FLAG_MASK tFlagMask;
 
     //! Event-flag mode
     EventFlagOperation_t eFlagMode;
@@ -224,11 +307,33 @@ struct _Thread
     //! Indicate whether or not a blocking-object timeout has occurred
     K_BOOL	bExpired;
 #endif
+
+#if KERNEL_USE_MULTIWAIT
+    //! Entries linked onto their objects while the thread is multi-waiting
+    struct _MultiWaitEntry *pstMultiWait;
+
+    //! Number of entries in pstMultiWait
+    K_UCHAR ucMultiWaitCount;
+#endif
+
+#if KERNEL_USE_THREAD_NOTIFY
+    //! Notification value, updated by Thread_Notify()
+    K_ULONG ulNotifyValue;
+
+    //! Whether a notification is pending, or the thread is waiting for one
+    K_UCHAR ucNotifyState;
+#endif
+
+#if KERNEL_USE_THREAD_STATS
+    //! Run time and context switch counters
+    ThreadStats_t stStats;
+#endif
 };
 
 typedef struct _Thread Thread_t;
 typedef struct _Timer Timer_t;
 typedef struct _ThreadList ThreadList_t;
+typedef struct _PriorityMap PriorityMap_t;
 
 #ifdef __cplusplus
     }
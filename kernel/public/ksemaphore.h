@@ -45,6 +45,10 @@ typedef struct
 	
 	K_USHORT usValue;         //!< Current count held by the Semaphore_t
 	K_USHORT usMaxValue;      //!< Maximum count that can be held by this Semaphore_t
+
+#if KERNEL_USE_MULTIWAIT
+    struct _MultiWaitEntry *pstMultiWait;   //!< Multi-waits to signal when the count becomes non-zero
+#endif
 } Semaphore_t;
 
 //---------------------------------------------------------------------------
@@ -70,6 +74,34 @@ void Semaphore_Init( Semaphore_t *pstSe, K_USHORT usInitVal_, K_USHORT usMaxVal_
 */
 K_BOOL Semaphore_Post( Semaphore_t *pstSe );
 
+//---------------------------------------------------------------------------
+/*!
+    \fn K_USHORT PostN( K_USHORT usCount_ );
+
+    Increment the Semaphore_t count by up to the specified amount in a
+    single operation.  Waiting threads are woken first, one per count, and
+    any remaining count is added to the Semaphore_t value.  At most one
+    context switch results from the call, regardless of the number of
+    threads woken.
+
+    \param usCount_ Number of times to post the Semaphore_t
+    \return Number of posts performed.  This is less than usCount_ if the
+            maximum count of the Semaphore_t was reached.
+*/
+K_USHORT Semaphore_PostN( Semaphore_t *pstSe, K_USHORT usCount_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn K_USHORT TryPendN( K_USHORT usCount_ );
+
+    Decrement the Semaphore_t count by up to the specified amount, without
+    blocking.
+
+    \param usCount_ Maximum number of counts to take from the Semaphore_t
+    \return Number of counts actually taken, which may be zero.
+*/
+K_USHORT Semaphore_TryPendN( Semaphore_t *pstSe, K_USHORT usCount_ );
+
 //---------------------------------------------------------------------------
 /*!
     \fn void Pend();
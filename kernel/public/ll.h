@@ -169,6 +169,18 @@ void DoubleLinkList_Add( DoubleLinkList_t *pstList_, LinkListNode_t *node_ );
 */
 void DoubleLinkList_Remove( DoubleLinkList_t *pstList_, LinkListNode_t *node_ );
 
+//---------------------------------------------------------------------------
+/*!
+    \fn void InsertAfter(LinkListNode_t *node_, LinkListNode_t *pstPrev_)
+
+    Insert a node into the list immediately after an existing node.
+
+    \param node_ Pointer to the node to insert
+    \param pstPrev_ Pointer to the node in the list that the new node will
+                    follow, or NULL to insert the node at the head of the list
+*/
+void DoubleLinkList_InsertAfter( DoubleLinkList_t *pstList_, LinkListNode_t *node_, LinkListNode_t *pstPrev_ );
+
 //---------------------------------------------------------------------------
 /*!
     Circular-linked-list data type, inherited from the base LinkList_t type.
@@ -199,6 +211,18 @@ void CircularLinkList_Add( CircularLinkList_t *pstList_, LinkListNode_t *node_);
 */
 void CircularLinkList_Remove( CircularLinkList_t *pstList_, LinkListNode_t *node_);
 
+//---------------------------------------------------------------------------
+/*!
+    \fn void InsertAfter(LinkListNode_t *node_, LinkListNode_t *pstPrev_)
+
+    Insert a node into the list immediately after an existing node.
+
+    \param node_ Pointer to the node to insert
+    \param pstPrev_ Pointer to the node in the list that the new node will
+                    follow, or NULL to insert the node at the head of the list
+*/
+void CircularLinkList_InsertAfter( CircularLinkList_t *pstList_, LinkListNode_t *node_, LinkListNode_t *pstPrev_ );
+
 //---------------------------------------------------------------------------
 /*!
     \fn void PivotForward()
@@ -42,6 +42,11 @@ typedef struct
 
     Semaphore_t stRecvSem;      //!< Counting semaphore used to synchronize threads on the object
 
+    bool bSendSchedState;       //!< Scheduler state to restore on MailBox_Commit()
+    bool bRecvSchedState;       //!< Scheduler state to restore on MailBox_Release()
+    bool bSendReserved;         //!< A MailBox_Reserve() is awaiting MailBox_Commit()
+    bool bRecvReserved;         //!< A MailBox_Peek() is awaiting MailBox_Release()
+
 #if KERNEL_USE_TIMEOUTS
     Semaphore_t stSendSem;      //!< Binary semaphore for send-blocked threads.
 #endif
@@ -175,6 +180,228 @@ bool MailBox_TimedReceive( MailBox_t *pstMailBox_, void *pvData_, K_ULONG ulTime
 bool MailBox_TimedReceiveTail( MailBox_t *pstMailBox_, void *pvData_, K_ULONG ulTimeoutMS_ );
 #endif
 
+/*!
+ * \brief Reserve
+ *
+ * Claim a free slot at the head of the mailbox, returning a pointer directly
+ * into the mailbox buffer so that the envelope can be written in place,
+ * without a copy.  The envelope is not delivered until MailBox_Commit() is
+ * called.
+ *
+ * The scheduler is disabled between a successful reserve and the matching
+ * commit, so the slot must be filled quickly, and without calling any
+ * blocking APIs.  Only one slot per mailbox may be reserved at a time.
+ *
+ * \return Pointer to the reserved slot, or NULL if the mailbox is full.
+ */
+void *MailBox_Reserve( MailBox_t *pstMailBox_ );
+
+/*!
+ * \brief ReserveTail
+ *
+ * Claim a free slot at the tail of the mailbox.  See MailBox_Reserve().
+ *
+ * \return Pointer to the reserved slot, or NULL if the mailbox is full.
+ */
+void *MailBox_ReserveTail( MailBox_t *pstMailBox_ );
+
+#if KERNEL_USE_TIMEOUTS
+/*!
+ * \brief TimedReserve
+ *
+ * Claim a free slot at the head of the mailbox, waiting up to the specified
+ * time for one to become available.  See MailBox_Reserve().
+ *
+ * \param ulTimeoutMS_  Maximum time to wait for a free slot
+ * \return Pointer to the reserved slot, or NULL on timeout.
+ */
+void *MailBox_TimedReserve( MailBox_t *pstMailBox_, K_ULONG ulTimeoutMS_ );
+
+/*!
+ * \brief TimedReserveTail
+ *
+ * Claim a free slot at the tail of the mailbox, waiting up to the specified
+ * time for one to become available.  See MailBox_Reserve().
+ *
+ * \param ulTimeoutMS_  Maximum time to wait for a free slot
+ * \return Pointer to the reserved slot, or NULL on timeout.
+ */
+void *MailBox_TimedReserveTail( MailBox_t *pstMailBox_, K_ULONG ulTimeoutMS_ );
+#endif
+
+/*!
+ * \brief Commit
+ *
+ * Deliver the envelope written into a slot claimed by one of the
+ * MailBox_Reserve() calls, waking a thread blocked on receive.
+ */
+void MailBox_Commit( MailBox_t *pstMailBox_ );
+
+/*!
+ * \brief Peek
+ *
+ * Wait for an envelope at the head of the mailbox, and return a pointer to it
+ * directly within the mailbox buffer, so that it can be read in place without
+ * a copy.  The slot is not returned to the mailbox until MailBox_Release()
+ * is called.
+ *
+ * The scheduler is disabled between peek and release, so the envelope must
+ * be consumed quickly, and without calling any blocking APIs.  Only one
+ * envelope per mailbox may be peeked at a time.
+ *
+ * \return Pointer to the envelope
+ */
+void *MailBox_Peek( MailBox_t *pstMailBox_ );
+
+/*!
+ * \brief PeekTail
+ *
+ * Wait for an envelope at the tail of the mailbox.  See MailBox_Peek().
+ *
+ * \return Pointer to the envelope
+ */
+void *MailBox_PeekTail( MailBox_t *pstMailBox_ );
+
+#if KERNEL_USE_TIMEOUTS
+/*!
+ * \brief TimedPeek
+ *
+ * Wait up to the specified time for an envelope at the head of the mailbox.
+ * See MailBox_Peek().
+ *
+ * \param ulTimeoutMS_ Maximum time to wait for delivery.
+ * \return Pointer to the envelope, or NULL on timeout.
+ */
+void *MailBox_TimedPeek( MailBox_t *pstMailBox_, K_ULONG ulTimeoutMS_ );
+
+/*!
+ * \brief TimedPeekTail
+ *
+ * Wait up to the specified time for an envelope at the tail of the mailbox.
+ * See MailBox_Peek().
+ *
+ * \param ulTimeoutMS_ Maximum time to wait for delivery.
+ * \return Pointer to the envelope, or NULL on timeout.
+ */
+void *MailBox_TimedPeekTail( MailBox_t *pstMailBox_, K_ULONG ulTimeoutMS_ );
+#endif
+
+/*!
+ * \brief Release
+ *
+ * Return the slot of an envelope obtained from one of the MailBox_Peek()
+ * calls to the mailbox, waking a thread blocked on send.
+ */
+void MailBox_Release( MailBox_t *pstMailBox_ );
+
+/*!
+ * \brief SendN
+ *
+ * Send up to usCount_ envelopes from an array to the head of the mailbox, in
+ * a single operation.  This is equivalent to calling MailBox_Send() for each
+ * envelope in turn, but the mailbox is only locked once, and receivers are
+ * only notified once for the whole batch.
+ *
+ * \param pvData_   Pointer to an array of envelopes to send
+ * \param usCount_  Number of envelopes in the array
+ * \return          Number of envelopes delivered, which is less than usCount_
+ *                  if the mailbox ran out of free slots.
+ */
+K_USHORT MailBox_SendN( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_ );
+
+/*!
+ * \brief SendTailN
+ *
+ * Send up to usCount_ envelopes from an array to the tail of the mailbox.
+ * See MailBox_SendN().
+ *
+ * \param pvData_   Pointer to an array of envelopes to send
+ * \param usCount_  Number of envelopes in the array
+ * \return          Number of envelopes delivered
+ */
+K_USHORT MailBox_SendTailN( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_ );
+
+/*!
+ * \brief ReceiveN
+ *
+ * Read up to usCount_ envelopes from the head of the mailbox into an array,
+ * in a single operation.  If the mailbox is empty, the calling thread blocks
+ * until at least one envelope is delivered.  This is equivalent to calling
+ * MailBox_Receive() for each envelope in turn, stopping when the mailbox is
+ * empty.
+ *
+ * \param pvData_   Pointer to an array to copy the envelopes into
+ * \param usCount_  Maximum number of envelopes to read
+ * \return          Number of envelopes read
+ */
+K_USHORT MailBox_ReceiveN( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_ );
+
+/*!
+ * \brief ReceiveTailN
+ *
+ * Read up to usCount_ envelopes from the tail of the mailbox into an array.
+ * See MailBox_ReceiveN().
+ *
+ * \param pvData_   Pointer to an array to copy the envelopes into
+ * \param usCount_  Maximum number of envelopes to read
+ * \return          Number of envelopes read
+ */
+K_USHORT MailBox_ReceiveTailN( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_ );
+
+#if KERNEL_USE_TIMEOUTS
+/*!
+ * \brief TimedSendN
+ *
+ * Send up to usCount_ envelopes to the head of the mailbox, waiting up to the
+ * specified time for at least one free slot.  See MailBox_SendN().
+ *
+ * \param pvData_       Pointer to an array of envelopes to send
+ * \param usCount_      Number of envelopes in the array
+ * \param ulTimeoutMS_  Maximum time to wait for a free slot
+ * \return              Number of envelopes delivered, 0 on timeout
+ */
+K_USHORT MailBox_TimedSendN( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_, K_ULONG ulTimeoutMS_ );
+
+/*!
+ * \brief TimedSendTailN
+ *
+ * Send up to usCount_ envelopes to the tail of the mailbox, waiting up to the
+ * specified time for at least one free slot.  See MailBox_SendN().
+ *
+ * \param pvData_       Pointer to an array of envelopes to send
+ * \param usCount_      Number of envelopes in the array
+ * \param ulTimeoutMS_  Maximum time to wait for a free slot
+ * \return              Number of envelopes delivered, 0 on timeout
+ */
+K_USHORT MailBox_TimedSendTailN( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_, K_ULONG ulTimeoutMS_ );
+
+/*!
+ * \brief TimedReceiveN
+ *
+ * Read up to usCount_ envelopes from the head of the mailbox, waiting up to
+ * the specified time for the first delivery.  See MailBox_ReceiveN().
+ *
+ * \param pvData_       Pointer to an array to copy the envelopes into
+ * \param usCount_      Maximum number of envelopes to read
+ * \param ulTimeoutMS_  Maximum time to wait for delivery.
+ * \return              Number of envelopes read, 0 on timeout
+ */
+K_USHORT MailBox_TimedReceiveN( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_, K_ULONG ulTimeoutMS_ );
+
+/*!
+ * \brief TimedReceiveTailN
+ *
+ * Read up to usCount_ envelopes from the tail of the mailbox, waiting up to
+ * the specified time for the first delivery.  See MailBox_ReceiveN().
+ *
+ * \param pvData_       Pointer to an array to copy the envelopes into
+ * \param usCount_      Maximum number of envelopes to read
+ * \param ulTimeoutMS_  Maximum time to wait for delivery.
+ * \return              Number of envelopes read, 0 on timeout
+ */
+K_USHORT MailBox_TimedReceiveTailN( MailBox_t *pstMailBox_, void *pvData_, K_USHORT usCount_, K_ULONG ulTimeoutMS_ );
+#endif
+
 K_USHORT MailBox_GetFreeSlots( MailBox_t *pstMailBox_ );
 
 bool MailBox_IsFull( MailBox_t *pstMailBox_ );
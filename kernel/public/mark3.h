@@ -41,6 +41,14 @@ See license.txt for more information
 #include "eventflag.h"
 #include "message.h"
 #include "notify.h"
+#include "ringbuffer.h"
+#include "blockpool.h"
+#include "multiwait.h"
+#include "dpc.h"
+#include "threadstats.h"
+#include "eventtrace.h"
+#include "sampleprofiler.h"
+#include "csstats.h"
 
 #include "atomic.h"
 #include "driver.h"
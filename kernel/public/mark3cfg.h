@@ -62,6 +62,25 @@ See license.txt for more information
     #define KERNEL_TIMERS_TICKLESS       (0)
 #endif
 
+/*!
+    Select the algorithm used to track active timers.
+
+    When enabled, timers are kept in a "delta list" - sorted in order of
+    expiry, with each timer storing only the number of ticks remaining
+    after the timer ahead of it has expired.  Processing a timer interrupt
+    only has to look at the head of the list, so the cost of a tick is
+    constant unless a timer actually expires.  Adding a timer requires a
+    walk of the list to find its insertion point.
+
+    When disabled, timers are kept in an unsorted list, and every timer is
+    visited on every timer interrupt.  Adding a timer is constant-time, but
+    the timer interrupt cost grows with the number of active timers.  This
+    is the original timer engine, and remains the default.
+*/
+#if KERNEL_USE_TIMERS
+    #define KERNEL_TIMERS_DELTA_LIST     (0)
+#endif
+
 /*!
     By default, if you opt to enable kernel timers, you also get timeout-
     enabled versions of the blocking object APIs along with it.  This
@@ -115,13 +134,54 @@ See license.txt for more information
  */
 #define KERNEL_USE_MUTEX                 (1)
 
+/*!
+    Keep the threads waiting on a blocking object (Semaphore_t, Mutex_t, etc.)
+    sorted by their current priority, highest priority first.  Threads of
+    equal priority are kept in the order in which they blocked.
+
+    With this enabled, waking the highest-priority waiter is constant-time,
+    and mutex priority inheritance only has to look at the head of the list,
+    at the cost of a walk of the wait list when a thread blocks, or when a
+    blocked thread's priority changes.  When disabled, the entire wait list
+    is searched each time a thread is woken.
+*/
+#if KERNEL_USE_SEMAPHORE || KERNEL_USE_MUTEX
+    #define KERNEL_USE_PRIORITY_WAITLISTS    (1)
+#else
+    #define KERNEL_USE_PRIORITY_WAITLISTS    (0)
+#endif
+
 /*!
     Provides additional event-flag based blocking.  This relies on an
-    additional per-thread flag-mask to be allocated, which adds 2 bytes
-    to the size of each thread object.
+    additional per-thread flag-mask to be allocated, which adds 2 or 4 bytes
+    (see KERNEL_EVENTFLAG_BITS) to the size of each thread object.
 */
 #define KERNEL_USE_EVENTFLAG             (1)
 
+/*!
+    Width of the event-flag bitmask, in bits - either 16 or 32.  This sets
+    the size of each thread's flag-mask, and of the masks passed to the
+    EventFlag_t APIs.  Going to 32 bits adds 2 bytes to every Thread_t, and
+    2 bytes (4 with KERNEL_USE_EVENTFLAG_INDEX) to every EventFlag_t.
+*/
+#define KERNEL_EVENTFLAG_BITS            (16)
+
+/*!
+    Index the threads blocked on an event flag by the bit they are waiting
+    for, so that setting a flag only visits the threads that care about the
+    bits being set, rather than every blocked thread.  This adds one
+    thread-list per bit (KERNEL_EVENTFLAG_BITS) to each EventFlag_t object,
+    plus a mask: on AVR, 7 bytes per bit - about 114 bytes per object with
+    16-bit flags, or 228 bytes with 32-bit flags.  On Cortex-M0, it is 16
+    bytes per bit, so 260 or 516 bytes per object.  Worth it only with many
+    threads blocked on the same object.
+*/
+#define KERNEL_USE_EVENTFLAG_INDEX       (0)
+
+#if KERNEL_USE_EVENTFLAG_INDEX && !KERNEL_USE_EVENTFLAG
+    #error "KERNEL_USE_EVENTFLAG_INDEX requires KERNEL_USE_EVENTFLAG"
+#endif
+
 /*!
     Enable inter-thread messaging using message queues.  This is the preferred
     mechanism for IPC for serious multi-threaded communications; generally
@@ -144,9 +204,101 @@ See license.txt for more information
     #define GLOBAL_MESSAGE_POOL_SIZE     (8)
 #endif
 
+/*!
+    Do you want message queues that can deliver messages in priority order?
+    This adds a priority field to each message, and lets individual queues
+    be switched into priority mode, where higher-priority messages are
+    received first and FIFO order is kept within each priority.  Insertion
+    cost is bounded by the number of message priority levels.
+*/
+#if KERNEL_USE_MESSAGE
+    #define KERNEL_USE_MESSAGE_PRIORITY  (1)
+#else
+    #define KERNEL_USE_MESSAGE_PRIORITY  (0)
+#endif
+
+/*!
+    Number of distinct message priorities, when message priorities are
+    enabled.  Valid priorities range from 0 (lowest) to
+    MESSAGE_PRIORITY_LEVELS - 1 (highest).  Each queue keeps one list
+    pointer per level.
+*/
+#if KERNEL_USE_MESSAGE_PRIORITY
+    #define MESSAGE_PRIORITY_LEVELS      (4)
+#endif
+
 #define KERNEL_USE_MAILBOX               (1)
 #define KERNEL_USE_NOTIFY                (1)
 
+/*!
+    Enable the lock-free single-producer/single-consumer ring buffer, used
+    to stream data from an interrupt to a thread without critical sections.
+    The optional consumer wakeup is built on semaphores.
+*/
+#if KERNEL_USE_SEMAPHORE
+    #define KERNEL_USE_RINGBUFFER        (1)
+#else
+    #define KERNEL_USE_RINGBUFFER        (0)
+#endif
+
+/*!
+    Enable fixed-block memory pools, providing constant-time allocation and
+    free of equally-sized blocks.  Blocking allocation requires semaphores.
+*/
+#if KERNEL_USE_SEMAPHORE
+    #define KERNEL_USE_BLOCKPOOL         (1)
+#else
+    #define KERNEL_USE_BLOCKPOOL         (0)
+#endif
+
+/*!
+    Allow a thread to block on several semaphores, mailboxes, message queues
+    and event flags at once, waking when the first becomes ready.  This adds
+    a pointer to each Semaphore_t and EventFlag_t object, a pointer and
+    count to each Thread_t, and a check to every Semaphore_Post(), so is
+    off by default.
+*/
+#define KERNEL_USE_MULTIWAIT             (0)
+
+#if KERNEL_USE_MULTIWAIT && !KERNEL_USE_SEMAPHORE
+    #error "KERNEL_USE_MULTIWAIT requires KERNEL_USE_SEMAPHORE"
+#endif
+
+/*!
+    Give each thread a notification value which other threads and interrupts
+    can update directly, waking the thread if it is waiting on it.  This
+    signals a known thread without a separate semaphore or event flag, at a
+    cost of 5 bytes per thread.
+*/
+#if KERNEL_USE_SEMAPHORE || KERNEL_USE_MUTEX
+    #define KERNEL_USE_THREAD_NOTIFY     (1)
+#else
+    #define KERNEL_USE_THREAD_NOTIFY     (0)
+#endif
+
+/*!
+    Provide a deferred procedure call (DPC) queue, allowing interrupt
+    handlers and timer callbacks to hand work off to a high-priority kernel
+    thread, which runs it with interrupts enabled.  This costs one thread,
+    including its stack, plus one scheduler priority level.
+*/
+#define KERNEL_USE_DPC                   (0)
+
+#if KERNEL_USE_DPC && !KERNEL_USE_THREAD_NOTIFY
+    #error "KERNEL_USE_DPC requires KERNEL_USE_THREAD_NOTIFY"
+#endif
+
+#if KERNEL_USE_DPC
+    //! Priority of the DPC thread.  This level is reserved - it is added to
+    //! the scheduler above the KERNEL_NUM_PRIORITIES application priorities,
+    //! so the DPC thread never round-robins with an application thread.
+    //! Application threads must not be given this priority.
+    #define DPC_THREAD_PRIORITY          (KERNEL_NUM_PRIORITIES)
+
+    //! Size of the DPC thread's stack, in bytes
+    #define DPC_STACK_SIZE               (160)
+#endif
+
 /*!
     Do you want to be able to set threads to sleep for a specified time?
     This enables the Thread_t_Sleep() API.
@@ -184,12 +336,58 @@ See license.txt for more information
 */
 #define KERNEL_USE_PROFILER              (1)
 
+/*!
+    Track each thread's cumulative run time and number of times it has
+    been switched in, along with the time spent in the idle function, to
+    report per-thread CPU usage and overall CPU load.  Adds a timestamp to
+    every context switch, and 12 bytes to each thread, so is off by default.
+*/
+#define KERNEL_USE_THREAD_STATS          (0)
+
+#if KERNEL_USE_THREAD_STATS && !KERNEL_USE_TIMERS
+    #error "KERNEL_USE_THREAD_STATS requires KERNEL_USE_TIMERS"
+#endif
+
 /*!
     Provides extra logic for kernel debugging, and instruments the kernel
     with extra asserts, and kernel trace functionality.
 */
 #define KERNEL_USE_DEBUG                 (0)
 
+/*!
+    Trace levels recorded by every module when the kernel starts, with
+    KERNEL_USE_DEBUG.  Verbose traces sit on the kernel's hot paths, and are
+    best enabled at runtime, only for the modules of interest - see
+    TraceBuffer_SetMask().
+*/
+#define KERNEL_TRACE_DEFAULT_LEVELS      (TRACE_LEVEL_INFO | TRACE_LEVEL_WARN | TRACE_LEVEL_ERROR)
+
+/*!
+    Record a compact, timestamped trace of context switches, threads
+    blocking and unblocking, interrupt entry/exit and timer expiries into a
+    RAM ring buffer, drained through a WriteBufferCallback.  The host-side
+    scripts/trace2json.py converts a capture to Chrome trace JSON, to
+    visualize scheduling.  Requires KERNEL_USE_TIMERS for timestamps.
+*/
+#define KERNEL_USE_EVENT_TRACE           (0)
+
+/*!
+    Sample the program counter and running thread from the kernel timer
+    interrupt into a RAM ring buffer, for statistical profiling without
+    instrumenting code.  scripts/sampleprof.py turns the samples into a
+    flat profile, using the application's ELF file.  See sampleprofiler.h.
+*/
+#define KERNEL_USE_SAMPLE_PROFILER       (0)
+
+/*!
+    Time how long each critical section holds interrupts off, recording
+    the longest interval with the file and line that caused it, and a
+    histogram of all intervals.  Adds a timer read to every outermost
+    CS_ENTER()/CS_EXIT() pair, so is meant for development builds.  See
+    csstats.h.
+*/
+#define KERNEL_USE_CS_STATS              (0)
+
 /*!
     Provides support for atomic operations, including addition, subtraction,
     set, and test-and-set.  Add/Sub/Set contain 8, 16, and 32-bit variants.
@@ -212,6 +410,25 @@ See license.txt for more information
 */
 #define KERNEL_AWARE_SIMULATION          (1)
 
+/*!
+    Set the number of thread priority levels supported by the scheduler.
+    Any value from 1 to 64 is supported, with 8, 16, 32, and 64 being the
+    natural choices.
+
+    The scheduler tracks ready priorities in a bitmap, finding the highest
+    ready priority in constant time regardless of this setting.  Up to one
+    machine word of priorities (8 on AVR, 32 on Cortex-M0), a single bitmap
+    word is searched.  Beyond that, a second-level bitmap is used to locate
+    the highest non-empty word first, adding a small, fixed cost to each
+    scheduling decision.  Each additional priority level costs one
+    ThreadList_t worth of RAM.
+
+    With KERNEL_USE_DPC, the scheduler has one more level than this, above
+    the application's, which counts towards the word size and the limit
+    of 64.
+*/
+#define KERNEL_NUM_PRIORITIES            (8)
+
 /*!
     Enabling this feature removes the necessity for the user to dedicate
     a complete thread for idle functionality.  This saves a full thread
@@ -75,6 +75,32 @@ See license.txt for more information
             }
         }
     \endcode
+
+    \section MBPools Independent Message_t Pools
+
+    The global message pool is shared by every queue in the system, so a
+    single busy producer can exhaust it.  Subsystems that need guaranteed
+    message availability can instead declare their own MessagePool_t and
+    bind it to their queues.  Pops from a pool can block until a message is
+    returned, and each pool tracks its high-water mark and failed pops to
+    help size it.
+
+    \code
+
+        static Message_t my_messages[4];
+        MessagePool_t my_pool;
+
+        // At init
+        MessagePool_Init( &my_pool, my_messages, 4 );
+        MessageQueue_SetPool( &my_queue, &my_pool );
+
+        // Sender - wait up to 10ms for a free message
+        Message_t *tx_message = MessagePool_TimedPop( MessageQueue_GetPool( &my_queue ), 10 );
+
+        // Receiver - return the message to the pool bound to the queue
+        MessagePool_Push( MessageQueue_GetPool( &my_queue ), rx_message );
+
+    \endcode
 */
 
 #ifndef __MESSAGE_H__
@@ -110,6 +136,11 @@ typedef struct
 	    
 	//! Message_t code, providing context for the message
     K_USHORT usCode;
+
+#if KERNEL_USE_MESSAGE_PRIORITY
+    //! Delivery priority, used by priority-ordered queues
+    K_UCHAR ucPriority;
+#endif
 } Message_t;
 
 //---------------------------------------------------------------------------
@@ -160,6 +191,151 @@ void Message_SetCode(  Message_t* pstMsg_, K_USHORT usCode_ );
 */
 K_USHORT Message_GetCode( Message_t* pstMsg_ );
 
+#if KERNEL_USE_MESSAGE_PRIORITY
+//---------------------------------------------------------------------------
+/*!
+    \fn void Message_SetPriority( Message_t* pstMsg_, K_UCHAR ucPriority_ )
+
+    Set the delivery priority of the message before transmission.  This is
+    reset to 0 each time the message is popped from a pool, and is ignored
+    by queues that are not in priority mode.
+
+    \param ucPriority_ Priority, from 0 to MESSAGE_PRIORITY_LEVELS - 1.
+                       Higher values are clamped to the highest level.
+*/
+void Message_SetPriority( Message_t* pstMsg_, K_UCHAR ucPriority_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn K_UCHAR Message_GetPriority( Message_t* pstMsg_ )
+
+    \return The delivery priority set in the message
+*/
+K_UCHAR Message_GetPriority( Message_t* pstMsg_ );
+#endif
+
+//---------------------------------------------------------------------------
+/*!
+    Pool of message objects.  Each pool owns a statically-allocated array of
+    messages, and may be bound to one or more message queues so that a
+    single busy subsystem cannot starve every other user of messages.  Free
+    messages are tracked with a counting semaphore, allowing threads to block
+    until a message is returned to the pool.
+*/
+typedef struct
+{
+    //! Counting Semaphore_t tracking the number of free messages
+    Semaphore_t stSemaphore;
+
+    //! List of free messages
+    DoubleLinkList_t stList;
+
+    K_USHORT usSize;        //!< Number of messages owned by the pool
+    K_USHORT usInUse;       //!< Number of messages currently popped from the pool
+    K_USHORT usHighWater;   //!< Maximum number of messages ever in use at once
+    K_USHORT usFailures;    //!< Number of pops that returned no message
+} MessagePool_t;
+
+//---------------------------------------------------------------------------
+/*!
+    \fn void MessagePool_Init( MessagePool_t *pstPool_, Message_t *pastMessages_, K_USHORT usCount_ )
+
+    Initialize a message pool, adding each message in the supplied array
+    to the pool's free list.  Statistics are reset.
+
+    \param pstPool_      Pointer to the pool to initialize
+    \param pastMessages_ Array of message objects to be managed by the pool
+    \param usCount_      Number of messages in the array
+*/
+void MessagePool_Init( MessagePool_t *pstPool_, Message_t *pastMessages_, K_USHORT usCount_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn void MessagePool_Push( MessagePool_t *pstPool_, Message_t *pstMessage_ )
+
+    Return a previously-claimed message object back to the pool, waking
+    the highest-priority thread blocked waiting on a free message.  Safe
+    to call from interrupt context.
+
+    \param pstPool_      Pool the message was allocated from
+    \param pstMessage_   Message object to return to the pool
+*/
+void MessagePool_Push( MessagePool_t *pstPool_, Message_t *pstMessage_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn Message_t *MessagePool_Pop( MessagePool_t *pstPool_ )
+
+    Pop a message from the pool without blocking.  Safe to call from
+    interrupt context.
+
+    \param pstPool_      Pool to allocate a message from
+    \return Pointer to a Message_t object, or NULL if the pool is empty
+*/
+Message_t *MessagePool_Pop( MessagePool_t *pstPool_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn Message_t *MessagePool_BlockingPop( MessagePool_t *pstPool_ )
+
+    Pop a message from the pool, blocking the calling thread until one is
+    available.
+
+    \param pstPool_      Pool to allocate a message from
+    \return Pointer to a Message_t object
+*/
+Message_t *MessagePool_BlockingPop( MessagePool_t *pstPool_ );
+
+#if KERNEL_USE_TIMEOUTS
+//---------------------------------------------------------------------------
+/*!
+    \fn Message_t *MessagePool_TimedPop( MessagePool_t *pstPool_, K_ULONG ulWaitTimeMS_ )
+
+    Pop a message from the pool, blocking the calling thread for up to
+    the specified time until a message is available.
+
+    \param pstPool_      Pool to allocate a message from
+    \param ulWaitTimeMS_ Maximum time to wait, in ms
+    \return Pointer to a Message_t object, or NULL on timeout
+*/
+Message_t *MessagePool_TimedPop( MessagePool_t *pstPool_, K_ULONG ulWaitTimeMS_ );
+#endif
+
+//---------------------------------------------------------------------------
+/*!
+    \fn K_USHORT MessagePool_GetFree( MessagePool_t *pstPool_ )
+
+    \return The number of messages currently available in the pool
+*/
+K_USHORT MessagePool_GetFree( MessagePool_t *pstPool_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn K_USHORT MessagePool_GetHighWater( MessagePool_t *pstPool_ )
+
+    \return The maximum number of messages that have been simultaneously
+            popped from the pool since initialization or the last reset.
+*/
+K_USHORT MessagePool_GetHighWater( MessagePool_t *pstPool_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn K_USHORT MessagePool_GetFailures( MessagePool_t *pstPool_ )
+
+    \return The number of pop operations that failed because the pool was
+            empty (or timed out) since initialization or the last reset.
+*/
+K_USHORT MessagePool_GetFailures( MessagePool_t *pstPool_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn void MessagePool_ResetStats( MessagePool_t *pstPool_ )
+
+    Reset the pool's failure count, and set its high-water mark to the
+    number of messages currently in use.
+*/
+void MessagePool_ResetStats( MessagePool_t *pstPool_ );
+
 //---------------------------------------------------------------------------
 /*!
     \fn void Init()
@@ -191,6 +367,17 @@ void GlobalMessagePool_Push( Message_t *pstMessage_ );
 */
 Message_t *GlobalMessagePool_Pop( void );
 
+//---------------------------------------------------------------------------
+/*!
+    \fn MessagePool_t *GlobalMessagePool_GetPool( void )
+
+    Return the pool object backing the global message pool, for use with
+    the blocking and statistics MessagePool_ APIs.
+
+    \return Pointer to the global MessagePool_t
+*/
+MessagePool_t *GlobalMessagePool_GetPool( void );
+
 //---------------------------------------------------------------------------
 /*!
     List of messages, used as the channel for sending and receiving messages
@@ -203,6 +390,17 @@ typedef struct
 	
 	//! List object used to store messages
     DoubleLinkList_t stLinkList;
+
+    //! Pool from which messages sent on this queue are allocated
+    MessagePool_t *pstPool;
+
+#if KERNEL_USE_MESSAGE_PRIORITY
+    //! Last queued message at each priority level, NULL if none
+    LinkListNode_t *apstPriTail[MESSAGE_PRIORITY_LEVELS];
+
+    //! Whether messages are queued in priority order
+    bool bPriorityOrder;
+#endif
 } MessageQueue_t;
 
 //---------------------------------------------------------------------------
@@ -212,6 +410,42 @@ typedef struct
     Initialize the message queue prior to use.
 */
 void MessageQueue_Init( MessageQueue_t *pstMsgQ_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn void MessageQueue_SetPool( MessageQueue_t *pstMsgQ_, MessagePool_t *pstPool_ )
+
+    Bind a message pool to the queue.  Queues are bound to the global
+    message pool by default.  The binding is advisory: senders should use
+    MessageQueue_GetPool() to allocate messages, and receivers to return
+    them once processed.
+
+    \param pstPool_ Pool to bind to the queue
+*/
+void MessageQueue_SetPool( MessageQueue_t *pstMsgQ_, MessagePool_t *pstPool_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn MessagePool_t *MessageQueue_GetPool( MessageQueue_t *pstMsgQ_ )
+
+    \return The message pool bound to the queue
+*/
+MessagePool_t *MessageQueue_GetPool( MessageQueue_t *pstMsgQ_ );
+
+#if KERNEL_USE_MESSAGE_PRIORITY
+//---------------------------------------------------------------------------
+/*!
+    \fn void MessageQueue_SetPriorityOrder( MessageQueue_t *pstMsgQ_, bool bEnable_ )
+
+    Switch the queue between FIFO and priority-ordered delivery.  In
+    priority mode, messages are received highest-priority first, and in
+    FIFO order within each priority.  Must only be called while the queue
+    is empty.
+
+    \param bEnable_ true - priority order, false - FIFO order (default)
+*/
+void MessageQueue_SetPriorityOrder( MessageQueue_t *pstMsgQ_, bool bEnable_ );
+#endif
     
 //---------------------------------------------------------------------------
 /*!
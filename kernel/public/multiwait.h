@@ -0,0 +1,232 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   multiwait.h
+
+    \brief  Wait on multiple blocking objects at once
+
+    A multi-wait lets a single thread block on a set of semaphores,
+    mailboxes, message queues and event flags, waking as soon as any one of
+    them becomes ready, with an optional timeout.
+
+    The caller describes the set as an array of MultiWaitEntry_t, one per
+    object, initialized with the MultiWait_Init*() functions.  A multi-wait
+    reports readiness - it does not consume anything from the object.  Once
+    it returns, the caller performs the matching operation on the ready
+    object (Semaphore_Pend(), MailBox_Receive(), MessageQueue_Receive() or
+    EventFlag_Wait()), which will not block unless another thread consumed
+    the object's data first.
+
+    \code
+
+        MultiWaitEntry_t astWait[3];
+
+        MultiWait_InitMailBox( &astWait[0], &stMailBox );
+        MultiWait_InitMessageQueue( &astWait[1], &stQueue );
+        MultiWait_InitEventFlag( &astWait[2], &stFlags, 0x0003, EVENT_FLAG_ANY );
+
+        while (1)
+        {
+            switch (MultiWait_TimedWait( astWait, 3, 100 ))
+            {
+                case 0:     MailBox_Receive( &stMailBox, &stEnvelope );         break;
+                case 1:     pstMsg = MessageQueue_Receive( &stQueue );          break;
+                case 2:     tFlags = EventFlag_Wait( &stFlags, 0x0003, EVENT_FLAG_ANY_CLEAR ); break;
+                default:    // Timed out
+                    break;
+            }
+        }
+
+    \endcode
+
+    Each entry is linked onto its object only while its thread is waiting,
+    so entries may be reused and objects shared between several waiting
+    threads.  An object whose data is taken by a thread blocked directly on
+    it (e.g. in Semaphore_Pend()) does not become ready.
+*/
+
+#ifndef __MULTIWAIT_H__
+#define __MULTIWAIT_H__
+
+#include "mark3cfg.h"
+#include "kerneltypes.h"
+#include "ksemaphore.h"
+#include "eventflag.h"
+#include "mailbox.h"
+#include "message.h"
+
+#if KERNEL_USE_MULTIWAIT
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//---------------------------------------------------------------------------
+/*!
+    Returned by MultiWait_Wait() and MultiWait_TimedWait() when no object
+    became ready before the timeout expired.
+*/
+#define MULTIWAIT_TIMEOUT           (0xFF)
+
+//---------------------------------------------------------------------------
+/*!
+    Types of object that a multi-wait can block on
+*/
+typedef enum
+{
+    MULTIWAIT_SEMAPHORE = 0,    //!< Ready when the semaphore's count is non-zero
+    MULTIWAIT_MAILBOX,          //!< Ready when the mailbox holds an envelope
+    MULTIWAIT_MESSAGE_QUEUE,    //!< Ready when the queue holds a message
+    MULTIWAIT_EVENTFLAG,        //!< Ready when the flags match the entry's mask and mode
+//---
+    MULTIWAIT_TYPES
+} MultiWaitType_t;
+
+//---------------------------------------------------------------------------
+/*!
+    One object in a multi-wait set
+*/
+typedef struct _MultiWaitEntry
+{
+    struct _MultiWaitEntry *pstNext;    //!< Next entry linked onto the same object
+    ThreadList_t *pstList;              //!< List the waiting thread is blocked on
+
+    void *pvObject;                     //!< Object to wait on
+    MultiWaitType_t eType;              //!< Type of the object
+
+#if KERNEL_USE_EVENTFLAG
+    K_FLAG_MASK tMask;                  //!< Event-flag bits to wait on
+    EventFlagOperation_t eMode;         //!< EVENT_FLAG_ANY or EVENT_FLAG_ALL
+#endif
+} MultiWaitEntry_t;
+
+//---------------------------------------------------------------------------
+/*!
+    \fn void MultiWait_InitSemaphore( MultiWaitEntry_t *pstEntry_, Semaphore_t *pstSem_ )
+
+    Initialize an entry that becomes ready when the semaphore can be
+    pended without blocking.
+
+    \param pstEntry_ Entry to initialize
+    \param pstSem_   Semaphore to wait on
+*/
+void MultiWait_InitSemaphore( MultiWaitEntry_t *pstEntry_, Semaphore_t *pstSem_ );
+
+#if KERNEL_USE_MAILBOX
+//---------------------------------------------------------------------------
+/*!
+    \fn void MultiWait_InitMailBox( MultiWaitEntry_t *pstEntry_, MailBox_t *pstMailBox_ )
+
+    Initialize an entry that becomes ready when the mailbox holds an
+    envelope.
+
+    \param pstEntry_    Entry to initialize
+    \param pstMailBox_  Mailbox to wait on
+*/
+void MultiWait_InitMailBox( MultiWaitEntry_t *pstEntry_, MailBox_t *pstMailBox_ );
+#endif
+
+#if KERNEL_USE_MESSAGE
+//---------------------------------------------------------------------------
+/*!
+    \fn void MultiWait_InitMessageQueue( MultiWaitEntry_t *pstEntry_, MessageQueue_t *pstMsgQ_ )
+
+    Initialize an entry that becomes ready when the queue holds a message.
+
+    \param pstEntry_    Entry to initialize
+    \param pstMsgQ_     Message queue to wait on
+*/
+void MultiWait_InitMessageQueue( MultiWaitEntry_t *pstEntry_, MessageQueue_t *pstMsgQ_ );
+#endif
+
+#if KERNEL_USE_EVENTFLAG
+//---------------------------------------------------------------------------
+/*!
+    \fn void MultiWait_InitEventFlag( MultiWaitEntry_t *pstEntry_, EventFlag_t *pstFlag_, K_FLAG_MASK tMask_, EventFlagOperation_t eMode_ )
+
+    Initialize an entry that becomes ready when the event flag's bits
+    match the given pattern.  Flags are never cleared by the multi-wait, so
+    the "clear" modes behave as their plain equivalents.
+
+    \param pstEntry_    Entry to initialize
+    \param pstFlag_     Event flag to wait on
+    \param tMask_       Bits to wait on
+    \param eMode_       EVENT_FLAG_ANY or EVENT_FLAG_ALL
+*/
+void MultiWait_InitEventFlag( MultiWaitEntry_t *pstEntry_, EventFlag_t *pstFlag_, K_FLAG_MASK tMask_, EventFlagOperation_t eMode_ );
+#endif
+
+//---------------------------------------------------------------------------
+/*!
+    \fn K_UCHAR MultiWait_Wait( MultiWaitEntry_t *astEntries_, K_UCHAR ucCount_ )
+
+    Block the calling thread until one of the objects in the set is ready.
+
+    \param astEntries_  Array of entries describing the objects to wait on
+    \param ucCount_     Number of entries in the array
+    \return Index of the first ready entry in the array
+*/
+K_UCHAR MultiWait_Wait( MultiWaitEntry_t *astEntries_, K_UCHAR ucCount_ );
+
+#if KERNEL_USE_TIMEOUTS
+//---------------------------------------------------------------------------
+/*!
+    \fn K_UCHAR MultiWait_TimedWait( MultiWaitEntry_t *astEntries_, K_UCHAR ucCount_, K_ULONG ulTimeoutMS_ )
+
+    Block the calling thread until one of the objects in the set is ready,
+    or the timeout expires.  The thread's own timer is used for the timeout.
+
+    \param astEntries_  Array of entries describing the objects to wait on
+    \param ucCount_     Number of entries in the array
+    \param ulTimeoutMS_ Maximum time to wait, in ms.  0 waits forever.
+    \return Index of the first ready entry in the array, or
+            MULTIWAIT_TIMEOUT if none became ready in time
+*/
+K_UCHAR MultiWait_TimedWait( MultiWaitEntry_t *astEntries_, K_UCHAR ucCount_, K_ULONG ulTimeoutMS_ );
+#endif
+
+//---------------------------------------------------------------------------
+/*!
+    \fn K_BOOL MultiWait_Signal_i( struct _MultiWaitEntry *pstHead_ )
+
+    Wake the threads multi-waiting on an object that has just become ready.
+    Called by the kernel objects from within a critical section - not for
+    use by applications.
+
+    \param pstHead_ First entry linked onto the object
+    \return true if a thread of equal or higher priority than the current
+            thread was woken, and a context switch is required
+*/
+K_BOOL MultiWait_Signal_i( struct _MultiWaitEntry *pstHead_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn void MultiWait_Cancel_i( Thread_t *pstThread_ )
+
+    Unlink any multi-wait entries the thread still has linked onto objects.
+    Called by Thread_Stop() and Thread_Exit() from within a critical
+    section - not for use by applications.
+
+    \param pstThread_ Thread being stopped or terminated
+*/
+void MultiWait_Cancel_i( Thread_t *pstThread_ );
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif // KERNEL_USE_MULTIWAIT
+
+#endif // __MULTIWAIT_H__
@@ -0,0 +1,91 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   priomap.h
+
+    \brief  Priority bitmap used by the scheduler
+
+    The priority map tracks which priority levels have threads ready to run,
+    and finds the highest such level in constant time.  On targets with a
+    native word of at least SCHED_NUM_PRIORITIES bits, a single bitmap word
+    is searched.  With more priorities, a second-level word is used to find
+    the highest non-empty bitmap word before searching within it.
+
+    Finding the most-significant set bit of a word is implemented using a
+    small nibble lookup table on 8-bit targets, and a de Bruijn multiply and
+    lookup on 32-bit targets - neither of which depends on a native CLZ
+    instruction.
+*/
+
+#ifndef __PRIOMAP_H__
+#define __PRIOMAP_H__
+
+#include "kerneltypes.h"
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//---------------------------------------------------------------------------
+#define PRIO_MAP_NONE           (0xFF)  //!< Returned when no priority is set
+
+//---------------------------------------------------------------------------
+/*!
+    \brief PriorityMap_Init
+
+    Clear all priority levels in the map.
+
+    \param pstMap_ Priority map object to initialize
+*/
+void PriorityMap_Init( PriorityMap_t *pstMap_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \brief PriorityMap_Set
+
+    Mark the given priority level as having ready threads.
+
+    \param pstMap_ Priority map object to manipulate
+    \param ucPriority_ Priority level to set
+*/
+void PriorityMap_Set( PriorityMap_t *pstMap_, K_UCHAR ucPriority_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \brief PriorityMap_Clear
+
+    Mark the given priority level as having no ready threads.
+
+    \param pstMap_ Priority map object to manipulate
+    \param ucPriority_ Priority level to clear
+*/
+void PriorityMap_Clear( PriorityMap_t *pstMap_, K_UCHAR ucPriority_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \brief PriorityMap_HighestPriority
+
+    Return the highest priority level set in the map.
+
+    \param pstMap_ Priority map object to query
+    \return Highest priority level set, or PRIO_MAP_NONE if the map is empty
+*/
+K_UCHAR PriorityMap_HighestPriority( PriorityMap_t *pstMap_ );
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
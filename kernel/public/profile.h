@@ -47,6 +47,25 @@ See license.txt for more information
 	ulLastTimer = stMyTimer.GetCurrent();
 	
 	\endcode
+
+	Each timer also tracks the shortest and longest iteration, and can
+	optionally count iterations in a log2 histogram, for worst-case and
+	tail latency measurements:
+
+	\code
+
+	K_USHORT ausBuckets[PROFILE_HISTOGRAM_BUCKETS];
+
+	ProfileTimer_Init( &stMyTimer );
+	ProfileTimer_SetHistogram( &stMyTimer, ausBuckets );
+	...
+	ulWorst = ProfileTimer_GetMax( &stMyTimer );
+
+	// ausBuckets[n] now holds the number of iterations that took between
+	// 2^n and 2^(n+1) - 1 ticks
+	ProfileTimer_Reset( &stMyTimer );
+
+	\endcode
 */
 
 
@@ -63,6 +82,14 @@ See license.txt for more information
     extern "C" {
 #endif
 
+//---------------------------------------------------------------------------
+/*!
+    Number of buckets in a profiling timer histogram.  Bucket 0 counts
+    iterations of 0 or 1 ticks, bucket n counts iterations of 2^n to
+    2^(n+1) - 1 ticks, and the last bucket also counts everything longer.
+*/
+#define PROFILE_HISTOGRAM_BUCKETS   (16)
+
 //---------------------------------------------------------------------------
 typedef struct
 {
@@ -72,6 +99,9 @@ typedef struct
     K_ULONG ulInitialEpoch; //!< Initial Epoch
     K_USHORT usIterations; //!< Number of iterations executed for this profiling timer
     K_UCHAR bActive;	   //!< Wheter or not the timer is active or stopped
+    K_ULONG ulMin;         //!< Shortest iteration
+    K_ULONG ulMax;         //!< Longest iteration
+    K_USHORT *pusHistogram; //!< Histogram buckets, or NULL if not in use
 } ProfileTimer_t;
 
 //---------------------------------------------------------------------------
@@ -83,6 +113,41 @@ typedef struct
 */
 void ProfileTimer_Init( ProfileTimer_t *pstTimer_ );
 
+//---------------------------------------------------------------------------
+/*!
+    \fn void SetHistogram( K_USHORT *pusBuckets_ )
+
+    Attach a histogram to the timer, and clear it.  Every subsequent
+    iteration is counted in the bucket for its log2 tick count.  The
+    histogram is detached by ProfileTimer_Init().
+
+    \param pusBuckets_ Array of PROFILE_HISTOGRAM_BUCKETS counters, or NULL
+                       to stop counting.  Counters saturate at 65535.
+*/
+void ProfileTimer_SetHistogram( ProfileTimer_t *pstTimer_, K_USHORT *pusBuckets_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn K_UCHAR GetBucket( K_ULONG ulTicks_ )
+
+    Return the histogram bucket that an iteration of the given length is
+    counted in - see PROFILE_HISTOGRAM_BUCKETS.
+
+    \param ulTicks_ Length of an iteration, in ticks
+    \return Bucket index, from 0 to PROFILE_HISTOGRAM_BUCKETS - 1
+*/
+K_UCHAR ProfileTimer_GetBucket( K_ULONG ulTicks_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn void Reset( void )
+
+    Clear the timer's statistics - cumulative time, iteration count, min,
+    max and histogram - while keeping its histogram attached.  Has no
+    effect on an active iteration.
+*/
+void ProfileTimer_Reset( ProfileTimer_t *pstTimer_ );
+
 //---------------------------------------------------------------------------
 /*!
     \fn void Start( void )
@@ -111,6 +176,34 @@ void ProfileTimer_Stop( ProfileTimer_t *pstTimer_ );
 */
 K_ULONG ProfileTimer_GetAverage( ProfileTimer_t *pstTimer_ );
 
+//---------------------------------------------------------------------------
+/*!
+    \fn K_ULONG GetMin( void )
+
+    Get the shortest iteration recorded since the timer was last reset.
+
+    \return Minimum tick count, or 0 if no iterations have been recorded
+*/
+K_ULONG ProfileTimer_GetMin( ProfileTimer_t *pstTimer_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn K_ULONG GetMax( void )
+
+    Get the longest iteration recorded since the timer was last reset.
+
+    \return Maximum tick count
+*/
+K_ULONG ProfileTimer_GetMax( ProfileTimer_t *pstTimer_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn K_USHORT GetIterations( void )
+
+    \return Number of iterations recorded since the timer was last reset
+*/
+K_USHORT ProfileTimer_GetIterations( ProfileTimer_t *pstTimer_ );
+
 //---------------------------------------------------------------------------
 /*!
     \fn K_ULONG GetCurrent( void )
@@ -0,0 +1,176 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   ringbuffer.h
+
+    \brief  Lock-free single-producer/single-consumer ring buffer
+
+    The ring buffer is intended for streaming data from a single producer
+    (typically an interrupt handler) to a single consumer thread without
+    disabling interrupts on the data path.  The producer only ever writes
+    the head index, and the consumer only ever writes the tail index.  Both
+    indexes are K_WORD sized, so loads and stores are single, atomic
+    accesses on every supported port.  As a result, the number of slots in
+    the buffer is limited to the range of K_WORD (255 on 8-bit targets).
+
+    One slot is always left unused to distinguish the full and empty states;
+    a buffer with N slots holds at most N-1 elements.
+
+    A binary semaphore may optionally be attached to the buffer, in which
+    case it is posted by the producer only when the buffer transitions from
+    empty to non-empty, allowing the consumer to block without the producer
+    paying for a kernel call on every write.
+*/
+
+#ifndef __RINGBUFFER_H__
+#define __RINGBUFFER_H__
+
+#include "mark3cfg.h"
+#include "kerneltypes.h"
+#include "ksemaphore.h"
+
+#if KERNEL_USE_RINGBUFFER
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//---------------------------------------------------------------------------
+typedef struct
+{
+    volatile K_WORD wHead;      //!< Next slot to write (modified by the producer only)
+    volatile K_WORD wTail;      //!< Next slot to read (modified by the consumer only)
+
+    K_WORD wSlots;              //!< Number of element slots in the buffer
+    K_USHORT usElementSize;     //!< Size of each element, in bytes
+    K_UCHAR *pucBuffer;         //!< Pointer to the data-buffer managed by this object
+
+    Semaphore_t *pstSem;        //!< Optional wakeup semaphore, posted on empty->non-empty
+} RingBuffer_t;
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief RingBuffer_Init
+ *
+ * Initialize the ring buffer object prior to its use.
+ *
+ * \param pstRing_          Pointer to the ring buffer object
+ * \param pvBuffer_         Pointer to the static buffer used to hold the data
+ * \param usBufferSize_     Size of the buffer, in bytes
+ * \param usElementSize_    Size of each element, in bytes
+ */
+void RingBuffer_Init( RingBuffer_t *pstRing_, void *pvBuffer_, K_USHORT usBufferSize_, K_USHORT usElementSize_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief RingBuffer_SetSemaphore
+ *
+ * Attach a semaphore to the ring buffer, which is posted by the producer
+ * each time the buffer goes from empty to non-empty.  The semaphore should be
+ * initialized as a binary semaphore (initial value 0, max value 1).  Must be
+ * called before the producer and consumer are started.  Pass NULL to
+ * disable wakeups.
+ *
+ * \param pstRing_          Pointer to the ring buffer object
+ * \param pstSem_           Semaphore to post, or NULL
+ */
+void RingBuffer_SetSemaphore( RingBuffer_t *pstRing_, Semaphore_t *pstSem_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief RingBuffer_Write
+ *
+ * Copy up to usCount_ elements into the buffer.  May only be called from the
+ * producer context, which may be an interrupt handler.  Never blocks.
+ *
+ * \param pstRing_          Pointer to the ring buffer object
+ * \param pvData_           Pointer to the elements to write
+ * \param usCount_          Number of elements to write
+ * \return                  Number of elements actually written
+ */
+K_USHORT RingBuffer_Write( RingBuffer_t *pstRing_, const void *pvData_, K_USHORT usCount_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief RingBuffer_Read
+ *
+ * Copy up to usCount_ elements out of the buffer.  May only be called from
+ * the consumer context.  Never blocks.
+ *
+ * \param pstRing_          Pointer to the ring buffer object
+ * \param pvData_           Pointer to the destination for the elements
+ * \param usCount_          Maximum number of elements to read
+ * \return                  Number of elements actually read
+ */
+K_USHORT RingBuffer_Read( RingBuffer_t *pstRing_, void *pvData_, K_USHORT usCount_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief RingBuffer_GetCount
+ *
+ * Return the number of elements currently held in the buffer.  The value is
+ * a snapshot; it is exact only when called from the producer or consumer.
+ *
+ * \param pstRing_          Pointer to the ring buffer object
+ * \return                  Number of elements available to read
+ */
+K_USHORT RingBuffer_GetCount( RingBuffer_t *pstRing_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief RingBuffer_GetFree
+ *
+ * Return the number of elements that can be written before the buffer is
+ * full.
+ *
+ * \param pstRing_          Pointer to the ring buffer object
+ * \return                  Number of free element slots
+ */
+K_USHORT RingBuffer_GetFree( RingBuffer_t *pstRing_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief RingBuffer_Wait
+ *
+ * Block the consumer until the buffer contains at least one element.
+ * Requires a semaphore to be attached using RingBuffer_SetSemaphore().
+ *
+ * \param pstRing_          Pointer to the ring buffer object
+ */
+void RingBuffer_Wait( RingBuffer_t *pstRing_ );
+
+#if KERNEL_USE_TIMEOUTS
+//---------------------------------------------------------------------------
+/*!
+ * \brief RingBuffer_TimedWait
+ *
+ * Block the consumer until the buffer contains at least one element, or
+ * until the timeout expires.  Requires a semaphore to be attached using
+ * RingBuffer_SetSemaphore().
+ *
+ * \param pstRing_          Pointer to the ring buffer object
+ * \param ulTimeoutMS_      Maximum time to wait, in ms
+ * \return                  true - data is available, false - timed out
+ */
+bool RingBuffer_TimedWait( RingBuffer_t *pstRing_, K_ULONG ulTimeoutMS_ );
+#endif
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif // KERNEL_USE_RINGBUFFER
+
+#endif // __RINGBUFFER_H__
@@ -0,0 +1,152 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   sampleprofiler.h
+
+    \brief  Statistical sampling profiler
+
+    When KERNEL_USE_SAMPLE_PROFILER is enabled, the kernel timer interrupt
+    records the program counter it interrupted, along with the ID of the
+    running thread, into a RAM ring buffer.  Over enough samples, the
+    number of hits in each function is proportional to the time spent in
+    it - no instrumentation of the code being profiled is needed.
+
+    Taking a sample costs a handful of instructions in the timer interrupt,
+    so sampling at the 1kHz tick rate is cheap enough to leave running on
+    production builds.  When the buffer is full, new samples are dropped
+    (and counted) until it is drained.
+
+    \code
+        static ProfileSample_t astSamples[8];
+        K_USHORT usCount;
+        K_USHORT i;
+
+        SampleProfiler_Start( 1 );      // Sample on every timer tick
+        while (1)
+        {
+            Thread_Sleep(100);
+            usCount = SampleProfiler_Read( astSamples, 8 );
+            for (i = 0; i < usCount; i++)
+            {
+                // Send astSamples[i].kPC and astSamples[i].ucThreadID
+                // to the host, as a line of "<pc> <thread ID>" in hex
+            }
+        }
+    \endcode
+
+    scripts/sampleprof.py matches the captured program counters against
+    the application's ELF symbols, and prints a flat profile.
+
+    With KERNEL_TIMERS_TICKLESS, the kernel timer only interrupts when a
+    timer expires, so samples are not evenly spaced in time, and are biased
+    towards code running around timer expiries.  Use a fixed tick when
+    profiling.
+*/
+
+#ifndef __SAMPLEPROFILER_H__
+#define __SAMPLEPROFILER_H__
+
+#include "kerneltypes.h"
+#include "mark3cfg.h"
+
+#if KERNEL_USE_SAMPLE_PROFILER
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//---------------------------------------------------------------------------
+//! Number of samples held until read out.  Must be a power of two.
+#define SAMPLE_PROFILER_BUFFER_SIZE     (32)
+
+//---------------------------------------------------------------------------
+/*!
+    A single sample
+*/
+typedef struct
+{
+    K_ADDR kPC;             //!< Interrupted program counter (word address on AVR)
+    K_UCHAR ucThreadID;     //!< ID of the thread that was running
+} ProfileSample_t;
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief SampleProfiler_Init
+ *
+ * Initialize the sampling profiler, stopped.  Called by Kernel_Init() -
+ * not for use by applications.
+ */
+void SampleProfiler_Init( void );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief SampleProfiler_Sample
+ *
+ * Record a sample, if one is due.  Called by the port's kernel timer
+ * interrupt with the program counter it interrupted - not for use by
+ * applications.
+ *
+ * \param kPC_ Interrupted program counter
+ */
+void SampleProfiler_Sample( K_ADDR kPC_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief SampleProfiler_Start
+ *
+ * Discard any buffered samples, clear the dropped sample count, and start
+ * sampling.
+ *
+ * \param ucInterval_ Take a sample every ucInterval_ kernel timer
+ *                    interrupts
+ */
+void SampleProfiler_Start( K_UCHAR ucInterval_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief SampleProfiler_Stop
+ *
+ * Stop sampling.  Samples already buffered can still be read.
+ */
+void SampleProfiler_Stop( void );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief SampleProfiler_Read
+ *
+ * Remove samples from the buffer, oldest first.
+ *
+ * \param pastSamples_ Array to copy the samples into
+ * \param usMax_       Maximum number of samples to copy
+ * \return Number of samples copied
+ */
+K_USHORT SampleProfiler_Read( ProfileSample_t *pastSamples_, K_USHORT usMax_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief SampleProfiler_GetDropped
+ *
+ * \return Number of samples dropped because the buffer was full, since
+ *         sampling was started
+ */
+K_ULONG SampleProfiler_GetDropped( void );
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif // KERNEL_USE_SAMPLE_PROFILER
+
+#endif // __SAMPLEPROFILER_H__
@@ -55,7 +55,7 @@ See license.txt for more information
     extern "C" {
 #endif
 
-#define NUM_PRIORITIES              (8)     //!< Defines the maximum number of thread priorities supported in the scheduler
+#define NUM_PRIORITIES              (SCHED_NUM_PRIORITIES)      //!< Defines the maximum number of thread priorities supported in the scheduler
 //---------------------------------------------------------------------------
 
 //---------------------------------------------------------------------------
@@ -286,6 +286,90 @@ void Thread_Sleep( K_ULONG ulTimeMs_);
  * \param ulTimeUs_ Time to sleep (in microseconds)
  */
 void Thread_USleep( K_ULONG ulTimeUs_);
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief Thread_SleepUntil
+ *
+ * Put the thread to sleep until an absolute deadline, for periodic threads
+ * that must not drift.  The deadline is one period after the previous
+ * deadline stored in *pulLastWake_, which is then advanced to the new
+ * deadline.  Unlike a loop around Thread_Sleep(), time spent running
+ * between calls does not push the following releases back.
+ *
+ * Initialize the reference from TimerScheduler_GetTicks() before the first
+ * call:
+ *
+ * \code
+ *     K_ULONG ulLastWake = TimerScheduler_GetTicks();
+ *     while (1)
+ *     {
+ *         Thread_SleepUntil( &ulLastWake, 10 );
+ *         ControlLoop_Run();
+ *     }
+ * \endcode
+ *
+ * \param pulLastWake_    Pointer to the previous deadline, in ticks
+ * \param ulPeriodTicks_  Period, in timer ticks (milliseconds in tick-based
+ *                        builds)
+ * \return true if the thread slept, false if the deadline had already
+ *         passed and the call returned immediately
+ */
+K_BOOL Thread_SleepUntil( K_ULONG *pulLastWake_, K_ULONG ulPeriodTicks_ );
+#endif
+
+#if KERNEL_USE_THREAD_NOTIFY
+//---------------------------------------------------------------------------
+/*!
+ * \brief Thread_Notify
+ *
+ * Update a thread's notification value and mark a notification as pending,
+ * waking the thread if it is blocked in Thread_NotifyWait().  No kernel
+ * object is involved, so this is the shortest path from an interrupt or
+ * thread to a known waiting thread.  Safe to call from interrupt context.
+ *
+ * \param pstThread_ Pointer to the thread to notify
+ * \param ulValue_   Value used by the action
+ * \param eAction_   How the thread's notification value is updated
+ */
+void Thread_Notify( Thread_t *pstThread_, K_ULONG ulValue_, NotifyAction_t eAction_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief Thread_NotifyWait
+ *
+ * Block the calling thread until a notification is pending, returning
+ * immediately if one already is.  On return, the pending notification is
+ * consumed and the bits in ulClearMask_ are cleared from the value.
+ *
+ * \param ulClearMask_ Bits of the notification value to clear on return
+ * \param pulValue_    Receives the value before it was cleared (may be NULL)
+ */
+void Thread_NotifyWait( K_ULONG ulClearMask_, K_ULONG *pulValue_ );
+
+#if KERNEL_USE_TIMEOUTS
+//---------------------------------------------------------------------------
+/*!
+ * \brief Thread_NotifyTimedWait
+ *
+ * As Thread_NotifyWait(), but give up if no notification arrives within
+ * the specified time.  The thread's own timer is used for the timeout.
+ *
+ * \param ulClearMask_  Bits of the notification value to clear on return
+ * \param pulValue_     Receives the value before it was cleared (may be NULL)
+ * \param ulTimeoutMS_  Maximum time to wait, in ms.  0 waits forever.
+ * \return true if a notification was received, false on timeout
+ */
+K_BOOL Thread_NotifyTimedWait( K_ULONG ulClearMask_, K_ULONG *pulValue_, K_ULONG ulTimeoutMS_ );
+#endif
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief Thread_GetNotifyValue
+ * \param pstThread_ Pointer to the thread to access
+ * \return The thread's current notification value
+ */
+#define Thread_GetNotifyValue( pstThread_ ) ( ((Thread_t*)pstThread_)->ulNotifyValue )
 #endif
 
 //---------------------------------------------------------------------------
@@ -345,15 +429,15 @@ K_USHORT Thread_GetStackSlack( Thread_t *pstThread_ );
  * \param pstThread_ Pointer to the thread to access/modify
  * \return A copy of the thread's event flag mask
  */
-#define Thread_GetEventFlagMask( pstThread_ ) (((Thread_t*)pstThread_)->usFlagMask)
+#define Thread_GetEventFlagMask( pstThread_ ) (((Thread_t*)pstThread_)->tFlagMask)
 
 //---------------------------------------------------------------------------
 /*!
  * \brief Thread_SetEventFlagMask  Sets the active event flag bitfield mask
  * \param pstThread_ Pointer to the thread to access/modify
- * \param usMask_ Binary mask value to set for this thread
+ * \param tMask_ Binary mask value to set for this thread
  */
-#define Thread_SetEventFlagMask( pstThread_, usMask_ ) (((Thread_t*)pstThread_)->usFlagMask = usMask_)
+#define Thread_SetEventFlagMask( pstThread_, tMask_ ) (((Thread_t*)pstThread_)->tFlagMask = tMask_)
 
 //---------------------------------------------------------------------------
 /*!
@@ -52,15 +52,15 @@ void ThreadList_SetPriority( ThreadList_t *pstList_, K_UCHAR ucPriority_ );
 
 //---------------------------------------------------------------------------
 /*!
-    \brief ThreadList_SetFlagPointer
+    \brief ThreadList_SetMapPointer
 
-    Set the pointer to a bitmap to use for this threadlist.  Once again,
+    Set the pointer to a priority map to use for this threadlist.  Once again,
     only needed when the threadlist is being used for scheduling purposes.
 
     \param pstList_ ThreadList object to manipulate
-    \param pucFlag_ Pointer to the bitmap flag
+    \param pstMap_ Pointer to the priority map
 */
-void ThreadList_SetFlagPointer( ThreadList_t *pstList_, K_UCHAR *pucFlag_ );
+void ThreadList_SetMapPointer( ThreadList_t *pstList_, PriorityMap_t *pstMap_ );
 
 //---------------------------------------------------------------------------
 /*!
@@ -78,19 +78,19 @@ void ThreadList_Add( ThreadList_t *pstList_, Thread_t *node_ );
     \brief ThreadList_AddEX
 
     \fn void Add(LinkListNode_t *node_,
-                    K_UCHAR *pucFlag_,
+                    PriorityMap_t *pstMap_,
                     K_UCHAR ucPriority_)
 
-    Add a thread to the threadlist, specifying the flag and priority at
-    the same time.
+    Add a thread to the threadlist, specifying the priority map and
+    priority at the same time.
 
     \param pstList_ ThreadList object to manipulate
     \param node_        Pointer to the thread to add (link list node)
-    \param pucFlag_     Pointer to the bitmap flag to set (if used in
+    \param pstMap_      Pointer to the priority map to update (if used in
                         a scheduler context), or NULL for non-scheduler.
     \param ucPriority_  Priority of the threadlist
 */
-void ThreadList_AddEX( ThreadList_t *pstList_, Thread_t *node_, K_UCHAR *pucFlag_, K_UCHAR ucPriority_);
+void ThreadList_AddEX( ThreadList_t *pstList_, Thread_t *node_, PriorityMap_t *pstMap_, K_UCHAR ucPriority_);
 
 //---------------------------------------------------------------------------
 /*!
@@ -103,11 +103,41 @@ void ThreadList_AddEX( ThreadList_t *pstList_, Thread_t *node_, K_UCHAR *pucFlag
 */
 void ThreadList_Remove( ThreadList_t *pstList_, Thread_t *node_);
 
+#if KERNEL_USE_PRIORITY_WAITLISTS
+//---------------------------------------------------------------------------
+/*!
+    \brief ThreadList_AddPriority
+
+    Add a thread to the threadlist in order of its current priority.  The
+    thread is placed behind all threads of the same or higher priority, so
+    threads of equal priority remain in FIFO order.
+
+    \param pstList_ ThreadList object to manipulate
+    \param node_ Pointer to the thread to add to the list
+*/
+void ThreadList_AddPriority( ThreadList_t *pstList_, Thread_t *node_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \brief ThreadList_Resort
+
+    Move a thread already in a priority-ordered threadlist to the correct
+    position for its current priority.  Must be called whenever the priority
+    of a thread in such a list changes.
+
+    \param pstList_ ThreadList object to manipulate
+    \param node_ Pointer to the thread to reposition
+*/
+void ThreadList_Resort( ThreadList_t *pstList_, Thread_t *node_ );
+#endif
+
 //---------------------------------------------------------------------------
 /*!
     \brief ThreadList_HighestWaiter
 
     Return a pointer to the highest-priority thread in the thread-list.
+    When KERNEL_USE_PRIORITY_WAITLISTS is enabled, blocking-object lists are
+    kept in priority order, and this simply returns the head of the list.
 
     \param pstList_ ThreadList object to manipulate
     \return Pointer to the highest-priority thread
@@ -0,0 +1,125 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   threadstats.h
+
+    \brief  Per-thread run time and CPU load accounting
+
+    When KERNEL_USE_THREAD_STATS is enabled, every context switch charges
+    the time since the previous switch to the outgoing thread, using the
+    kernel time base (Kernel_GetTime()).  Time spent in the idle function
+    is charged to the idle thread, from which the CPU load is computed.
+
+    \code
+        ThreadStats_t stStats;
+
+        ThreadStats_StartWindow();
+        ThreadStats_Reset( &stWorkerThread );
+        Thread_Sleep(1000);
+
+        ThreadStats_Get( &stWorkerThread, &stStats );
+        // stStats.ullRunTime - microseconds the worker ran in the last second
+        // stStats.ulSwitches - number of times it was switched in
+        ucLoad = ThreadStats_GetCPULoad();
+    \endcode
+*/
+
+#ifndef __THREADSTATS_H__
+#define __THREADSTATS_H__
+
+#include "kerneltypes.h"
+#include "mark3cfg.h"
+
+#if KERNEL_USE_THREAD_STATS
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief ThreadStats_Init
+ *
+ * Initialize the accounting state.  Called by Kernel_Init() - not for use
+ * by applications.
+ */
+void ThreadStats_Init( void );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief ThreadStats_Switch
+ *
+ * Charge the time since the last context switch to the current thread, and
+ * count a switch into the next thread.  Called by the port immediately
+ * before the current thread is replaced by the next, with interrupts
+ * disabled - not for use by applications.
+ */
+void ThreadStats_Switch( void );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief ThreadStats_Get
+ *
+ * Take a consistent snapshot of a thread's counters.  If the thread is
+ * currently running, its run time includes the time since it was switched
+ * in.
+ *
+ * \param pstThread_ Thread to read - Kernel_GetIdleThread() for the idle
+ *                   function
+ * \param pstStats_  Structure to copy the counters into
+ */
+void ThreadStats_Get( Thread_t *pstThread_, ThreadStats_t *pstStats_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief ThreadStats_Reset
+ *
+ * Clear a thread's counters.
+ *
+ * \param pstThread_ Thread to reset - Kernel_GetIdleThread() for the idle
+ *                   function
+ */
+void ThreadStats_Reset( Thread_t *pstThread_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief ThreadStats_StartWindow
+ *
+ * Start a new measurement window for ThreadStats_GetCPULoad().  Clears the
+ * idle time and the current thread's counters only - the kernel doesn't
+ * track every thread, so any other thread to be measured over the same
+ * window must be reset individually with ThreadStats_Reset().
+ */
+void ThreadStats_StartWindow( void );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief ThreadStats_GetCPULoad
+ *
+ * Return the percentage of time spent outside of the idle function since
+ * the last call to ThreadStats_StartWindow() (or since the kernel started).
+ * Without KERNEL_USE_IDLE_FUNC, no time is counted as idle.
+ *
+ * \return CPU load, from 0 to 100
+ */
+K_UCHAR ThreadStats_GetCPULoad( void );
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif // KERNEL_USE_THREAD_STATS
+
+#endif // __THREADSTATS_H__
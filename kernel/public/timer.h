@@ -62,6 +62,9 @@ See license.txt for more information
 #define MSECONDS_TO_TICKS(x)            ((((((K_ULONG)x) * (TIMER_FREQ/100)) + 5) / 10))
 #define USECONDS_TO_TICKS(x)            ((((((K_ULONG)x) * TIMER_FREQ) + 50000) / 1000000))
 
+// Exact only where TIMER_FREQ divides 1MHz (true of the supported ports)
+#define TICKS_TO_USECONDS(x)            (((K_ULONG)(x)) * (1000000 / TIMER_FREQ))
+
 //---------------------------------------------------------------------------
 #define MIN_TICKS                        (3)    //!< The minimum tick value to set
 //---------------------------------------------------------------------------
@@ -76,6 +79,7 @@ See license.txt for more information
 #define SECONDS_TO_TICKS(x)             (((K_ULONG)(x) * 1000) + 1)
 #define MSECONDS_TO_TICKS(x)            ((K_ULONG)(x + 1))
 #define USECONDS_TO_TICKS(x)            (((K_ULONG)(x + 999)) / 1000)
+#define TICKS_TO_USECONDS(x)            (((K_ULONG)(x)) * 1000)
 
 //---------------------------------------------------------------------------
 #define MIN_TICKS                       (1)    //!< The minimum tick value to set
@@ -72,6 +72,30 @@ void TimerList_Remove( Timer_t *pstListNode_ );
 */
 void TimerList_Process( void );
 
+//---------------------------------------------------------------------------
+/*!
+    \fn K_ULONG TimerList_GetTicks()
+
+    Return the number of timer ticks elapsed since the timer list was
+    initialized.  The count is monotonic, and wraps around at 2^32 ticks.
+
+    \return Current tick count
+*/
+K_ULONG TimerList_GetTicks( void );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn K_ULONGLONG TimerList_GetTime()
+
+    Return the time elapsed since the timer list was initialized, in
+    microseconds.  The kernel timer is never stopped, so the time keeps
+    advancing while no timers are pending, in tick-based and tickless
+    builds alike.
+
+    \return Current time, in microseconds
+*/
+K_ULONGLONG TimerList_GetTime( void );
+
 
 #ifdef __cplusplus
     }
@@ -76,6 +76,34 @@ void TimerScheduler_Remove( Timer_t *pstListNode_ );
 */
 void TimerScheduler_Process( void );
 
+//---------------------------------------------------------------------------
+/*!
+    \fn K_ULONG TimerScheduler_GetTicks()
+
+    Return the kernel's monotonic tick count - the number of timer ticks
+    elapsed since the timer scheduler was initialized.  Ticks are
+    milliseconds in tick-based builds, and 1/TIMER_FREQ seconds in tickless
+    builds.  In both, the count advances whether or not any timers are
+    running.  The count wraps around at 2^32 ticks; compare tick counts by
+    subtraction, not magnitude.
+
+    Safe to call from interrupt context.
+
+    \return Current tick count
+*/
+K_ULONG TimerScheduler_GetTicks( void );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn K_ULONGLONG TimerScheduler_GetTime()
+
+    Return the time elapsed since the timer scheduler was initialized, in
+    microseconds.  See Kernel_GetTime().
+
+    \return Current time, in microseconds
+*/
+K_ULONGLONG TimerScheduler_GetTime( void );
+
 
 #ifdef __cplusplus
     }
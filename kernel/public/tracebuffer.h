@@ -20,6 +20,17 @@ See license.txt for more information
 	examined for debugging purposes.  Also, subsets of kernel trace information
 	can be extracted and analyzed to provide information about runtime 
 	performance, thread-scheduling, and other nifty things in real-time.  
+
+	Each trace point has a severity (TRACE_LEVEL_*), and each source module
+	a mask of the severities it records - see TraceBuffer_SetMask().  Trace
+	points filtered out by the mask cost a single load and branch, so
+	verbose hot-path traces can be left compiled in, and switched on only
+	for the modules being investigated:
+
+	\code
+	TraceBuffer_SetMaskAll( TRACE_LEVEL_WARN | TRACE_LEVEL_ERROR );
+	TraceBuffer_SetMask( SEMAPHORE_C, TRACE_LEVEL_ALL );
+	\endcode
 */
 #ifndef __TRACEBUFFER_H__
 #define __TRACEBUFFER_H__
@@ -28,6 +39,51 @@ See license.txt for more information
 #include "mark3cfg.h"
 #include "writebuf16.h"
 
+#if KERNEL_USE_DEBUG
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//---------------------------------------------------------------------------
+/*!
+    \fn void TraceBuffer_SetMask( K_USHORT usModule_, K_UCHAR ucLevels_ )
+
+    Set the trace levels recorded by a module.
+
+    \param usModule_ Source file ID of the module, from debugtokens.h (for
+                     example, SCHEDULER_C).  IDs without a mask of their own
+                     share module 0.
+    \param ucLevels_ Mask of TRACE_LEVEL_* values to record
+*/
+void TraceBuffer_SetMask( K_USHORT usModule_, K_UCHAR ucLevels_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn K_UCHAR TraceBuffer_GetMask( K_USHORT usModule_ )
+
+    \param usModule_ Source file ID of the module
+    \return Mask of the trace levels recorded by the module
+*/
+K_UCHAR TraceBuffer_GetMask( K_USHORT usModule_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn void TraceBuffer_SetMaskAll( K_UCHAR ucLevels_ )
+
+    Set the trace levels recorded by every module.  Called by Kernel_Init()
+    with KERNEL_TRACE_DEFAULT_LEVELS.
+
+    \param ucLevels_ Mask of TRACE_LEVEL_* values to record
+*/
+void TraceBuffer_SetMaskAll( K_UCHAR ucLevels_ );
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif // KERNEL_USE_DEBUG
+
 #if KERNEL_USE_DEBUG && !KERNEL_AWARE_SIMULATION
 
 #ifdef __cplusplus
@@ -23,7 +23,7 @@ See license.txt for more information
 #include "kerneltypes.h"
 #include "mark3cfg.h"
 
-#if KERNEL_USE_DEBUG && !KERNEL_AWARE_SIMULATION
+#if (KERNEL_USE_DEBUG && !KERNEL_AWARE_SIMULATION) || KERNEL_USE_EVENT_TRACE
 
 #ifdef __cplusplus
     extern "C" {
@@ -113,6 +113,20 @@ void WriteBuffer16_WriteData( WriteBuffer16_t *pstBuffer_, K_USHORT *pusBuf_, K_
 */
 void WriteBuffer16_WriteVector( WriteBuffer16_t *pstBuffer_, K_USHORT **ppusBuf_, K_USHORT *pusLen_, K_UCHAR ucCount_);
 
+//---------------------------------------------------------------------------
+/*!
+    \fn void WriteBuffer16_Flush( WriteBuffer16_t *pstBuffer_ )
+
+    Pass any data written since the last callback to the callback function,
+    without waiting for the current half of the buffer to fill.  Writing
+    resumes at the start of the next half, so no data is passed twice.
+    Must not be called while a write is in progress - call from within a
+    critical section if the buffer is written from interrupts.
+
+    \param pstBuffer_ Pointer to the WriteBuffer16 context
+*/
+void WriteBuffer16_Flush( WriteBuffer16_t *pstBuffer_ );
+
 
 #ifdef __cplusplus
     }
@@ -0,0 +1,249 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   ringbuffer.c
+
+    \brief  Lock-free single-producer/single-consumer ring buffer
+*/
+
+#include "mark3cfg.h"
+#include "kerneltypes.h"
+#include "ksemaphore.h"
+#include "kerneldebug.h"
+#include "ringbuffer.h"
+
+//---------------------------------------------------------------------------
+#if defined __FILE_ID__
+	#undef __FILE_ID__
+#endif
+#define __FILE_ID__ 	RINGBUFFER_C       //!< File ID used in kernel trace calls
+
+#if KERNEL_USE_RINGBUFFER
+
+//---------------------------------------------------------------------------
+/*!
+ * Compiler barrier.  Both supported targets are single-core and execute
+ * memory accesses in program order, so it is sufficient to prevent the
+ * compiler from moving element copies across the index updates.
+ */
+#define RINGBUFFER_BARRIER()    __asm__ __volatile__ ( "" ::: "memory" )
+
+//---------------------------------------------------------------------------
+static K_USHORT RingBuffer_Used( RingBuffer_t *pstRing_, K_WORD wHead_, K_WORD wTail_ )
+{
+    if (wHead_ >= wTail_)
+    {
+        return (K_USHORT)(wHead_ - wTail_);
+    }
+    return (K_USHORT)pstRing_->wSlots - wTail_ + wHead_;
+}
+
+//---------------------------------------------------------------------------
+static void RingBuffer_CopyBytes( K_UCHAR *pucDst_, const K_UCHAR *pucSrc_, K_USHORT usBytes_ )
+{
+    while (usBytes_--)
+    {
+        *pucDst_++ = *pucSrc_++;
+    }
+}
+
+//---------------------------------------------------------------------------
+void RingBuffer_Init( RingBuffer_t *pstRing_, void *pvBuffer_, K_USHORT usBufferSize_, K_USHORT usElementSize_ )
+{
+    K_USHORT usSlots;
+
+    KERNEL_ASSERT( pvBuffer_ );
+    KERNEL_ASSERT( usElementSize_ );
+
+    usSlots = usBufferSize_ / usElementSize_;
+
+#if defined(AVR)
+    // Clamp the slot count to what can be represented by the index type.
+    // Only 8-bit targets have a K_WORD narrower than K_USHORT - elsewhere
+    // the comparison could never be true.
+    if (usSlots > (K_USHORT)((K_WORD)(~0)))
+    {
+        usSlots = (K_USHORT)((K_WORD)(~0));
+    }
+#endif
+    KERNEL_ASSERT( usSlots >= 2 );
+
+    pstRing_->wHead = 0;
+    pstRing_->wTail = 0;
+    pstRing_->wSlots = (K_WORD)usSlots;
+    pstRing_->usElementSize = usElementSize_;
+    pstRing_->pucBuffer = (K_UCHAR*)pvBuffer_;
+    pstRing_->pstSem = NULL;
+}
+
+//---------------------------------------------------------------------------
+void RingBuffer_SetSemaphore( RingBuffer_t *pstRing_, Semaphore_t *pstSem_ )
+{
+    pstRing_->pstSem = pstSem_;
+}
+
+//---------------------------------------------------------------------------
+K_USHORT RingBuffer_Write( RingBuffer_t *pstRing_, const void *pvData_, K_USHORT usCount_ )
+{
+    K_WORD wHead = pstRing_->wHead;
+    K_WORD wTail = pstRing_->wTail;
+    K_USHORT usFree;
+    K_USHORT usFirst;
+    K_USHORT usIndex;
+
+    KERNEL_ASSERT( pvData_ );
+
+    usFree = (K_USHORT)pstRing_->wSlots - 1 - RingBuffer_Used( pstRing_, wHead, wTail );
+    if (usCount_ > usFree)
+    {
+        usCount_ = usFree;
+    }
+    if (!usCount_)
+    {
+        return 0;
+    }
+
+    // Copy in at most two chunks - up to the end of the buffer, then from the start.
+    usFirst = (K_USHORT)pstRing_->wSlots - wHead;
+    if (usFirst > usCount_)
+    {
+        usFirst = usCount_;
+    }
+    RingBuffer_CopyBytes( &pstRing_->pucBuffer[ (K_USHORT)wHead * pstRing_->usElementSize ],
+                          (const K_UCHAR*)pvData_,
+                          usFirst * pstRing_->usElementSize );
+    if (usFirst < usCount_)
+    {
+        RingBuffer_CopyBytes( pstRing_->pucBuffer,
+                              (const K_UCHAR*)pvData_ + (usFirst * pstRing_->usElementSize),
+                              (usCount_ - usFirst) * pstRing_->usElementSize );
+    }
+
+    usIndex = (K_USHORT)wHead + usCount_;
+    if (usIndex >= pstRing_->wSlots)
+    {
+        usIndex -= pstRing_->wSlots;
+    }
+
+    // Publish the data to the consumer only once the copy is complete.
+    RINGBUFFER_BARRIER();
+    pstRing_->wHead = (K_WORD)usIndex;
+    RINGBUFFER_BARRIER();
+
+    // Wake the consumer if it had caught up with us before this write.  The
+    // tail is sampled after the head is published, so a consumer that drains
+    // the buffer concurrently will either see the new data or get the post.
+    if (pstRing_->pstSem && (pstRing_->wTail == wHead))
+    {
+        Semaphore_Post( pstRing_->pstSem );
+    }
+    return usCount_;
+}
+
+//---------------------------------------------------------------------------
+K_USHORT RingBuffer_Read( RingBuffer_t *pstRing_, void *pvData_, K_USHORT usCount_ )
+{
+    K_WORD wHead = pstRing_->wHead;
+    K_WORD wTail = pstRing_->wTail;
+    K_USHORT usUsed;
+    K_USHORT usFirst;
+    K_USHORT usIndex;
+
+    KERNEL_ASSERT( pvData_ );
+
+    // Don't read element data until the head index has been sampled.
+    RINGBUFFER_BARRIER();
+
+    usUsed = RingBuffer_Used( pstRing_, wHead, wTail );
+    if (usCount_ > usUsed)
+    {
+        usCount_ = usUsed;
+    }
+    if (!usCount_)
+    {
+        return 0;
+    }
+
+    usFirst = (K_USHORT)pstRing_->wSlots - wTail;
+    if (usFirst > usCount_)
+    {
+        usFirst = usCount_;
+    }
+    RingBuffer_CopyBytes( (K_UCHAR*)pvData_,
+                          &pstRing_->pucBuffer[ (K_USHORT)wTail * pstRing_->usElementSize ],
+                          usFirst * pstRing_->usElementSize );
+    if (usFirst < usCount_)
+    {
+        RingBuffer_CopyBytes( (K_UCHAR*)pvData_ + (usFirst * pstRing_->usElementSize),
+                              pstRing_->pucBuffer,
+                              (usCount_ - usFirst) * pstRing_->usElementSize );
+    }
+
+    usIndex = (K_USHORT)wTail + usCount_;
+    if (usIndex >= pstRing_->wSlots)
+    {
+        usIndex -= pstRing_->wSlots;
+    }
+
+    // Hand the slots back to the producer only once the copy is complete.
+    RINGBUFFER_BARRIER();
+    pstRing_->wTail = (K_WORD)usIndex;
+
+    return usCount_;
+}
+
+//---------------------------------------------------------------------------
+K_USHORT RingBuffer_GetCount( RingBuffer_t *pstRing_ )
+{
+    return RingBuffer_Used( pstRing_, pstRing_->wHead, pstRing_->wTail );
+}
+
+//---------------------------------------------------------------------------
+K_USHORT RingBuffer_GetFree( RingBuffer_t *pstRing_ )
+{
+    return (K_USHORT)pstRing_->wSlots - 1 - RingBuffer_GetCount( pstRing_ );
+}
+
+//---------------------------------------------------------------------------
+void RingBuffer_Wait( RingBuffer_t *pstRing_ )
+{
+    KERNEL_ASSERT( pstRing_->pstSem );
+
+    // The semaphore may hold a stale post from data that has already been
+    // consumed, so re-check the indexes after every wakeup.
+    while (pstRing_->wHead == pstRing_->wTail)
+    {
+        Semaphore_Pend( pstRing_->pstSem );
+    }
+}
+
+#if KERNEL_USE_TIMEOUTS
+//---------------------------------------------------------------------------
+bool RingBuffer_TimedWait( RingBuffer_t *pstRing_, K_ULONG ulTimeoutMS_ )
+{
+    KERNEL_ASSERT( pstRing_->pstSem );
+
+    while (pstRing_->wHead == pstRing_->wTail)
+    {
+        if (!Semaphore_TimedPend( pstRing_->pstSem, ulTimeoutMS_ ))
+        {
+            return (pstRing_->wHead != pstRing_->wTail);
+        }
+    }
+    return true;
+}
+#endif
+
+#endif // KERNEL_USE_RINGBUFFER
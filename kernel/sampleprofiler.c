@@ -0,0 +1,137 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   sampleprofiler.c
+
+    \brief  Statistical sampling profiler
+*/
+
+#include "mark3cfg.h"
+#include "kerneltypes.h"
+#include "kernel.h"
+#include "thread.h"
+#include "threadport.h"
+#include "kerneldebug.h"
+#include "sampleprofiler.h"
+
+//---------------------------------------------------------------------------
+#if defined __FILE_ID__
+	#undef __FILE_ID__
+#endif
+#define __FILE_ID__ 	SAMPLEPROFILER_C       //!< File ID used in kernel trace calls
+
+#if KERNEL_USE_SAMPLE_PROFILER
+
+#define SAMPLE_PROFILER_INDEX_MASK  (SAMPLE_PROFILER_BUFFER_SIZE - 1)
+
+//---------------------------------------------------------------------------
+static ProfileSample_t astSamples[ SAMPLE_PROFILER_BUFFER_SIZE ];  //!< Sample ring buffer
+
+//! Free-running write and read indexes - the buffer holds (usHead - usTail)
+//! samples.  Only the timer interrupt writes usHead, and only the reader
+//! writes usTail.
+static volatile K_USHORT usHead;
+static volatile K_USHORT usTail;
+
+static volatile K_UCHAR ucInterval;     //!< Timer interrupts per sample, 0 when stopped
+static K_UCHAR ucCountdown;             //!< Timer interrupts until the next sample
+static K_ULONG ulDropped;               //!< Samples lost to a full buffer
+
+//---------------------------------------------------------------------------
+void SampleProfiler_Init( void )
+{
+    ucInterval = 0;
+    ucCountdown = 0;
+    usHead = 0;
+    usTail = 0;
+    ulDropped = 0;
+}
+
+//---------------------------------------------------------------------------
+void SampleProfiler_Sample( K_ADDR kPC_ )
+{
+    ProfileSample_t *pstSample;
+    K_USHORT usHeadNow;
+
+    if (!ucInterval || --ucCountdown)
+    {
+        return;
+    }
+    ucCountdown = ucInterval;
+
+    usHeadNow = usHead;
+    if ((K_USHORT)(usHeadNow - usTail) >= SAMPLE_PROFILER_BUFFER_SIZE)
+    {
+        ulDropped++;
+        return;
+    }
+
+    pstSample = &astSamples[ usHeadNow & SAMPLE_PROFILER_INDEX_MASK ];
+    pstSample->kPC = kPC_;
+    pstSample->ucThreadID = Thread_GetID( g_pstCurrent );
+    usHead = usHeadNow + 1;
+}
+
+//---------------------------------------------------------------------------
+void SampleProfiler_Start( K_UCHAR ucInterval_ )
+{
+    CS_ENTER();
+    usTail = usHead;
+    ulDropped = 0;
+    ucCountdown = ucInterval_;
+    ucInterval = ucInterval_;
+    CS_EXIT();
+}
+
+//---------------------------------------------------------------------------
+void SampleProfiler_Stop( void )
+{
+    ucInterval = 0;
+}
+
+//---------------------------------------------------------------------------
+K_USHORT SampleProfiler_Read( ProfileSample_t *pastSamples_, K_USHORT usMax_ )
+{
+    K_USHORT usCount = 0;
+    K_BOOL bEmpty = false;
+
+    // One sample per critical section, so that draining a full buffer
+    // doesn't hold off interrupts for long.
+    while (!bEmpty && (usCount < usMax_))
+    {
+        CS_ENTER();
+        bEmpty = (usTail == usHead);
+        if (!bEmpty)
+        {
+            pastSamples_[usCount++] = astSamples[ usTail & SAMPLE_PROFILER_INDEX_MASK ];
+            usTail++;
+        }
+        CS_EXIT();
+    }
+    return usCount;
+}
+
+//---------------------------------------------------------------------------
+K_ULONG SampleProfiler_GetDropped( void )
+{
+    K_ULONG ulRet;
+
+    CS_ENTER();
+    ulRet = ulDropped;
+    CS_EXIT();
+    return ulRet;
+}
+
+#endif // KERNEL_USE_SAMPLE_PROFILER
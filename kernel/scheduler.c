@@ -25,6 +25,7 @@ See license.txt for more information
 #include "thread.h"
 #include "threadport.h"
 #include "kernel.h"
+#include "priomap.h"
 #include "kerneldebug.h"
 //---------------------------------------------------------------------------
 #if defined __FILE_ID__
@@ -41,29 +42,18 @@ K_BOOL bEnabled;                    //! Scheduler's state - enabled or disabled
 static ThreadList_t stStopList;     //! ThreadList_t for all stopped threads
 static ThreadList_t aclPriorities[NUM_PRIORITIES];    //! ThreadLists for all threads at all priorities
 static K_BOOL bQueuedSchedule;    //! Variable representing whether or not there's a queued scheduler operation
-static K_UCHAR ucPriFlag;         //! Bitmap flag for each
-
-//---------------------------------------------------------------------------
-/*!
- * This implements a 4-bit "Count-leading-zeros" operation using a RAM-based
- * lookup table.  It is used to efficiently perform a CLZ operation under the
- * assumption that a native CLZ instruction is unavailable.  This table is
- * further optimized to provide a 0xFF result in the event that the index value
- * is itself zero, allowing us to quickly identify whether or not subsequent
- * 4-bit LUT operations are required to complete the scheduling process.
- */
-static const K_UCHAR aucCLZ[16] ={255,0,1,1,2,2,2,2,3,3,3,3,3,3,3,3};
+static PriorityMap_t stPrioMap;  //! Bitmap of priority levels with ready threads
 
 //---------------------------------------------------------------------------
 void Scheduler_Init()
 {
-    ucPriFlag = 0;
+    PriorityMap_Init( &stPrioMap );
     uint8_t i;
     for (i = 0; i < NUM_PRIORITIES; i++)
     {
         ThreadList_Init( &aclPriorities[i] );
         ThreadList_SetPriority( &aclPriorities[i], i );
-        ThreadList_SetFlagPointer( &aclPriorities[i], &ucPriFlag );
+        ThreadList_SetMapPointer( &aclPriorities[i], &stPrioMap );
     }
     bQueuedSchedule = false;
 }
@@ -73,24 +63,14 @@ void Scheduler_Schedule()
 {
     K_UCHAR ucPri = 0;
     
-    // Figure out what priority level has ready tasks (8 priorities max)
-    // To do this, we apply our current active-thread bitmap (ucPriFlag)
-    // and perform a CLZ on the upper four bits.  If no tasks are found
-    // in the higher priority bits, search the lower priority bits.  This
-    // also assumes that we always have the idle thread ready-to-run in
-    // priority level zero.
-    ucPri = aucCLZ[ucPriFlag >> 4 ];
-    if (ucPri == 0xFF)
-    {
-        ucPri = aucCLZ[ucPriFlag & 0x0F];
-    }
-    else
-    {
-        ucPri += 4;
-    }
+    // Figure out what priority level has ready tasks.  The priority map
+    // finds the highest set bit in its bitmap in constant time, regardless
+    // of the number of priorities configured.  This also assumes that we
+    // always have the idle thread ready-to-run in priority level zero.
+    ucPri = PriorityMap_HighestPriority( &stPrioMap );
 
 #if KERNEL_USE_IDLE_FUNC
-    if (ucPri == 0xFF)
+    if (ucPri == PRIO_MAP_NONE)
     {
         // There aren't any active threads at all - set g_pstNext to IDLE
         g_pstNext = Kernel_GetIdleThread();
@@ -101,7 +81,7 @@ void Scheduler_Schedule()
         // Get the thread node at this priority.
         g_pstNext = (Thread_t*)( LinkList_GetHead( (LinkList_t*)&aclPriorities[ucPri] ) );
     }
-    KERNEL_TRACE_1( STR_SCHEDULE_1, (K_USHORT)Thread_GetID( (Thread_t*)g_pstNext) );
+    KERNEL_TRACE_1( TRACE_LEVEL_VERBOSE, STR_SCHEDULE_1, (K_USHORT)Thread_GetID( (Thread_t*)g_pstNext) );
 }
 
 //---------------------------------------------------------------------------
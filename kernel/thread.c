@@ -32,6 +32,9 @@ See license.txt for more information
 #include "quantum.h"
 #include "kernel.h"
 #include "kerneldebug.h"
+#include "blocking.h"
+#include "timer.h"
+#include "multiwait.h"
 
 //---------------------------------------------------------------------------
 #if defined __FILE_ID__
@@ -39,6 +42,13 @@ See license.txt for more information
 #endif
 #define __FILE_ID__     THREAD_C       //!< File ID used in kernel trace calls
 
+#if KERNEL_USE_THREAD_NOTIFY
+//---------------------------------------------------------------------------
+#define NOTIFY_STATE_IDLE       (0)     //!< No notification pending
+#define NOTIFY_STATE_PENDING    (1)     //!< Notification received, not yet consumed
+#define NOTIFY_STATE_WAITING    (2)     //!< Thread is blocked waiting for a notification
+#endif
+
 //---------------------------------------------------------------------------
 void Thread_Init(   Thread_t *pstThread_,
                     K_WORD *pwStack_,
@@ -56,10 +66,10 @@ void Thread_Init(   Thread_t *pstThread_,
 
     pstThread_->ucThreadID = ucThreadID++;
     
-    KERNEL_TRACE_1( STR_STACK_SIZE_1, usStackSize_ );
-    KERNEL_TRACE_1( STR_PRIORITY_1, (K_UCHAR)ucPriority_ );
-    KERNEL_TRACE_1( STR_THREAD_ID_1, (K_USHORT)pstThread_->ucThreadID );
-    KERNEL_TRACE_1( STR_ENTRYPOINT_1, (K_USHORT)pfEntryPoint_ );
+    KERNEL_TRACE_1( TRACE_LEVEL_INFO, STR_STACK_SIZE_1, usStackSize_ );
+    KERNEL_TRACE_1( TRACE_LEVEL_INFO, STR_PRIORITY_1, (K_UCHAR)ucPriority_ );
+    KERNEL_TRACE_1( TRACE_LEVEL_INFO, STR_THREAD_ID_1, (K_USHORT)pstThread_->ucThreadID );
+    KERNEL_TRACE_1( TRACE_LEVEL_INFO, STR_ENTRYPOINT_1, (K_USHORT)pfEntryPoint_ );
     
     // Initialize the thread parameters to their initial values.
     pstThread_->pwStack = pwStack_;
@@ -83,6 +93,18 @@ void Thread_Init(   Thread_t *pstThread_,
 #if KERNEL_USE_TIMERS
     Timer_Init( &(pstThread_->stTimer) );
 #endif
+#if KERNEL_USE_MULTIWAIT
+    pstThread_->pstMultiWait = NULL;
+    pstThread_->ucMultiWaitCount = 0;
+#endif
+#if KERNEL_USE_THREAD_NOTIFY
+    pstThread_->ulNotifyValue = 0;
+    pstThread_->ucNotifyState = NOTIFY_STATE_IDLE;
+#endif
+#if KERNEL_USE_THREAD_STATS
+    pstThread_->stStats.ullRunTime = 0;
+    pstThread_->stStats.ulSwitches = 0;
+#endif
 
     // Call CPU-specific stack initialization
     ThreadPort_InitStack( pstThread_ );
@@ -100,7 +122,7 @@ void Thread_Start( Thread_t *pstThread_ )
 {
     // Remove the thread from the scheduler's "stopped" list, and add it 
     // to the scheduler's ready list at the proper priority.
-    KERNEL_TRACE_1( STR_THREAD_START_1, (K_USHORT)pstThread_->ucThreadID );
+    KERNEL_TRACE_1( TRACE_LEVEL_INFO, STR_THREAD_START_1, (K_USHORT)pstThread_->ucThreadID );
     
     CS_ENTER();
     ThreadList_Remove( Scheduler_GetStopList(), pstThread_ );
@@ -167,6 +189,12 @@ void Thread_Stop( Thread_t *pstThread_ )
     TimerScheduler_Remove(&pstThread_->stTimer);
 #endif
 
+#if KERNEL_USE_MULTIWAIT
+    // A thread killed mid multi-wait leaves its entries (which live on its
+    // own stack) linked onto the objects it was waiting on.
+    MultiWait_Cancel_i(pstThread_);
+#endif
+
     CS_EXIT();
 
     if (bReschedule)
@@ -181,7 +209,7 @@ void Thread_Exit( Thread_t *pstThread_ )
 {
     K_BOOL bReschedule = 0;
     
-    KERNEL_TRACE_1( STR_THREAD_EXIT_1, pstThread_->ucThreadID );
+    KERNEL_TRACE_1( TRACE_LEVEL_INFO, STR_THREAD_EXIT_1, pstThread_->ucThreadID );
     
     CS_ENTER();
     
@@ -221,6 +249,12 @@ void Thread_Exit( Thread_t *pstThread_ )
     TimerScheduler_Remove(&pstThread_->stTimer);
 #endif
 
+#if KERNEL_USE_MULTIWAIT
+    // A thread killed mid multi-wait leaves its entries (which live on its
+    // own stack) linked onto the objects it was waiting on.
+    MultiWait_Cancel_i(pstThread_);
+#endif
+
     CS_EXIT();
     
     if (bReschedule) 
@@ -284,8 +318,207 @@ void Thread_USleep( K_ULONG ulTimeUs_)
     TimerScheduler_Add(pstTimer);
     Semaphore_Pend( &stSemaphore );
 }
+
+//---------------------------------------------------------------------------
+K_BOOL Thread_SleepUntil( K_ULONG *pulLastWake_, K_ULONG ulPeriodTicks_ )
+{
+    Semaphore_t stSemaphore;
+    Timer_t *pstTimer = Thread_GetTimer( g_pstCurrent );
+    K_ULONG ulDeadline;
+    K_LONG lRemaining;
+
+    // The next release is a fixed period after the last one, however long
+    // the thread took to get here.
+    ulDeadline = *pulLastWake_ + ulPeriodTicks_;
+    *pulLastWake_ = ulDeadline;
+
+    Semaphore_Init( &stSemaphore, 0, 1 );
+
+    // Read the tick count and queue the timer without a tick in between, so
+    // the wakeup lands exactly on the deadline.
+    CS_ENTER();
+    lRemaining = (K_LONG)(ulDeadline - TimerScheduler_GetTicks());
+    if (lRemaining > 0)
+    {
+        Timer_Init( pstTimer );
+        Timer_SetIntervalTicks( pstTimer, (K_ULONG)lRemaining );
+        Timer_SetCallback( pstTimer, ThreadSleepCallback );
+        Timer_SetData( pstTimer, (void*)&stSemaphore );
+        Timer_SetFlags( pstTimer, TIMERLIST_FLAG_ONE_SHOT );
+        TimerScheduler_Add( pstTimer );
+    }
+    CS_EXIT();
+
+    // Deadline already passed - the caller has overrun its period.
+    if (lRemaining <= 0)
+    {
+        return false;
+    }
+
+    Semaphore_Pend( &stSemaphore );
+    return true;
+}
 #endif // KERNEL_USE_SLEEP
 
+#if KERNEL_USE_THREAD_NOTIFY
+//---------------------------------------------------------------------------
+/*!
+ * \brief Thread_WakeNotified_i
+ *
+ * Return a thread blocked in Thread_NotifyWait() to the ready state.  Must
+ * be called from within a critical section.
+ *
+ * \return true if the woken thread should pre-empt the current thread
+ */
+static K_BOOL Thread_WakeNotified_i( Thread_t *pstThread_ )
+{
+    BlockingObject_UnBlock( pstThread_ );
+    return ( Thread_GetCurPriority( pstThread_ ) >=
+             Thread_GetCurPriority( Scheduler_GetCurrentThread() ) );
+}
+
+#if KERNEL_USE_TIMEOUTS
+//---------------------------------------------------------------------------
+static void TimedNotify_Callback( Thread_t *pstOwner_, void *pvData_ )
+{
+    K_BOOL bReschedule = false;
+
+    CS_ENTER();
+    // A notification may have beaten the timer; only wake a thread that is
+    // still waiting.
+    if ((NOTIFY_STATE_WAITING == pstOwner_->ucNotifyState) &&
+        (THREAD_STATE_BLOCKED == Thread_GetState( pstOwner_ )))
+    {
+        pstOwner_->ucNotifyState = NOTIFY_STATE_IDLE;
+        bReschedule = Thread_WakeNotified_i( pstOwner_ );
+    }
+    CS_EXIT();
+
+    if (bReschedule)
+    {
+        Thread_Yield();
+    }
+}
+#endif
+
+//---------------------------------------------------------------------------
+void Thread_Notify( Thread_t *pstThread_, K_ULONG ulValue_, NotifyAction_t eAction_ )
+{
+    K_BOOL bReschedule = false;
+
+    CS_ENTER();
+
+    switch (eAction_)
+    {
+        case NOTIFY_ACTION_SET_BITS:
+            pstThread_->ulNotifyValue |= ulValue_;
+            break;
+        case NOTIFY_ACTION_INCREMENT:
+            pstThread_->ulNotifyValue++;
+            break;
+        case NOTIFY_ACTION_OVERWRITE:
+            pstThread_->ulNotifyValue = ulValue_;
+            break;
+        default:
+            break;
+    }
+
+    // A thread stopped while waiting is left alone until it is restarted.
+    if ((NOTIFY_STATE_WAITING == pstThread_->ucNotifyState) &&
+        (THREAD_STATE_BLOCKED == Thread_GetState( pstThread_ )))
+    {
+        bReschedule = Thread_WakeNotified_i( pstThread_ );
+    }
+    pstThread_->ucNotifyState = NOTIFY_STATE_PENDING;
+
+    CS_EXIT();
+
+    if (bReschedule)
+    {
+        Thread_Yield();
+    }
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief Thread_NotifyWait_i
+ *
+ * Internal function used to abstract timed and untimed notification waits.
+ *
+ * \param ulTimeoutMS_ Time to wait in ms, 0 to wait forever
+ * \return true if a notification was consumed, false on timeout
+ */
+static K_BOOL Thread_NotifyWait_i( K_ULONG ulClearMask_, K_ULONG *pulValue_, K_ULONG ulTimeoutMS_ )
+{
+    // The thread blocks on a list of its own, on its stack, so notification
+    // costs no RAM beyond the Thread_t.  Thread_Stop()/Thread_Exit() still
+    // find the thread on the list they expect a blocked thread to be on.
+    ThreadList_t stList;
+    K_BOOL bRet = true;
+#if KERNEL_USE_TIMEOUTS
+    K_BOOL bUseTimer = false;
+#endif
+
+    CS_ENTER();
+    if (NOTIFY_STATE_PENDING != g_pstCurrent->ucNotifyState)
+    {
+        ThreadList_Init( &stList );
+#if KERNEL_USE_TIMEOUTS
+        if (ulTimeoutMS_)
+        {
+            Timer_Start( Thread_GetTimer( g_pstCurrent ), false, ulTimeoutMS_, TimedNotify_Callback, 0 );
+            bUseTimer = true;
+        }
+#endif
+        g_pstCurrent->ucNotifyState = NOTIFY_STATE_WAITING;
+        BlockingObject_Block( &stList, g_pstCurrent );
+        Thread_Yield();
+    }
+    CS_EXIT();
+
+#if KERNEL_USE_TIMEOUTS
+    if (bUseTimer)
+    {
+        Timer_Stop( Thread_GetTimer( g_pstCurrent ) );
+    }
+#endif
+
+    // Consume the notification - including one that arrived just after the
+    // timeout woke us.
+    CS_ENTER();
+    if (NOTIFY_STATE_PENDING == g_pstCurrent->ucNotifyState)
+    {
+        if (pulValue_)
+        {
+            *pulValue_ = g_pstCurrent->ulNotifyValue;
+        }
+        g_pstCurrent->ulNotifyValue &= ~ulClearMask_;
+    }
+    else
+    {
+        bRet = false;
+    }
+    g_pstCurrent->ucNotifyState = NOTIFY_STATE_IDLE;
+    CS_EXIT();
+
+    return bRet;
+}
+
+//---------------------------------------------------------------------------
+void Thread_NotifyWait( K_ULONG ulClearMask_, K_ULONG *pulValue_ )
+{
+    Thread_NotifyWait_i( ulClearMask_, pulValue_, 0 );
+}
+
+#if KERNEL_USE_TIMEOUTS
+//---------------------------------------------------------------------------
+K_BOOL Thread_NotifyTimedWait( K_ULONG ulClearMask_, K_ULONG *pulValue_, K_ULONG ulTimeoutMS_ )
+{
+    return Thread_NotifyWait_i( ulClearMask_, pulValue_, ulTimeoutMS_ );
+}
+#endif
+#endif // KERNEL_USE_THREAD_NOTIFY
+
 //---------------------------------------------------------------------------
 K_USHORT Thread_GetStackSlack( Thread_t *pstThread_ )
 {
@@ -395,6 +628,17 @@ void Thread_InheritPriority( Thread_t *pstThread_, K_UCHAR ucPriority_ )
 {    
     Thread_SetOwner(pstThread_, Scheduler_GetThreadList(ucPriority_));
     pstThread_->ucCurPriority = ucPriority_;
+
+#if KERNEL_USE_PRIORITY_WAITLISTS
+    // A blocked thread's position in its wait list depends on its priority,
+    // so move it to its new place in the list.
+    CS_ENTER();
+    if (pstThread_->eState == THREAD_STATE_BLOCKED)
+    {
+        ThreadList_Resort( pstThread_->pstCurrent, pstThread_ );
+    }
+    CS_EXIT();
+#endif
 }
 
 //---------------------------------------------------------------------------
@@ -403,7 +647,7 @@ void Thread_ContextSwitchSWI( void )
     // Call the context switch interrupt if the scheduler is enabled.
     if (Scheduler_IsEnabled() == 1)
     {        
-        KERNEL_TRACE_1( STR_CONTEXT_SWITCH_1, (K_USHORT)Thread_GetID( (Thread_t*)g_pstNext ) );
+        KERNEL_TRACE_1( TRACE_LEVEL_VERBOSE, STR_CONTEXT_SWITCH_1, (K_USHORT)Thread_GetID( (Thread_t*)g_pstNext ) );
         KernelSWI_Trigger();
     }
 }
@@ -23,6 +23,7 @@ See license.txt for more information
 #include "ll.h"
 #include "threadlist.h"
 #include "thread.h"
+#include "priomap.h"
 #include "kerneldebug.h"
 //---------------------------------------------------------------------------
 #if defined __FILE_ID__
@@ -35,7 +36,7 @@ void ThreadList_Init( ThreadList_t *pstList_ )
 { 
 	CircularLinkList_Init( (CircularLinkList_t*)pstList_ );
 	pstList_->ucPriority = 0; 
-	pstList_->pucFlag = NULL; 
+	pstList_->pstMap = NULL; 
 }
 
 //---------------------------------------------------------------------------
@@ -45,9 +46,9 @@ void ThreadList_SetPriority( ThreadList_t *pstList_, K_UCHAR ucPriority_ )
 }
 
 //---------------------------------------------------------------------------
-void ThreadList_SetFlagPointer( ThreadList_t *pstList_, K_UCHAR *pucFlag_)
+void ThreadList_SetMapPointer( ThreadList_t *pstList_, PriorityMap_t *pstMap_)
 {
-    pstList_->pucFlag = pucFlag_;
+    pstList_->pstMap = pstMap_;
 }
 
 //---------------------------------------------------------------------------
@@ -58,19 +59,19 @@ void ThreadList_Add( ThreadList_t *pstList_, Thread_t *node_ )
     CircularLinkList_PivotForward( pstCLL );
     
     // We've specified a bitmap for this threadlist
-    if (pstList_->pucFlag)
+    if (pstList_->pstMap)
     {
         // Set the flag for this priority level
-        *pstList_->pucFlag |= (1 << pstList_->ucPriority);
+        PriorityMap_Set( pstList_->pstMap, pstList_->ucPriority );
     }
 }
 
 //---------------------------------------------------------------------------
-void ThreadList_AddEx( ThreadList_t *pstList_, Thread_t *node_, K_UCHAR *pucFlag_, K_UCHAR ucPriority_) {
+void ThreadList_AddEx( ThreadList_t *pstList_, Thread_t *node_, PriorityMap_t *pstMap_, K_UCHAR ucPriority_) {
     // Set the threadlist's priority level, flag pointer, and then add the
     // thread to the threadlist
     ThreadList_SetPriority( pstList_, ucPriority_ );
-    ThreadList_SetFlagPointer( pstList_, pucFlag_ );
+    ThreadList_SetMapPointer( pstList_, pstMap_ );
     ThreadList_Add( pstList_, node_);
 }
 
@@ -84,16 +85,63 @@ void ThreadList_Remove( ThreadList_t *pstList_, Thread_t *node_) {
     if (!pstCLL->pstHead)
     {
         // Clear the bit in the bitmap at this priority level
-        if (pstList_->pucFlag)
+        if (pstList_->pstMap)
         {
-            *pstList_->pucFlag &= ~(1 << pstList_->ucPriority);
+            PriorityMap_Clear( pstList_->pstMap, pstList_->ucPriority );
         }
     }
 }
 
+#if KERNEL_USE_PRIORITY_WAITLISTS
+//---------------------------------------------------------------------------
+void ThreadList_AddPriority( ThreadList_t *pstList_, Thread_t *node_ )
+{
+    CircularLinkList_t *pstCLL = (CircularLinkList_t*)pstList_;
+    Thread_t *pstTemp = (Thread_t*)LinkList_GetTail( (LinkList_t*)pstList_ );
+    K_UCHAR ucPri = Thread_GetCurPriority( node_ );
+
+    // Walk backwards from the tail to find the last thread of the same or
+    // higher priority.  Threads usually block at similar priorities, so this
+    // normally terminates at the tail.
+    while (pstTemp)
+    {
+        if (Thread_GetCurPriority( pstTemp ) >= ucPri)
+        {
+            break;
+        }
+
+        // No thread has a higher priority - insert at the head
+        if (pstTemp == (Thread_t*)LinkList_GetHead( (LinkList_t*)pstList_ ))
+        {
+            pstTemp = NULL;
+            break;
+        }
+        pstTemp = (Thread_t*)LinkListNode_GetPrev( (LinkListNode_t*)pstTemp );
+    }
+
+    CircularLinkList_InsertAfter( pstCLL, (LinkListNode_t*)node_, (LinkListNode_t*)pstTemp );
+
+    if (pstList_->pstMap)
+    {
+        PriorityMap_Set( pstList_->pstMap, pstList_->ucPriority );
+    }
+}
+
+//---------------------------------------------------------------------------
+void ThreadList_Resort( ThreadList_t *pstList_, Thread_t *node_ )
+{
+    CircularLinkList_Remove( (CircularLinkList_t*)pstList_, (LinkListNode_t*)node_ );
+    ThreadList_AddPriority( pstList_, node_ );
+}
+#endif
+
 //---------------------------------------------------------------------------
 Thread_t *ThreadList_HighestWaiter( ThreadList_t *pstList_ )
 {
+#if KERNEL_USE_PRIORITY_WAITLISTS
+    // The list is kept in priority order - the head is the highest waiter.
+    return (Thread_t*)LinkList_GetHead( (LinkList_t*)pstList_ );
+#else
     Thread_t *pstTemp = (Thread_t*)LinkList_GetHead( (LinkList_t*)pstList_ );
     Thread_t *pstChosen = pstTemp;
 	
@@ -118,4 +166,5 @@ Thread_t *ThreadList_HighestWaiter( ThreadList_t *pstList_ )
         pstTemp = (Thread_t*)LinkListNode_GetNext( (LinkListNode_t*)pstTemp );
 	} 
     return pstChosen;
+#endif
 }
@@ -0,0 +1,187 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   threadstats.c
+
+    \brief  Per-thread run time and CPU load accounting
+*/
+
+#include "mark3cfg.h"
+#include "kerneltypes.h"
+#include "kernel.h"
+#include "scheduler.h"
+#include "threadport.h"
+#include "kerneldebug.h"
+#include "threadstats.h"
+
+//---------------------------------------------------------------------------
+#if defined __FILE_ID__
+	#undef __FILE_ID__
+#endif
+#define __FILE_ID__ 	THREADSTATS_C       //!< File ID used in kernel trace calls
+
+#if KERNEL_USE_THREAD_STATS
+
+//---------------------------------------------------------------------------
+#if KERNEL_USE_IDLE_FUNC
+//! The idle "thread" has no room for counters of its own
+static ThreadStats_t stIdleStats;
+#endif
+
+//! Time of the last context switch
+static K_ULONGLONG ullLastSwitch;
+
+//! Start of the current CPU load measurement window
+static K_ULONGLONG ullWindowStart;
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief ThreadStats_Find_i
+ *
+ * \param pstThread_ Thread, or the idle thread
+ * \return Pointer to the thread's counters
+ */
+static ThreadStats_t *ThreadStats_Find_i( Thread_t *pstThread_ )
+{
+#if KERNEL_USE_IDLE_FUNC
+    if (pstThread_ == Kernel_GetIdleThread())
+    {
+        return &stIdleStats;
+    }
+#endif
+    return &pstThread_->stStats;
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief ThreadStats_Clear_i
+ *
+ * Clear a thread's counters.  Must be called from within a critical
+ * section.
+ */
+static void ThreadStats_Clear_i( Thread_t *pstThread_, K_ULONGLONG ullNow_ )
+{
+    ThreadStats_t *pstStats = ThreadStats_Find_i( pstThread_ );
+
+    pstStats->ullRunTime = 0;
+    pstStats->ulSwitches = 0;
+
+    // The running thread's time is counted from the last switch
+    if (pstThread_ == g_pstCurrent)
+    {
+        ullLastSwitch = ullNow_;
+    }
+}
+
+//---------------------------------------------------------------------------
+void ThreadStats_Init( void )
+{
+#if KERNEL_USE_IDLE_FUNC
+    stIdleStats.ullRunTime = 0;
+    stIdleStats.ulSwitches = 0;
+#endif
+    ullLastSwitch = 0;
+    ullWindowStart = 0;
+}
+
+//---------------------------------------------------------------------------
+void ThreadStats_Switch( void )
+{
+    K_ULONGLONG ullNow = Kernel_GetTime();
+
+    // Nothing is running before the first switch
+    if (g_pstCurrent)
+    {
+        ThreadStats_Find_i( g_pstCurrent )->ullRunTime += ullNow - ullLastSwitch;
+    }
+    ThreadStats_Find_i( (Thread_t*)g_pstNext )->ulSwitches++;
+    ullLastSwitch = ullNow;
+}
+
+//---------------------------------------------------------------------------
+void ThreadStats_Get( Thread_t *pstThread_, ThreadStats_t *pstStats_ )
+{
+    CS_ENTER();
+    *pstStats_ = *ThreadStats_Find_i( pstThread_ );
+    if (pstThread_ == g_pstCurrent)
+    {
+        pstStats_->ullRunTime += Kernel_GetTime() - ullLastSwitch;
+    }
+    CS_EXIT();
+}
+
+//---------------------------------------------------------------------------
+void ThreadStats_Reset( Thread_t *pstThread_ )
+{
+    CS_ENTER();
+    ThreadStats_Clear_i( pstThread_, Kernel_GetTime() );
+    CS_EXIT();
+}
+
+//---------------------------------------------------------------------------
+void ThreadStats_StartWindow( void )
+{
+    K_ULONGLONG ullNow;
+
+    CS_ENTER();
+    ullNow = Kernel_GetTime();
+#if KERNEL_USE_IDLE_FUNC
+    ThreadStats_Clear_i( Kernel_GetIdleThread(), ullNow );
+#endif
+    if (g_pstCurrent)
+    {
+        ThreadStats_Clear_i( g_pstCurrent, ullNow );
+    }
+    ullWindowStart = ullNow;
+    CS_EXIT();
+}
+
+//---------------------------------------------------------------------------
+K_UCHAR ThreadStats_GetCPULoad( void )
+{
+    K_ULONGLONG ullWindow;
+    K_ULONGLONG ullIdle = 0;
+    K_ULONG ulWindow;
+    K_ULONG ulIdle;
+
+    CS_ENTER();
+    ullWindow = Kernel_GetTime();
+#if KERNEL_USE_IDLE_FUNC
+    ullIdle = stIdleStats.ullRunTime;
+    if (g_pstCurrent == Kernel_GetIdleThread())
+    {
+        ullIdle += ullWindow - ullLastSwitch;
+    }
+#endif
+    ullWindow -= ullWindowStart;
+    CS_EXIT();
+
+    // Scale down until the percentage can be computed in 32 bits
+    while (ullWindow > 0x00FFFFFF)
+    {
+        ullWindow >>= 1;
+        ullIdle >>= 1;
+    }
+    ulWindow = (K_ULONG)ullWindow;
+    ulIdle = (K_ULONG)ullIdle;
+
+    if (!ulWindow || (ulIdle >= ulWindow))
+    {
+        return 0;
+    }
+    return (K_UCHAR)(100 - ((ulIdle * 100) / ulWindow));
+}
+
+#endif // KERNEL_USE_THREAD_STATS
@@ -55,13 +55,16 @@ void Timer_Start( Timer_t *pstTimer_, K_BOOL bRepeat_, K_ULONG ulIntervalMs_, Ti
     pstTimer_->ulTimerTolerance = 0;
     pstTimer_->pfCallback = pfCallback_;
     pstTimer_->pvData = pvData_;
+    // Only the one-shot bit is ours to set; the rest of the flags track the
+    // timer's state in the timer list, which TimerScheduler_Add() relies on
+    // when restarting a timer that's still queued.
     if (!bRepeat_)
     {
-        pstTimer_->ucFlags = TIMERLIST_FLAG_ONE_SHOT;
+        pstTimer_->ucFlags |= TIMERLIST_FLAG_ONE_SHOT;
     }
     else
     {
-        pstTimer_->ucFlags = 0;
+        pstTimer_->ucFlags &= ~TIMERLIST_FLAG_ONE_SHOT;
     }
     pstTimer_->pstOwner = Scheduler_GetCurrentThread();
     TimerScheduler_Add( pstTimer_ );
@@ -83,7 +86,8 @@ void Timer_Stop( Timer_t *pstTimer_ )
 //---------------------------------------------------------------------------
 void Timer_SetFlags ( Timer_t *pstTimer_, K_UCHAR ucFlags_)
 {
-    pstTimer_->ucFlags = ucFlags_;
+    pstTimer_->ucFlags = (pstTimer_->ucFlags & ~TIMERLIST_FLAG_ONE_SHOT)
+                       | (ucFlags_ & TIMERLIST_FLAG_ONE_SHOT);
 }
 
 //---------------------------------------------------------------------------
@@ -29,6 +29,7 @@ See license.txt for more information
 #include "threadport.h"
 #include "kerneldebug.h"
 #include "quantum.h"
+#include "eventtrace.h"
 
 //---------------------------------------------------------------------------
 #if defined __FILE_ID__
@@ -52,56 +53,417 @@ static K_ULONG ulNextWakeup;
 //! Whether or not the timer is active
 static K_UCHAR bTimerActive;
 
+//! Ticks elapsed since the timer list was initialized, as of the last expiry
+static volatile K_ULONG ulTickCount;
+
+//! Microseconds elapsed since the timer list was initialized, as of the last expiry
+static volatile K_ULONGLONG ullTimeUs;
+
+
+#if KERNEL_TIMERS_DELTA_LIST
+#if KERNEL_TIMERS_TICKLESS
+//! Ticks consumed from the current timer epoch while processing expiries
+static K_ULONG ulEpochOffset;
+
+//! Whether or not we're currently running TimerList_Process()
+static K_BOOL bInProcess;
+#endif
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief TimerList_IsLinked
+ *
+ * Check whether or not a timer is currently a member of the timer list.
+ *
+ * \param pstTimer_ Pointer to the timer to check
+ * \return true if the timer is in the list, false otherwise.
+ */
+static K_BOOL TimerList_IsLinked( Timer_t *pstTimer_ )
+{
+    return ( (LinkListNode_GetPrev( (LinkListNode_t*)pstTimer_ ) != NULL) ||
+             (LinkList_GetHead( (LinkList_t*)&stTimerList ) == (LinkListNode_t*)pstTimer_) );
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief TimerList_Insert
+ *
+ * Insert a timer into the sorted delta list.  The timer is placed behind
+ * all timers expiring at or before the same time, and its ulTimeLeft is
+ * converted into a delta relative to the timer ahead of it.
+ *
+ * \param pstTimer_ Pointer to the timer to insert
+ * \param ulTicks_  Ticks until expiry, relative to the head of the list
+ */
+static void TimerList_Insert( Timer_t *pstTimer_, K_ULONG ulTicks_ )
+{
+    LinkListNode_t *pstNode = (LinkListNode_t*)pstTimer_;
+    Timer_t *pstCurr = (Timer_t*)LinkList_GetHead( (LinkList_t*)&stTimerList );
+
+    // Skip over expired timers waiting on their callbacks at the head
+    while (pstCurr && (pstCurr->ucFlags & TIMERLIST_FLAG_CALLBACK))
+    {
+        pstCurr = (Timer_t*)LinkListNode_GetNext( (LinkListNode_t*)pstCurr );
+    }
+
+    // Walk the list, consuming the deltas of the timers ahead of us
+    while (pstCurr && (pstCurr->ulTimeLeft <= ulTicks_))
+    {
+        ulTicks_ -= pstCurr->ulTimeLeft;
+        pstCurr = (Timer_t*)LinkListNode_GetNext( (LinkListNode_t*)pstCurr );
+    }
+
+    pstTimer_->ulTimeLeft = ulTicks_;
+
+    if (!pstCurr)
+    {
+        // Expires after everything else - goes at the tail.
+        DoubleLinkList_Add( (DoubleLinkList_t*)&stTimerList, pstNode );
+        return;
+    }
+
+    // Insert ahead of pstCurr, and take our delta out of its delta.
+    pstCurr->ulTimeLeft -= ulTicks_;
+
+    pstNode->next = (LinkListNode_t*)pstCurr;
+    pstNode->prev = ((LinkListNode_t*)pstCurr)->prev;
+    if (pstNode->prev)
+    {
+        pstNode->prev->next = pstNode;
+    }
+    else
+    {
+        stTimerList.pstHead = pstNode;
+    }
+    ((LinkListNode_t*)pstCurr)->prev = pstNode;
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief TimerList_Unlink
+ *
+ * Remove a timer from the delta list, handing its remaining delta over to
+ * the timer behind it so that all other expiry times are preserved.
+ *
+ * \param pstTimer_ Pointer to the timer to remove
+ */
+static void TimerList_Unlink( Timer_t *pstTimer_ )
+{
+    Timer_t *pstNext = (Timer_t*)LinkListNode_GetNext( (LinkListNode_t*)pstTimer_ );
+
+    // Expired timers have no delta left to hand over
+    if (pstNext && !(pstTimer_->ucFlags & TIMERLIST_FLAG_CALLBACK))
+    {
+        pstNext->ulTimeLeft += pstTimer_->ulTimeLeft;
+    }
+    DoubleLinkList_Remove( (DoubleLinkList_t*)&stTimerList, (LinkListNode_t*)pstTimer_ );
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief TimerList_Elapse
+ *
+ * Advance the list by a number of elapsed ticks.  Only the timers that
+ * expire are visited - they are left at the head of the list and flagged
+ * for callback, with ulTimeLeft holding the number of ticks by which they
+ * were overdue.
+ *
+ * \param ulTicks_ Number of ticks that have elapsed
+ */
+static void TimerList_Elapse( K_ULONG ulTicks_ )
+{
+    Timer_t *pstNode = (Timer_t*)LinkList_GetHead( (LinkList_t*)&stTimerList );
+
+    while (pstNode && (pstNode->ulTimeLeft <= ulTicks_))
+    {
+        ulTicks_ -= pstNode->ulTimeLeft;
+        pstNode->ulTimeLeft = ulTicks_;
+        pstNode->ucFlags |= TIMERLIST_FLAG_CALLBACK;
+        pstNode = (Timer_t*)LinkListNode_GetNext( (LinkListNode_t*)pstNode );
+    }
+
+    if (pstNode)
+    {
+        pstNode->ulTimeLeft -= ulTicks_;
+    }
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief TimerList_RunExpired
+ *
+ * Pop expired timers from the head of the list, re-queue the periodic ones,
+ * and run their callbacks.  Timers added from within a callback are never
+ * flagged for callback, so they cannot be run until the next expiry.
+ */
+static void TimerList_RunExpired( void )
+{
+    Timer_t *pstNode = (Timer_t*)LinkList_GetHead( (LinkList_t*)&stTimerList );
+    K_ULONG ulTicks;
+
+    while (pstNode && (pstNode->ucFlags & TIMERLIST_FLAG_CALLBACK))
+    {
+        DoubleLinkList_Remove( (DoubleLinkList_t*)&stTimerList, (LinkListNode_t*)pstNode );
+        pstNode->ucFlags &= ~TIMERLIST_FLAG_CALLBACK;
+
+        if (pstNode->ucFlags & TIMERLIST_FLAG_ONE_SHOT)
+        {
+            // One-shot timers are done
+            pstNode->ucFlags |= TIMERLIST_FLAG_EXPIRED;
+            pstNode->ucFlags &= ~TIMERLIST_FLAG_ACTIVE;
+        }
+        else
+        {
+            // Re-queue periodic timers before the callback has a chance to
+            // stop them.  Take off any overdue time so they don't drift.
+            ulTicks = 0;
+            if (pstNode->ulInterval > pstNode->ulTimeLeft)
+            {
+                ulTicks = pstNode->ulInterval - pstNode->ulTimeLeft;
+            }
+            TimerList_Insert( pstNode, ulTicks );
+        }
+
+        // Run the callback. these callbacks must be very fast...
+#if KERNEL_USE_EVENT_TRACE
+        EventTrace_Timer( pstNode );
+#endif
+        pstNode->pfCallback( pstNode->pstOwner, pstNode->pvData );
+
+        pstNode = (Timer_t*)LinkList_GetHead( (LinkList_t*)&stTimerList );
+    }
+}
+
+#if KERNEL_TIMERS_TICKLESS
+//---------------------------------------------------------------------------
+/*!
+ * \brief TimerList_NextExpiry
+ *
+ * Compute the next hardware timer expiry from the head of the list.  The
+ * expiry may be deferred by the head timer's tolerance, but never past the
+ * expiry of the timer behind it.
+ *
+ * \return Ticks until the next expiry
+ */
+static K_ULONG TimerList_NextExpiry( void )
+{
+    Timer_t *pstHead = (Timer_t*)LinkList_GetHead( (LinkList_t*)&stTimerList );
+    Timer_t *pstNext = (Timer_t*)LinkListNode_GetNext( (LinkListNode_t*)pstHead );
+    K_ULONG ulTolerance = pstHead->ulTimerTolerance;
+
+    if (pstNext && (pstNext->ulTimeLeft < ulTolerance))
+    {
+        ulTolerance = pstNext->ulTimeLeft;
+    }
+    return pstHead->ulTimeLeft + ulTolerance;
+}
+#endif
 
 //---------------------------------------------------------------------------
 void TimerList_Init(void)
 {
-    bTimerActive = 0;    
-    ulNextWakeup = 0;    
-	LinkList_Init( (LinkList_t*)&stTimerList );
+    bTimerActive = 0;
+    ulNextWakeup = 0;
+    ulTickCount = 0;
+    ullTimeUs = 0;
+#if KERNEL_TIMERS_TICKLESS
+    ulEpochOffset = 0;
+    bInProcess = 0;
+
+    // The timer runs continuously so that the kernel's time base keeps
+    // advancing - with no timers pending, it wakes at the longest interval
+    // the hardware supports.
+    ulNextWakeup = KernelTimer_SetExpiry( MAX_TIMER_TICKS );
+#endif
+    LinkList_Init( (LinkList_t*)&stTimerList );
 }
 
 //---------------------------------------------------------------------------
 void TimerList_Add(Timer_t *pstListNode_)
 {
+    K_ULONG ulTicks;
+
+    CS_ENTER();
+
+    // Restarting a timer that's already queued - pull it out first.
+    if (TimerList_IsLinked( pstListNode_ ))
+    {
+        TimerList_Unlink( pstListNode_ );
+    }
+    LinkListNode_Clear( (LinkListNode_t*)pstListNode_ );
+
+    // Any expiry still waiting to be serviced belongs to the old interval.
+    pstListNode_->ucFlags &= ~(TIMERLIST_FLAG_CALLBACK | TIMERLIST_FLAG_EXPIRED);
+
+    ulTicks = pstListNode_->ulInterval;
+
 #if KERNEL_TIMERS_TICKLESS
-    K_BOOL bStart = 0;
-    K_LONG lDelta;
+    if (ulTicks < MIN_TICKS)
+    {
+        ulTicks = MIN_TICKS;
+    }
+
+    // The list is relative to the start of the current epoch; account
+    // for the time that has already elapsed within it.
+    ulTicks += (K_ULONG)KernelTimer_Read() - ulEpochOffset;
+    TimerList_Insert( pstListNode_, ulTicks );
+
+    // New head of the list?  Bring the expiry forward.
+    if (!bInProcess &&
+        ((LinkListNode_t*)pstListNode_ == LinkList_GetHead( (LinkList_t*)&stTimerList )) &&
+        (ulTicks < ulNextWakeup))
+    {
+        ulNextWakeup = KernelTimer_SetExpiry( TimerList_NextExpiry() );
+    }
+#else
+    TimerList_Insert( pstListNode_, ulTicks );
 #endif
 
+    // Set the timer as active.
+    pstListNode_->ucFlags |= TIMERLIST_FLAG_ACTIVE;
+    CS_EXIT();
+}
+
+//---------------------------------------------------------------------------
+void TimerList_Remove(Timer_t *pstLinkListNode_)
+{
     CS_ENTER();
 
-#if KERNEL_TIMERS_TICKLESS
-    if (LinkList_GetHead( (LinkList_t*)&stTimerList ) == NULL)
+    // Timers may be stopped after they've already expired and been removed.
+    // In tickless builds the hardware expiry is left as-is; if it was this
+    // timer's, the interrupt will simply find nothing to do.
+    if (TimerList_IsLinked( pstLinkListNode_ ))
     {
-        bStart = 1;
+        TimerList_Unlink( pstLinkListNode_ );
     }
+    pstLinkListNode_->ucFlags &= ~(TIMERLIST_FLAG_ACTIVE | TIMERLIST_FLAG_CALLBACK);
+
+    CS_EXIT();
+}
+
+//---------------------------------------------------------------------------
+void TimerList_Process(void)
+{
+#if KERNEL_TIMERS_TICKLESS
+    K_ULONG ulElapsed;
+    K_ULONG ulOvertime;
+    K_BOOL bContinue;
+    Timer_t *pstHead;
 #endif
 
-    LinkListNode_Clear( (LinkListNode_t*)pstListNode_ );
-    DoubleLinkList_Add( (DoubleLinkList_t*)&stTimerList, (LinkListNode_t*)pstListNode_);
-    
-    // Set the initial timer value
-    pstListNode_->ulTimeLeft = pstListNode_->ulInterval;    
+#if KERNEL_USE_QUANTUM
+    Quantum_SetInTimer();
+#endif
 
 #if KERNEL_TIMERS_TICKLESS
-    if (!bStart)
+    // The epoch that just ended counts towards the kernel's time base.
+    ulTickCount += ulNextWakeup;
+    ullTimeUs += TICKS_TO_USECONDS( ulNextWakeup );
+
+    // Clear the timer and its expiry time - keep it running though
+    KernelTimer_ClearExpiry();
+    bInProcess = 1;
+
+    ulEpochOffset = 0;
+    ulElapsed = ulNextWakeup;
+    do
     {
-        // If the new interval is less than the amount of time remaining...
-        lDelta = KernelTimer_TimeToExpiry() - pstListNode_->ulInterval;
-    
-        if (lDelta > 0)
+        TimerList_Elapse( ulElapsed );
+        TimerList_RunExpired();
+
+        // If more timers have come due while we were running callbacks,
+        // consume the overtime and go around again.
+        bContinue = 0;
+        pstHead = (Timer_t*)LinkList_GetHead( (LinkList_t*)&stTimerList );
+        if (pstHead)
         {
-            // Set the new expiry time on the timer.
-            ulNextWakeup = KernelTimer_SubtractExpiry((K_ULONG)lDelta);
+            ulOvertime = KernelTimer_GetOvertime();
+            ulElapsed = ulOvertime - ulEpochOffset;
+            if (pstHead->ulTimeLeft <= ulElapsed)
+            {
+                ulEpochOffset = ulOvertime;
+                bContinue = 1;
+            }
         }
+    } while (bContinue);
+
+    bInProcess = 0;
+
+    pstHead = (Timer_t*)LinkList_GetHead( (LinkList_t*)&stTimerList );
+    if (!pstHead)
+    {
+        // Nothing left to do - keep the time base running on the longest
+        // possible epoch.
+        ulNextWakeup = KernelTimer_SetExpiry( MAX_TIMER_TICKS );
+    }
+    else
+    {
+        // Re-base the list on the start of the epoch, and program the expiry.
+        pstHead->ulTimeLeft += ulEpochOffset;
+        ulEpochOffset = 0;
+        ulNextWakeup = KernelTimer_SetExpiry( TimerList_NextExpiry() );
     }
-    else    
+#else
+    ulTickCount++;
+    ullTimeUs += TICKS_TO_USECONDS( 1 );
+
+    // Only the head of the list needs to be touched on a tick.
+    TimerList_Elapse( 1 );
+    TimerList_RunExpired();
+#endif
+
+#if KERNEL_USE_QUANTUM
+    Quantum_ClearInTimer();
+#endif
+}
+
+#else // !KERNEL_TIMERS_DELTA_LIST
+
+//---------------------------------------------------------------------------
+void TimerList_Init(void)
+{
+    bTimerActive = 0;    
+    ulNextWakeup = 0;    
+    ulTickCount = 0;
+    ullTimeUs = 0;
+#if KERNEL_TIMERS_TICKLESS
+    // As with the delta list, the timer runs continuously so that the
+    // kernel's time base keeps advancing while no timers are pending.
+    ulNextWakeup = KernelTimer_SetExpiry( MAX_TIMER_TICKS );
+#endif
+	LinkList_Init( (LinkList_t*)&stTimerList );
+}
+
+//---------------------------------------------------------------------------
+void TimerList_Add(Timer_t *pstListNode_)
+{
+#if KERNEL_TIMERS_TICKLESS
+    K_LONG lDelta;
+#endif
+
+    CS_ENTER();
+
+    LinkListNode_Clear( (LinkListNode_t*)pstListNode_ );
+    pstListNode_->ucFlags &= ~(TIMERLIST_FLAG_CALLBACK | TIMERLIST_FLAG_EXPIRED);
+    DoubleLinkList_Add( (DoubleLinkList_t*)&stTimerList, (LinkListNode_t*)pstListNode_);
+    
+#if KERNEL_TIMERS_TICKLESS
+    // Set the initial timer value.  The timer never stops, so the time left
+    // is counted from the start of the current timer period, like the
+    // wakeup time that TimerList_Process() subtracts from it.
+    pstListNode_->ulTimeLeft = pstListNode_->ulInterval + (K_ULONG)KernelTimer_Read();
+
+    // If the new interval is less than the amount of time remaining...
+    lDelta = KernelTimer_TimeToExpiry() - pstListNode_->ulInterval;
+
+    if (lDelta > 0)
     {
-        ulNextWakeup = pstListNode_->ulInterval;
-        KernelTimer_SetExpiry(ulNextWakeup);
-        KernelTimer_Start();
+        // Set the new expiry time on the timer.
+        ulNextWakeup = KernelTimer_SubtractExpiry((K_ULONG)lDelta);
     }
+#else
+    // Set the initial timer value
+    pstListNode_->ulTimeLeft = pstListNode_->ulInterval;    
 #endif
 
     // Set the timer as active.
@@ -116,12 +478,8 @@ void TimerList_Remove(Timer_t *pstLinkListNode_)
     
     DoubleLinkList_Remove( (DoubleLinkList_t*)&stTimerList, (LinkListNode_t*)pstLinkListNode_ );
 
-#if KERNEL_TIMERS_TICKLESS
-    if ( LinkList_GetHead( (LinkList_t*)&stTimerList ) == NULL )
-    {
-        KernelTimer_Stop();
-    }
-#endif
+    // In tickless builds the timer is left running, even with the list
+    // empty - TimerList_Process() re-arms it at the longest interval.
     
     CS_EXIT();
 }
@@ -142,10 +500,16 @@ void TimerList_Process(void)
     Quantum_SetInTimer();
 #endif
 #if KERNEL_TIMERS_TICKLESS
+    ulTickCount += ulNextWakeup;
+    ullTimeUs += TICKS_TO_USECONDS( ulNextWakeup );
+
     // Clear the timer and its expiry time - keep it running though
     KernelTimer_ClearExpiry();
     do 
     {        
+#else
+    ulTickCount++;
+    ullTimeUs += TICKS_TO_USECONDS( 1 );
 #endif
         pstNode = (Timer_t*)LinkList_GetHead( (LinkList_t*)&stTimerList );
         pstPrev = NULL;
@@ -222,6 +586,9 @@ void TimerList_Process(void)
             if (pstNode->ucFlags & TIMERLIST_FLAG_CALLBACK)
             {
                 // Run the callback. these callbacks must be very fast...
+#if KERNEL_USE_EVENT_TRACE
+                EventTrace_Timer( pstNode );
+#endif
                 pstNode->pfCallback( pstNode->pstOwner, pstNode->pvData );
                 pstNode->ucFlags &= ~TIMERLIST_FLAG_CALLBACK;
             
@@ -255,19 +622,11 @@ void TimerList_Process(void)
 
     } while (bContinue);
 
-    // This timer elapsed, but there's nothing more to do...
-    // Turn the timer off.
-    if (ulNewExpiry >= MAX_TIMER_TICKS)
-    {
-        KernelTimer_Stop();
-    }
-    else 
-    {
-        // Update the timer with the new "Next Wakeup" value, plus whatever
-        // overtime has accumulated since the last time we called this handler
-
-        ulNextWakeup = KernelTimer_SetExpiry(ulNewExpiry + ulOvertime);
-    }
+    // Update the timer with the new "Next Wakeup" value, plus whatever
+    // overtime has accumulated since the last time we called this handler.
+    // With no timers left, this is the longest interval the hardware
+    // supports - the timer keeps running to keep the time base advancing.
+    ulNextWakeup = KernelTimer_SetExpiry(ulNewExpiry + ulOvertime);
 #endif
 
 #if KERNEL_USE_QUANTUM
@@ -275,5 +634,34 @@ void TimerList_Process(void)
 #endif
 }
 
+#endif // KERNEL_TIMERS_DELTA_LIST
+
+//---------------------------------------------------------------------------
+K_ULONG TimerList_GetTicks(void)
+{
+    K_ULONG ulTicks;
+
+    CS_ENTER();
+    ulTicks = ulTickCount;
+#if KERNEL_TIMERS_TICKLESS
+    // Add the time elapsed within the current epoch
+    ulTicks += KernelTimer_Read();
+#endif
+    CS_EXIT();
+
+    return ulTicks;
+}
+
+//---------------------------------------------------------------------------
+K_ULONGLONG TimerList_GetTime(void)
+{
+    K_ULONGLONG ullTime;
+
+    CS_ENTER();
+    ullTime = ullTimeUs + KernelTimer_ReadUs();
+    CS_EXIT();
+
+    return ullTime;
+}
 
 #endif //KERNEL_USE_TIMERS
@@ -50,3 +50,15 @@ void TimerScheduler_Process( void )
 {
     TimerList_Process( );
 }
+
+//---------------------------------------------------------------------------
+K_ULONG TimerScheduler_GetTicks( void )
+{
+    return TimerList_GetTicks( );
+}
+
+//---------------------------------------------------------------------------
+K_ULONGLONG TimerScheduler_GetTime( void )
+{
+    return TimerList_GetTime( );
+}
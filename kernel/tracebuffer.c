@@ -22,6 +22,35 @@ See license.txt for more information
 #include "writebuf16.h"
 #include "kerneldebug.h"
 
+#if KERNEL_USE_DEBUG
+
+//---------------------------------------------------------------------------
+volatile K_UCHAR g_aucTraceMask[ TRACE_MODULES ];
+
+//---------------------------------------------------------------------------
+void TraceBuffer_SetMask( K_USHORT usModule_, K_UCHAR ucLevels_ )
+{
+    g_aucTraceMask[ TRACE_MODULE( usModule_ ) ] = ucLevels_;
+}
+
+//---------------------------------------------------------------------------
+K_UCHAR TraceBuffer_GetMask( K_USHORT usModule_ )
+{
+    return g_aucTraceMask[ TRACE_MODULE( usModule_ ) ];
+}
+
+//---------------------------------------------------------------------------
+void TraceBuffer_SetMaskAll( K_UCHAR ucLevels_ )
+{
+    K_UCHAR i;
+    for (i = 0; i < TRACE_MODULES; i++)
+    {
+        g_aucTraceMask[i] = ucLevels_;
+    }
+}
+
+#endif // KERNEL_USE_DEBUG
+
 #if KERNEL_USE_DEBUG && !KERNEL_AWARE_SIMULATION
 
 //---------------------------------------------------------------------------
@@ -22,7 +22,7 @@ See license.txt for more information
 #include "kerneldebug.h"
 #include "threadport.h"
 
-#if KERNEL_USE_DEBUG && !KERNEL_AWARE_SIMULATION
+#if (KERNEL_USE_DEBUG && !KERNEL_AWARE_SIMULATION) || KERNEL_USE_EVENT_TRACE
 //---------------------------------------------------------------------------
 void WriteBuffer16_SetBuffers( WriteBuffer16_t *pstBuffer_, K_USHORT *pusData_, K_USHORT usSize_ )
 {
@@ -145,4 +145,31 @@ void WriteBuffer16_WriteVector( WriteBuffer16_t *pstBuffer_, K_USHORT **ppusBuf_
 	}
 }
 
+//---------------------------------------------------------------------------
+void WriteBuffer16_Flush( WriteBuffer16_t *pstBuffer_ )
+{
+    K_USHORT usHalf = pstBuffer_->usSize >> 1;
+    K_USHORT usStart = 0;
+
+    if (pstBuffer_->usHead >= usHalf)
+    {
+        usStart = usHalf;
+    }
+
+    // Nothing written since the last callback
+    if (pstBuffer_->usHead == usStart)
+    {
+        return;
+    }
+
+    if (pstBuffer_->pfCallback)
+    {
+        pstBuffer_->pfCallback( &pstBuffer_->pusData[ usStart ], pstBuffer_->usHead - usStart );
+    }
+
+    // Skip the rest of this half - the next half-full or rollover callback
+    // then only covers data written after the flush.
+    pstBuffer_->usHead = (usStart + usHalf) % pstBuffer_->usSize;
+}
+
 #endif
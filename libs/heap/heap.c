@@ -0,0 +1,487 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   heap.c
+
+    \brief  Real-time heap with bounded-time allocation and free
+*/
+
+#include <stddef.h>
+
+#include "kerneltypes.h"
+#include "mark3cfg.h"
+#include "kerneldebug.h"
+#include "threadport.h"
+#include "mutex.h"
+#include "heap.h"
+
+//---------------------------------------------------------------------------
+#define HEAP_ALIGN          ((K_ADDR)1 << HEAP_ALIGN_LOG2)
+#define HEAP_BLOCK_FREE     ((K_ADDR)1)
+
+//! Bytes of header preceding the payload of every block
+#define HEAP_OVERHEAD       ((K_ADDR)offsetof(HeapBlock_t, pstNextFree))
+
+//! Smallest payload - a free block must be able to hold its free-list links
+#define HEAP_MIN_PAYLOAD    ((K_ADDR)(2 * sizeof(HeapBlock_t*)))
+
+//! Blocks smaller than this are binned linearly in the first range
+#define HEAP_SMALL_BLOCK    ((K_ADDR)1 << HEAP_FL_INDEX_SHIFT)
+
+//! Largest payload the bin table can hold
+#define HEAP_MAX_BLOCK      (((K_ADDR)1 << HEAP_FL_INDEX_MAX) - HEAP_ALIGN)
+
+#define HEAP_BLOCK_SIZE(x)  ((x)->tSize & ~HEAP_BLOCK_FREE)
+#define HEAP_IS_FREE(x)     ((x)->tSize & HEAP_BLOCK_FREE)
+
+//---------------------------------------------------------------------------
+/*!
+ * Index of the most-significant set bit in each 4-bit value.  Neither of
+ * the supported cores has a count-leading-zeros instruction.
+ */
+static const K_UCHAR aucHeapFLS[16] = { 0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3 };
+
+//---------------------------------------------------------------------------
+/*!
+ * Return the index of the most-significant set bit in a non-zero word.
+ * Runs in at most one iteration per nibble of the address type.
+ */
+static K_UCHAR Heap_FLS( K_ADDR tWord_ )
+{
+    K_UCHAR ucShift = (sizeof(K_ADDR) * 8) - 4;
+    while (ucShift && !(tWord_ >> ucShift))
+    {
+        ucShift -= 4;
+    }
+    return ucShift + aucHeapFLS[ (tWord_ >> ucShift) & 0x0F ];
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * Return the index of the least-significant set bit in a non-zero word.
+ */
+static K_UCHAR Heap_FFS( K_ADDR tWord_ )
+{
+    return Heap_FLS( tWord_ & (~tWord_ + 1) );
+}
+
+//---------------------------------------------------------------------------
+static void *Heap_ToData( HeapBlock_t *pstBlock_ )
+{
+    return (K_UCHAR*)pstBlock_ + HEAP_OVERHEAD;
+}
+
+//---------------------------------------------------------------------------
+static HeapBlock_t *Heap_FromData( void *pvData_ )
+{
+    return (HeapBlock_t*)((K_UCHAR*)pvData_ - HEAP_OVERHEAD);
+}
+
+//---------------------------------------------------------------------------
+static HeapBlock_t *Heap_NextPhys( HeapBlock_t *pstBlock_ )
+{
+    return (HeapBlock_t*)((K_UCHAR*)Heap_ToData( pstBlock_ ) + HEAP_BLOCK_SIZE( pstBlock_ ));
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * Compute the bin that holds free blocks of the given size.
+ */
+static void Heap_MappingInsert( K_ADDR tSize_, K_UCHAR *pucFL_, K_UCHAR *pucSL_ )
+{
+    K_UCHAR ucFL;
+    K_UCHAR ucSL;
+
+    if (tSize_ < HEAP_SMALL_BLOCK)
+    {
+        ucFL = 0;
+        ucSL = (K_UCHAR)(tSize_ / (HEAP_SMALL_BLOCK / HEAP_SL_INDEX_COUNT));
+    }
+    else
+    {
+        ucFL = Heap_FLS( tSize_ );
+        ucSL = (K_UCHAR)(tSize_ >> (ucFL - HEAP_SL_INDEX_COUNT_LOG2)) ^ HEAP_SL_INDEX_COUNT;
+        ucFL -= (HEAP_FL_INDEX_SHIFT - 1);
+    }
+    *pucFL_ = ucFL;
+    *pucSL_ = ucSL;
+}
+
+//---------------------------------------------------------------------------
+/*!
+ * Compute the first bin in which every block is large enough to satisfy a
+ * request of the given size, by rounding up to the next bin boundary.
+ */
+static void Heap_MappingSearch( K_ADDR tSize_, K_UCHAR *pucFL_, K_UCHAR *pucSL_ )
+{
+    if (tSize_ >= HEAP_SMALL_BLOCK)
+    {
+        tSize_ += ((K_ADDR)1 << (Heap_FLS( tSize_ ) - HEAP_SL_INDEX_COUNT_LOG2)) - 1;
+    }
+    Heap_MappingInsert( tSize_, pucFL_, pucSL_ );
+}
+
+//---------------------------------------------------------------------------
+static void Heap_InsertFree( Heap_t *pstHeap_, HeapBlock_t *pstBlock_ )
+{
+    K_UCHAR ucFL;
+    K_UCHAR ucSL;
+    HeapBlock_t *pstHead;
+
+    Heap_MappingInsert( HEAP_BLOCK_SIZE( pstBlock_ ), &ucFL, &ucSL );
+
+    pstHead = pstHeap_->apstFree[ucFL][ucSL];
+    pstBlock_->pstNextFree = pstHead;
+    pstBlock_->pstPrevFree = NULL;
+    if (pstHead)
+    {
+        pstHead->pstPrevFree = pstBlock_;
+    }
+    pstHeap_->apstFree[ucFL][ucSL] = pstBlock_;
+
+    pstHeap_->usFLBitmap |= (K_USHORT)(1 << ucFL);
+    pstHeap_->aucSLBitmap[ucFL] |= (K_UCHAR)(1 << ucSL);
+
+    pstBlock_->tSize |= HEAP_BLOCK_FREE;
+}
+
+//---------------------------------------------------------------------------
+static void Heap_RemoveFree( Heap_t *pstHeap_, HeapBlock_t *pstBlock_ )
+{
+    K_UCHAR ucFL;
+    K_UCHAR ucSL;
+    HeapBlock_t *pstNext = pstBlock_->pstNextFree;
+    HeapBlock_t *pstPrev = pstBlock_->pstPrevFree;
+
+    Heap_MappingInsert( HEAP_BLOCK_SIZE( pstBlock_ ), &ucFL, &ucSL );
+
+    if (pstNext)
+    {
+        pstNext->pstPrevFree = pstPrev;
+    }
+    if (pstPrev)
+    {
+        pstPrev->pstNextFree = pstNext;
+    }
+    else
+    {
+        pstHeap_->apstFree[ucFL][ucSL] = pstNext;
+        if (!pstNext)
+        {
+            // Bin is now empty
+            pstHeap_->aucSLBitmap[ucFL] &= (K_UCHAR)~(1 << ucSL);
+            if (!pstHeap_->aucSLBitmap[ucFL])
+            {
+                pstHeap_->usFLBitmap &= (K_USHORT)~(1 << ucFL);
+            }
+        }
+    }
+
+    pstBlock_->tSize &= ~HEAP_BLOCK_FREE;
+}
+
+//---------------------------------------------------------------------------
+static void *Heap_Alloc_i( Heap_t *pstHeap_, K_ADDR tSize_ )
+{
+    K_UCHAR ucFL;
+    K_UCHAR ucSL;
+    K_UCHAR ucMap;
+    K_USHORT usMap;
+    K_ADDR tRemain;
+    HeapBlock_t *pstBlock;
+
+    if (!tSize_ || (tSize_ > HEAP_MAX_BLOCK))
+    {
+        pstHeap_->usFailures++;
+        return NULL;
+    }
+
+    tSize_ = (tSize_ + HEAP_ALIGN - 1) & ~(HEAP_ALIGN - 1);
+    if (tSize_ < HEAP_MIN_PAYLOAD)
+    {
+        tSize_ = HEAP_MIN_PAYLOAD;
+    }
+
+    // Find the smallest non-empty bin in which every block fits the request:
+    // first within the same size range, then in the next non-empty range.
+    Heap_MappingSearch( tSize_, &ucFL, &ucSL );
+    ucMap = 0;
+    if (ucFL < HEAP_FL_INDEX_COUNT)
+    {
+        ucMap = pstHeap_->aucSLBitmap[ucFL] & (K_UCHAR)(0xFF << ucSL);
+        if (!ucMap)
+        {
+            usMap = pstHeap_->usFLBitmap & (K_USHORT)(0xFFFF << (ucFL + 1));
+            if (usMap)
+            {
+                ucFL = Heap_FFS( usMap );
+                ucMap = pstHeap_->aucSLBitmap[ucFL];
+            }
+        }
+    }
+    if (!ucMap)
+    {
+        pstHeap_->usFailures++;
+        return NULL;
+    }
+    ucSL = Heap_FFS( ucMap );
+
+    pstBlock = pstHeap_->apstFree[ucFL][ucSL];
+    Heap_RemoveFree( pstHeap_, pstBlock );
+
+    // Split off the tail of the block if it's big enough to be useful
+    tRemain = HEAP_BLOCK_SIZE( pstBlock ) - tSize_;
+    if (tRemain >= (HEAP_OVERHEAD + HEAP_MIN_PAYLOAD))
+    {
+        HeapBlock_t *pstRemain = (HeapBlock_t*)((K_UCHAR*)Heap_ToData( pstBlock ) + tSize_);
+
+        pstRemain->pstPrevPhys = pstBlock;
+        pstRemain->tSize = tRemain - HEAP_OVERHEAD;
+        pstBlock->tSize = tSize_;
+        Heap_NextPhys( pstRemain )->pstPrevPhys = pstRemain;
+
+        Heap_InsertFree( pstHeap_, pstRemain );
+    }
+
+    pstHeap_->tUsed += HEAP_BLOCK_SIZE( pstBlock ) + HEAP_OVERHEAD;
+    if (pstHeap_->tUsed > pstHeap_->tHighWater)
+    {
+        pstHeap_->tHighWater = pstHeap_->tUsed;
+    }
+
+    return Heap_ToData( pstBlock );
+}
+
+//---------------------------------------------------------------------------
+static void Heap_Free_i( Heap_t *pstHeap_, void *pvData_ )
+{
+    HeapBlock_t *pstBlock = Heap_FromData( pvData_ );
+    HeapBlock_t *pstNeighbour;
+
+    KERNEL_ASSERT( !HEAP_IS_FREE( pstBlock ) );
+
+    pstHeap_->tUsed -= HEAP_BLOCK_SIZE( pstBlock ) + HEAP_OVERHEAD;
+
+    // Merge with the following block.  The arena ends with a zero-sized
+    // sentinel block that is never free, so there is always a successor.
+    pstNeighbour = Heap_NextPhys( pstBlock );
+    if (HEAP_IS_FREE( pstNeighbour ))
+    {
+        Heap_RemoveFree( pstHeap_, pstNeighbour );
+        pstBlock->tSize += HEAP_BLOCK_SIZE( pstNeighbour ) + HEAP_OVERHEAD;
+        Heap_NextPhys( pstBlock )->pstPrevPhys = pstBlock;
+    }
+
+    // Merge with the preceding block
+    pstNeighbour = pstBlock->pstPrevPhys;
+    if (pstNeighbour && HEAP_IS_FREE( pstNeighbour ))
+    {
+        Heap_RemoveFree( pstHeap_, pstNeighbour );
+        pstNeighbour->tSize += HEAP_BLOCK_SIZE( pstBlock ) + HEAP_OVERHEAD;
+        Heap_NextPhys( pstNeighbour )->pstPrevPhys = pstNeighbour;
+        pstBlock = pstNeighbour;
+    }
+
+    Heap_InsertFree( pstHeap_, pstBlock );
+}
+
+//---------------------------------------------------------------------------
+void Heap_Init( Heap_t *pstHeap_, void *pvArena_, K_ADDR tSize_, HeapLock_t eLock_ )
+{
+    K_UCHAR *pucArena;
+    K_ADDR tBlock;
+    K_UCHAR i;
+    K_UCHAR j;
+    HeapBlock_t *pstSentinel;
+
+    KERNEL_ASSERT( pvArena_ );
+    KERNEL_ASSERT( eLock_ < HEAP_LOCK_MODES );
+#if !KERNEL_USE_MUTEX
+    KERNEL_ASSERT( eLock_ != HEAP_LOCK_MUTEX );
+#endif
+
+    // Align the start of the arena, and trim the end to match.
+    tBlock = (K_ADDR)(0 - (K_ADDR)pvArena_) & (HEAP_ALIGN - 1);
+    pucArena = (K_UCHAR*)pvArena_ + tBlock;
+    tSize_ -= tBlock;
+    tSize_ &= ~(HEAP_ALIGN - 1);
+
+    KERNEL_ASSERT( tSize_ >= ((2 * HEAP_OVERHEAD) + HEAP_MIN_PAYLOAD) );
+
+    pstHeap_->usFLBitmap = 0;
+    for (i = 0; i < HEAP_FL_INDEX_COUNT; i++)
+    {
+        pstHeap_->aucSLBitmap[i] = 0;
+        for (j = 0; j < HEAP_SL_INDEX_COUNT; j++)
+        {
+            pstHeap_->apstFree[i][j] = NULL;
+        }
+    }
+
+    // The arena holds a single free block, followed by a zero-sized
+    // allocated sentinel that stops merges at the end of the arena.
+    tBlock = tSize_ - (2 * HEAP_OVERHEAD);
+    if (tBlock > HEAP_MAX_BLOCK)
+    {
+        tBlock = HEAP_MAX_BLOCK;
+    }
+
+    pstHeap_->pstFirst = (HeapBlock_t*)pucArena;
+    pstHeap_->pstFirst->pstPrevPhys = NULL;
+    pstHeap_->pstFirst->tSize = tBlock;
+
+    pstSentinel = Heap_NextPhys( pstHeap_->pstFirst );
+    pstSentinel->pstPrevPhys = pstHeap_->pstFirst;
+    pstSentinel->tSize = 0;
+
+    Heap_InsertFree( pstHeap_, pstHeap_->pstFirst );
+
+    pstHeap_->tTotal = tBlock + HEAP_OVERHEAD;
+    pstHeap_->tUsed = 0;
+    pstHeap_->tHighWater = 0;
+    pstHeap_->usFailures = 0;
+
+    pstHeap_->eLock = eLock_;
+#if KERNEL_USE_MUTEX
+    if (eLock_ == HEAP_LOCK_MUTEX)
+    {
+        Mutex_Init( &(pstHeap_->stMutex) );
+    }
+#endif
+}
+
+//---------------------------------------------------------------------------
+void *Heap_Alloc( Heap_t *pstHeap_, K_ADDR tSize_ )
+{
+    void *pvRet;
+
+    if (pstHeap_->eLock == HEAP_LOCK_CRITICAL)
+    {
+        CS_ENTER();
+        pvRet = Heap_Alloc_i( pstHeap_, tSize_ );
+        CS_EXIT();
+    }
+#if KERNEL_USE_MUTEX
+    else if (pstHeap_->eLock == HEAP_LOCK_MUTEX)
+    {
+        Mutex_Claim( &(pstHeap_->stMutex) );
+        pvRet = Heap_Alloc_i( pstHeap_, tSize_ );
+        Mutex_Release( &(pstHeap_->stMutex) );
+    }
+#endif
+    else
+    {
+        pvRet = Heap_Alloc_i( pstHeap_, tSize_ );
+    }
+    return pvRet;
+}
+
+//---------------------------------------------------------------------------
+void Heap_Free( Heap_t *pstHeap_, void *pvData_ )
+{
+    if (!pvData_)
+    {
+        return;
+    }
+
+    if (pstHeap_->eLock == HEAP_LOCK_CRITICAL)
+    {
+        CS_ENTER();
+        Heap_Free_i( pstHeap_, pvData_ );
+        CS_EXIT();
+    }
+#if KERNEL_USE_MUTEX
+    else if (pstHeap_->eLock == HEAP_LOCK_MUTEX)
+    {
+        Mutex_Claim( &(pstHeap_->stMutex) );
+        Heap_Free_i( pstHeap_, pvData_ );
+        Mutex_Release( &(pstHeap_->stMutex) );
+    }
+#endif
+    else
+    {
+        Heap_Free_i( pstHeap_, pvData_ );
+    }
+}
+
+//---------------------------------------------------------------------------
+K_ADDR Heap_GetBlockSize( void *pvData_ )
+{
+    return HEAP_BLOCK_SIZE( Heap_FromData( pvData_ ) );
+}
+
+//---------------------------------------------------------------------------
+static void Heap_GetStats_i( Heap_t *pstHeap_, HeapStats_t *pstStats_ )
+{
+    HeapBlock_t *pstBlock = pstHeap_->pstFirst;
+
+    pstStats_->tFreeBytes = 0;
+    pstStats_->tLargestFree = 0;
+    pstStats_->usFreeBlocks = 0;
+    pstStats_->usUsedBlocks = 0;
+
+    // Walk the arena up to the sentinel
+    while (HEAP_BLOCK_SIZE( pstBlock ))
+    {
+        if (HEAP_IS_FREE( pstBlock ))
+        {
+            pstStats_->tFreeBytes += HEAP_BLOCK_SIZE( pstBlock );
+            pstStats_->usFreeBlocks++;
+            if (HEAP_BLOCK_SIZE( pstBlock ) > pstStats_->tLargestFree)
+            {
+                pstStats_->tLargestFree = HEAP_BLOCK_SIZE( pstBlock );
+            }
+        }
+        else
+        {
+            pstStats_->usUsedBlocks++;
+        }
+        pstBlock = Heap_NextPhys( pstBlock );
+    }
+
+    pstStats_->tUsedBytes = pstHeap_->tUsed;
+    pstStats_->tHighWater = pstHeap_->tHighWater;
+    pstStats_->usFailures = pstHeap_->usFailures;
+
+    pstStats_->ucFragmentation = 0;
+    if (pstStats_->tFreeBytes)
+    {
+        pstStats_->ucFragmentation = (K_UCHAR)(100 -
+            (((K_ULONG)pstStats_->tLargestFree * 100) / pstStats_->tFreeBytes));
+    }
+}
+
+//---------------------------------------------------------------------------
+void Heap_GetStats( Heap_t *pstHeap_, HeapStats_t *pstStats_ )
+{
+    if (pstHeap_->eLock == HEAP_LOCK_CRITICAL)
+    {
+        CS_ENTER();
+        Heap_GetStats_i( pstHeap_, pstStats_ );
+        CS_EXIT();
+    }
+#if KERNEL_USE_MUTEX
+    else if (pstHeap_->eLock == HEAP_LOCK_MUTEX)
+    {
+        Mutex_Claim( &(pstHeap_->stMutex) );
+        Heap_GetStats_i( pstHeap_, pstStats_ );
+        Mutex_Release( &(pstHeap_->stMutex) );
+    }
+#endif
+    else
+    {
+        Heap_GetStats_i( pstHeap_, pstStats_ );
+    }
+}
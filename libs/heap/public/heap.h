@@ -0,0 +1,223 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   heap.h
+
+    \brief  Real-time heap with bounded-time allocation and free
+
+    This module implements a two-level segregated-fit (TLSF) allocator.
+    Free blocks are binned by size into a two-level table: the first level
+    selects a power-of-two size range, and the second level splits each
+    range into HEAP_SL_INDEX_COUNT linear subdivisions.  A bitmap for each
+    level records which bins are non-empty, so a suitable block is found
+    with two bit-scans, and a freed block is merged with its physical
+    neighbours in constant time.  Neither operation depends on the number
+    of blocks in the heap.
+
+    Allocation rounds requests up to the next bin boundary ("good fit"),
+    which bounds internal fragmentation to 1/HEAP_SL_INDEX_COUNT of the
+    block size.
+
+    Each heap selects how it is protected from concurrent access:
+    - HEAP_LOCK_NONE - no locking; the heap is owned by a single context.
+    - HEAP_LOCK_MUTEX - thread-safe; callers serialize on a kernel mutex,
+      so interrupts are never disabled.  Not usable from interrupts.
+    - HEAP_LOCK_CRITICAL - ISR-safe; each operation runs in a (bounded)
+      critical section, so the heap may be used from interrupts as well
+      as threads.
+*/
+
+#ifndef __HEAP_H__
+#define __HEAP_H__
+
+#include "kerneltypes.h"
+#include "mark3cfg.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//---------------------------------------------------------------------------
+/*!
+    Heap geometry.  Blocks are aligned to the native pointer size, and the
+    largest block the heap can manage is (2^HEAP_FL_INDEX_MAX - alignment)
+    bytes.  Any part of the arena beyond that is left unused.
+*/
+#if !defined(HEAP_ALIGN_LOG2)
+    #if defined(AVR)
+        #define HEAP_ALIGN_LOG2         (1)
+    #else
+        #define HEAP_ALIGN_LOG2         (2)
+    #endif
+#endif
+
+#if !defined(HEAP_FL_INDEX_MAX)
+    #if defined(AVR)
+        #define HEAP_FL_INDEX_MAX       (12)
+    #else
+        #define HEAP_FL_INDEX_MAX       (16)
+    #endif
+#endif
+
+//! log2 of the number of second-level subdivisions per size range (max 3)
+#if !defined(HEAP_SL_INDEX_COUNT_LOG2)
+    #define HEAP_SL_INDEX_COUNT_LOG2    (2)
+#endif
+
+#define HEAP_SL_INDEX_COUNT     (1 << HEAP_SL_INDEX_COUNT_LOG2)
+#define HEAP_FL_INDEX_SHIFT     (HEAP_SL_INDEX_COUNT_LOG2 + HEAP_ALIGN_LOG2)
+#define HEAP_FL_INDEX_COUNT     (HEAP_FL_INDEX_MAX - HEAP_FL_INDEX_SHIFT + 1)
+
+#if (HEAP_FL_INDEX_COUNT > 16) || (HEAP_SL_INDEX_COUNT_LOG2 > 3)
+    #error "Heap bitmaps are too small for the configured geometry"
+#endif
+
+//---------------------------------------------------------------------------
+/*!
+    Block header.  Every block starts with the link to its physical
+    predecessor and its size; the free-list links overlay the payload and
+    are only valid while the block is free.
+*/
+typedef struct _HeapBlock
+{
+    struct _HeapBlock *pstPrevPhys; //!< Physically preceding block, NULL for the first
+    K_ADDR tSize;                   //!< Payload size in bytes; bit 0 set when free
+
+    struct _HeapBlock *pstNextFree; //!< Next block in the same free bin
+    struct _HeapBlock *pstPrevFree; //!< Previous block in the same free bin
+} HeapBlock_t;
+
+//---------------------------------------------------------------------------
+/*!
+    Concurrency protection used by a heap
+*/
+typedef enum
+{
+    HEAP_LOCK_NONE = 0,         //!< No protection, single-context use only
+    HEAP_LOCK_MUTEX,            //!< Thread-safe, using a kernel mutex
+    HEAP_LOCK_CRITICAL,         //!< Thread and ISR-safe, using critical sections
+//---
+    HEAP_LOCK_MODES
+} HeapLock_t;
+
+//---------------------------------------------------------------------------
+/*!
+    Heap object
+*/
+typedef struct
+{
+    K_USHORT usFLBitmap;                        //!< Non-empty first-level ranges
+    K_UCHAR aucSLBitmap[HEAP_FL_INDEX_COUNT];   //!< Non-empty bins, per range
+
+    //! Free-list heads, indexed by first- and second-level index
+    HeapBlock_t *apstFree[HEAP_FL_INDEX_COUNT][HEAP_SL_INDEX_COUNT];
+
+    HeapBlock_t *pstFirst;      //!< First block in the arena
+
+    K_ADDR tTotal;              //!< Bytes managed by the heap, including block headers
+    K_ADDR tUsed;               //!< Bytes currently allocated, including block headers
+    K_ADDR tHighWater;          //!< Maximum value of tUsed
+    K_USHORT usFailures;        //!< Number of failed allocations
+
+    HeapLock_t eLock;           //!< Concurrency protection in use
+#if KERNEL_USE_MUTEX
+    Mutex_t stMutex;            //!< Lock used in HEAP_LOCK_MUTEX mode
+#endif
+} Heap_t;
+
+//---------------------------------------------------------------------------
+/*!
+    Heap usage and fragmentation statistics
+*/
+typedef struct
+{
+    K_ADDR tFreeBytes;          //!< Total free payload bytes
+    K_ADDR tUsedBytes;          //!< Bytes allocated, including block headers
+    K_ADDR tLargestFree;        //!< Payload size of the largest free block
+    K_ADDR tHighWater;          //!< Maximum number of bytes ever allocated at once
+    K_USHORT usFreeBlocks;      //!< Number of free blocks
+    K_USHORT usUsedBlocks;      //!< Number of allocated blocks
+    K_USHORT usFailures;        //!< Number of failed allocations
+    K_UCHAR ucFragmentation;    //!< Percentage of free memory outside the largest free block
+} HeapStats_t;
+
+//---------------------------------------------------------------------------
+/*!
+    \fn void Heap_Init( Heap_t *pstHeap_, void *pvArena_, K_ADDR tSize_, HeapLock_t eLock_ )
+
+    Initialize a heap, using the supplied memory as its arena.
+
+    \param pstHeap_ Pointer to the heap object
+    \param pvArena_ Memory managed by the heap
+    \param tSize_   Size of the arena, in bytes
+    \param eLock_   Concurrency protection to use for this heap
+*/
+void Heap_Init( Heap_t *pstHeap_, void *pvArena_, K_ADDR tSize_, HeapLock_t eLock_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn void *Heap_Alloc( Heap_t *pstHeap_, K_ADDR tSize_ )
+
+    Allocate a block of memory from the heap, in bounded time.
+
+    \param pstHeap_ Pointer to the heap object
+    \param tSize_   Number of bytes requested
+    \return Pointer to the allocated memory, or NULL if no block large
+            enough is available
+*/
+void *Heap_Alloc( Heap_t *pstHeap_, K_ADDR tSize_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn void Heap_Free( Heap_t *pstHeap_, void *pvData_ )
+
+    Return memory to the heap, merging it with any free neighbours, in
+    bounded time.  Freeing NULL has no effect.
+
+    \param pstHeap_ Pointer to the heap the memory was allocated from
+    \param pvData_  Pointer previously returned by Heap_Alloc()
+*/
+void Heap_Free( Heap_t *pstHeap_, void *pvData_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn K_ADDR Heap_GetBlockSize( void *pvData_ )
+
+    \param pvData_  Pointer previously returned by Heap_Alloc()
+    \return Usable size of the allocation, which may exceed the size
+            originally requested
+*/
+K_ADDR Heap_GetBlockSize( void *pvData_ );
+
+//---------------------------------------------------------------------------
+/*!
+    \fn void Heap_GetStats( Heap_t *pstHeap_, HeapStats_t *pstStats_ )
+
+    Gather usage and fragmentation statistics.  This walks every block in
+    the heap while holding its lock, so its run time is proportional to the
+    number of blocks; it is intended for diagnostics, not for use in
+    time-critical paths.
+
+    \param pstHeap_  Pointer to the heap object
+    \param pstStats_ Structure to receive the statistics
+*/
+void Heap_GetStats( Heap_t *pstHeap_, HeapStats_t *pstStats_ );
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif //__HEAP_H__
@@ -0,0 +1,148 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   tlog.h
+
+    \brief  Tokenized logging with deferred formatting
+
+    Instead of formatting text on the target, each log call emits a 16-bit
+    format ID and its raw argument values.  The format strings live only on
+    the host, which expands the records back into text.  No string data or
+    number-to-text conversion is needed on the target, and a typical record
+    is a fraction of the size of the text it stands for.
+
+    Format IDs are declared in an application header, using the same
+    convention as debugtokens.h - a define with the printf-style format
+    string in a SUBSTITUTE comment:
+
+    \code
+        #define LOG_BOOT            0x3000  // SUBSTITUTE="Booted in %lu ms"
+        #define LOG_ADC_SAMPLE      0x3001  // SUBSTITUTE="ADC%u: %d mV"
+    \endcode
+
+    \code
+        TLog_SetOutput( UartOut );
+        TLog_Write1( LOG_BOOT, ulBootTime );
+        TLog_Write2( LOG_ADC_SAMPLE, ucChannel, (K_SHORT)sMillivolts );
+    \endcode
+
+    On the host, scripts/tlog.py builds the string table from those headers
+    and expands a captured log:
+
+    \code
+        scripts/tlog.py table app/logtokens.h > strings.json
+        scripts/tlog.py decode strings.json capture.bin
+    \endcode
+
+    Record format (bytes):
+
+    \code
+        [0]     TLOG_SYNC
+        [1..2]  Format ID, little-endian
+        [3]     Descriptor - bits 0-1: argument count, bits 2-3, 4-5, 6-7:
+                size of arguments 1-3 (0 = 1 byte, 1 = 2 bytes, 2 = 4 bytes)
+        [4..]   Arguments, little-endian, each in as few bytes as it fits
+    \endcode
+
+    Arguments are passed as 32-bit values, so signed arguments are
+    sign-extended, and negative values are sent in full; the host applies
+    the signedness given by the format string's conversion.
+*/
+
+#ifndef __TLOG_H__
+#define __TLOG_H__
+
+#include "kerneltypes.h"
+#include "mark3cfg.h"
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//---------------------------------------------------------------------------
+#define TLOG_SYNC           (0xA5)      //!< First byte of every record
+#define TLOG_MAX_ARGS       (3)         //!< Maximum arguments per record
+#define TLOG_MAX_RECORD     (4 + (4 * TLOG_MAX_ARGS))   //!< Largest record, in bytes
+
+//---------------------------------------------------------------------------
+/*!
+    Function pointer type used to output log records.  Each call carries
+    exactly one complete record, which must be written out without being
+    interleaved with other records.
+*/
+typedef void (*TLogOutput_t)( const K_UCHAR *pucData_, K_UCHAR ucLen_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief TLog_SetOutput
+ *
+ * Set the function that writes log records out.  Records are discarded,
+ * without being built, while no output is set.
+ *
+ * \param pfOutput_ Output function, or NULL to stop logging
+ */
+void TLog_SetOutput( TLogOutput_t pfOutput_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief TLog_Write0
+ *
+ * Log a message with no arguments.
+ *
+ * \param usFormat_ Format ID
+ */
+void TLog_Write0( K_USHORT usFormat_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief TLog_Write1
+ *
+ * Log a message with one argument.
+ *
+ * \param usFormat_ Format ID
+ * \param ulArg1_   First argument
+ */
+void TLog_Write1( K_USHORT usFormat_, K_ULONG ulArg1_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief TLog_Write2
+ *
+ * Log a message with two arguments.
+ *
+ * \param usFormat_ Format ID
+ * \param ulArg1_   First argument
+ * \param ulArg2_   Second argument
+ */
+void TLog_Write2( K_USHORT usFormat_, K_ULONG ulArg1_, K_ULONG ulArg2_ );
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief TLog_Write3
+ *
+ * Log a message with three arguments.
+ *
+ * \param usFormat_ Format ID
+ * \param ulArg1_   First argument
+ * \param ulArg2_   Second argument
+ * \param ulArg3_   Third argument
+ */
+void TLog_Write3( K_USHORT usFormat_, K_ULONG ulArg1_, K_ULONG ulArg2_, K_ULONG ulArg3_ );
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif // __TLOG_H__
@@ -0,0 +1,125 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+/*!
+
+    \file   tlog.c
+
+    \brief  Tokenized logging with deferred formatting
+*/
+
+#include "kerneltypes.h"
+#include "mark3cfg.h"
+#include "tlog.h"
+
+//---------------------------------------------------------------------------
+#define TLOG_SIZE_8         (0)     //!< Argument sent as 1 byte
+#define TLOG_SIZE_16        (1)     //!< Argument sent as 2 bytes
+#define TLOG_SIZE_32        (2)     //!< Argument sent as 4 bytes
+
+//---------------------------------------------------------------------------
+static volatile TLogOutput_t pfOutput;     //!< Where records are written
+
+//---------------------------------------------------------------------------
+/*!
+ * \brief TLog_Write_i
+ *
+ * Build a record and hand it to the output.
+ *
+ * \param usFormat_ Format ID
+ * \param pulArgs_  Arguments
+ * \param ucCount_  Number of arguments
+ */
+static void TLog_Write_i( K_USHORT usFormat_, const K_ULONG *pulArgs_, K_UCHAR ucCount_ )
+{
+    K_UCHAR aucRecord[ TLOG_MAX_RECORD ];
+    TLogOutput_t pfOut = pfOutput;
+    K_UCHAR ucDesc = ucCount_;
+    K_UCHAR ucLen = 4;
+    K_UCHAR i;
+
+    if (!pfOut)
+    {
+        return;
+    }
+
+    aucRecord[0] = TLOG_SYNC;
+    aucRecord[1] = (K_UCHAR)(usFormat_ & 0xFF);
+    aucRecord[2] = (K_UCHAR)(usFormat_ >> 8);
+
+    // Send each argument in as few bytes as it fits in
+    for (i = 0; i < ucCount_; i++)
+    {
+        K_ULONG ulArg = pulArgs_[i];
+
+        aucRecord[ucLen++] = (K_UCHAR)(ulArg & 0xFF);
+        if (ulArg <= 0xFF)
+        {
+            ucDesc |= (TLOG_SIZE_8 << (2 + (i * 2)));
+        }
+        else if (ulArg <= 0xFFFF)
+        {
+            aucRecord[ucLen++] = (K_UCHAR)(ulArg >> 8);
+            ucDesc |= (TLOG_SIZE_16 << (2 + (i * 2)));
+        }
+        else
+        {
+            aucRecord[ucLen++] = (K_UCHAR)(ulArg >> 8);
+            aucRecord[ucLen++] = (K_UCHAR)(ulArg >> 16);
+            aucRecord[ucLen++] = (K_UCHAR)(ulArg >> 24);
+            ucDesc |= (TLOG_SIZE_32 << (2 + (i * 2)));
+        }
+    }
+    aucRecord[3] = ucDesc;
+
+    pfOut( aucRecord, ucLen );
+}
+
+//---------------------------------------------------------------------------
+void TLog_SetOutput( TLogOutput_t pfOutput_ )
+{
+    pfOutput = pfOutput_;
+}
+
+//---------------------------------------------------------------------------
+void TLog_Write0( K_USHORT usFormat_ )
+{
+    TLog_Write_i( usFormat_, 0, 0 );
+}
+
+//---------------------------------------------------------------------------
+void TLog_Write1( K_USHORT usFormat_, K_ULONG ulArg1_ )
+{
+    TLog_Write_i( usFormat_, &ulArg1_, 1 );
+}
+
+//---------------------------------------------------------------------------
+void TLog_Write2( K_USHORT usFormat_, K_ULONG ulArg1_, K_ULONG ulArg2_ )
+{
+    K_ULONG aulArgs[2];
+
+    aulArgs[0] = ulArg1_;
+    aulArgs[1] = ulArg2_;
+    TLog_Write_i( usFormat_, aulArgs, 2 );
+}
+
+//---------------------------------------------------------------------------
+void TLog_Write3( K_USHORT usFormat_, K_ULONG ulArg1_, K_ULONG ulArg2_, K_ULONG ulArg3_ )
+{
+    K_ULONG aulArgs[3];
+
+    aulArgs[0] = ulArg1_;
+    aulArgs[1] = ulArg2_;
+    aulArgs[2] = ulArg3_;
+    TLog_Write_i( usFormat_, aulArgs, 3 );
+}
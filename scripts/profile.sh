@@ -15,6 +15,7 @@ kill ${pid}
 metric="none"
 metric_name="none"
 metric_time=0
+metric_unit="cycles"
 
 profile_count=0
 profile_sum=0
@@ -33,9 +34,41 @@ compute_profile()
 		profile_sum=`expr $profile_sum + $line`
 
 	done;
+
+	# Metrics for kernel features that are configured out aren't reported
+	if [ ${profile_count} -eq 0 ]; then
+		echo "${metric_name}: not measured"
+		return
+	fi
 	metric_time=`expr $profile_sum / $profile_count`
-	echo "${metric_name}: ${metric_time} cycles (averaged over ${profile_count} iterations)"
-	echo "    - ${metric_name}: ${metric_time} cycles (averaged over ${profile_count} iterations)" >> ${outfile}
+	echo "${metric_name}: ${metric_time} ${metric_unit} (averaged over ${profile_count} iterations)"
+	echo "    - ${metric_name}: ${metric_time} ${metric_unit} (averaged over ${profile_count} iterations)" >> ${outfile}
+}
+
+#============================================================================
+compute_min()
+{
+	metric_time=`cat ./profile.txt | grep -a ${metric} | sed -e "s/${metric}//" | sort -n | head -n 1`
+	echo "${metric_name}: ${metric_time} ${metric_unit} (best case)"
+	echo "    - ${metric_name}: ${metric_time} ${metric_unit} (best case)" >> ${outfile}
+}
+
+#============================================================================
+compute_max()
+{
+	metric_time=`cat ./profile.txt | grep -a ${metric} | sed -e "s/${metric}//" | sort -n | tail -n 1`
+	echo "${metric_name}: ${metric_time} ${metric_unit} (worst case)"
+	echo "    - ${metric_name}: ${metric_time} ${metric_unit} (worst case)" >> ${outfile}
+}
+
+#============================================================================
+# Histogram counts accumulate from one report to the next, so only the last
+# (most complete) report is used.
+compute_histogram()
+{
+	metric_time=`cat ./profile.txt | grep -a ${metric} | sed -e "s/${metric}//" | tail -n 1`
+	echo "${metric_name}: ${metric_time}"
+	echo "    - ${metric_name}: ${metric_time}" >> ${outfile}
 }
 
 #============================================================================
@@ -72,6 +105,18 @@ metric="SF:"
 metric_name="Semaphore Flyback Time (Contested Pend)"
 compute_profile
 
+metric="TNF:"
+metric_name="Thread Notify Flyback Time (Blocked Wait)"
+compute_profile
+
+metric="DPF:"
+metric_name="DPC Flyback Time (Queue to Run)"
+compute_profile
+
+metric="KGT:"
+metric_name="Kernel Get Time"
+compute_profile
+
 metric="MI:"
 metric_name="Mutex Init"
 compute_profile
@@ -100,6 +145,122 @@ metric="SC:"
 metric_name="Thread Schedule"
 compute_profile
 
+metric="SCH:"
+metric_name="Thread Schedule (highest configured priority ready)"
+compute_profile
+
+metric="SC16:"
+metric_name="Thread Schedule (priority 15 ready, needs 16+ priorities)"
+compute_profile
+
+metric="SC32:"
+metric_name="Thread Schedule (priority 31 ready, needs 32+ priorities)"
+compute_profile
+
+metric="SC64:"
+metric_name="Thread Schedule (priority 63 ready, needs 64 priorities)"
+compute_profile
+
+metric="EFW1:"
+metric_name="Event Flag Set (1 waiter)"
+compute_profile
+
+metric="EFW2:"
+metric_name="Event Flag Set (2 waiters)"
+compute_profile
+
+metric="EFW4:"
+metric_name="Event Flag Set (4 waiters)"
+compute_profile
+
+metric="BPA:"
+metric_name="Block Pool Allocate (uncontested)"
+compute_profile
+
+metric="BPF:"
+metric_name="Block Pool Free (uncontested)"
+compute_profile
+
+metric="BPW:"
+metric_name="Block Pool Flyback Time (Allocate from empty pool)"
+compute_profile
+
+metric="HA:"
+metric_name="Heap Allocate (exact fit)"
+compute_profile
+
+metric="HF:"
+metric_name="Heap Free (no merge)"
+compute_profile
+
+metric="HAW:"
+metric_name="Heap Allocate (worst case, split)"
+compute_profile
+
+metric="HFW:"
+metric_name="Heap Free (worst case, two merges)"
+compute_profile
+
+metric="CSMIN:"
+metric_name="Context Switch"
+compute_min
+
+metric="CSMAX:"
+metric_name="Context Switch"
+compute_max
+
+metric="SFMIN:"
+metric_name="Semaphore Flyback Time (Contested Pend)"
+compute_min
+
+metric="SFMAX:"
+metric_name="Semaphore Flyback Time (Contested Pend)"
+compute_max
+
+metric="SCMIN:"
+metric_name="Thread Schedule"
+compute_min
+
+metric="SCMAX:"
+metric_name="Thread Schedule"
+compute_max
+
+echo "    . " >> ${outfile}
+echo "\section PROFHIST Latency Histograms" >> ${outfile}
+echo "Iteration counts per log2 bucket - bucket n holds iterations of 8*2^n to 8*2^(n+1)-1 cycles." >> ${outfile}
+
+metric="CSHIST:"
+metric_name="Context Switch"
+compute_histogram
+
+metric="SFHIST:"
+metric_name="Semaphore Flyback Time (Contested Pend)"
+compute_histogram
+
+metric="SCHIST:"
+metric_name="Thread Schedule"
+compute_histogram
+
+metric_unit="elements/sec"
+
+metric="MB1:"
+metric_name="Mailbox Throughput (single-element send/receive)"
+compute_profile
+
+metric="MB4:"
+metric_name="Mailbox Throughput (batches of 4)"
+compute_profile
+
+metric="MB16:"
+metric_name="Mailbox Throughput (batches of 16)"
+compute_profile
+
+metric="MB32:"
+metric_name="Mailbox Throughput (batches of 32)"
+compute_profile
+
+metric_unit="cycles"
+
 echo "    . " >> ${outfile}
 echo "*/" >> ${outfile}
 
@@ -0,0 +1,117 @@
+### Turn samples from the Mark3 sampling profiler (KERNEL_USE_SAMPLE_PROFILER)
+### into a symbolized flat profile, using the application's ELF file
+###
+### Usage: sampleprof.py [--nm=avr-nm] [--word-address] [--by-thread] app.elf samples.txt
+###
+### The sample file holds one sample per line, as the program counter and
+### thread ID in hex - "<pc> <thread ID>".  Lines that don't parse are
+### skipped, so a raw serial log can be fed in directly.  AVR samples are
+### word addresses, and need --word-address.
+from __future__ import print_function
+import bisect
+import subprocess
+import sys
+
+IDLE_ID = 0xFF      # Thread ID of the idle thread
+
+#----------------------------------------------------------------------------
+def read_symbols(nm, elf):
+	# Function symbols, sorted by address, with their sizes where known
+	out = subprocess.check_output([nm, "-n", "-S", "-C", "--defined-only", elf])
+	syms = []
+	for line in out.decode("latin-1").splitlines():
+		fields = line.split(None, 3)
+		if len(fields) == 4:
+			addr, size, kind, name = fields
+		elif len(fields) == 3:
+			addr, kind, name = fields
+			size = None
+		else:
+			continue
+		# Weak symbols without a size are usually data markers, not functions
+		if kind not in "tTwW" or (kind in "wW" and size is None):
+			continue
+		# Thumb function symbols have bit 0 set
+		syms.append((int(addr, 16) & ~1, int(size, 16) if size else None, name))
+	syms.sort()
+	return syms
+
+#----------------------------------------------------------------------------
+def read_samples(path, word_address):
+	samples = []
+	with open(path) as f:
+		for line in f:
+			fields = line.split()
+			if len(fields) != 2:
+				continue
+			try:
+				pc, tid = int(fields[0], 16), int(fields[1], 16)
+			except ValueError:
+				continue
+			samples.append((pc * 2 if word_address else pc, tid))
+	return samples
+
+#----------------------------------------------------------------------------
+def symbolize(syms, addrs, pc):
+	i = bisect.bisect_right(addrs, pc) - 1
+	if i < 0:
+		return "0x%x" % pc
+	addr, size, name = syms[i]
+	if size is not None and pc >= addr + size:
+		return "0x%x" % pc
+	return name
+
+#----------------------------------------------------------------------------
+def thread_name(tid):
+	if tid == IDLE_ID:
+		return "idle"
+	return "thread %d" % tid
+
+#----------------------------------------------------------------------------
+def print_profile(title, counts):
+	total = sum(counts.values())
+	print("%s: %d samples" % (title, total))
+	print("  %8s %7s  %s" % ("samples", "%", "function"))
+	for name, count in sorted(counts.items(), key=lambda kv: (-kv[1], kv[0])):
+		print("  %8d %6.2f%%  %s" % (count, 100.0 * count / total, name))
+	print()
+
+#----------------------------------------------------------------------------
+def main(argv):
+	opts = dict(a[2:].split("=", 1) if "=" in a else (a[2:], True)
+	            for a in argv[1:] if a.startswith("--"))
+	args = [a for a in argv[1:] if not a.startswith("--")]
+	if len(args) != 2:
+		print("usage: %s [--nm=avr-nm] [--word-address] [--by-thread] app.elf samples.txt"
+		      % argv[0], file=sys.stderr)
+		return 1
+
+	syms = read_symbols(opts.get("nm", "nm"), args[0])
+	samples = read_samples(args[1], "word-address" in opts)
+	if not samples:
+		print("no samples found in %s" % args[1], file=sys.stderr)
+		return 1
+
+	addrs = [s[0] for s in syms]
+	cache = {}
+	def lookup(pc):
+		if pc not in cache:
+			cache[pc] = symbolize(syms, addrs, pc)
+		return cache[pc]
+
+	flat = {}
+	threads = {}
+	for pc, tid in samples:
+		name = lookup(pc)
+		flat[name] = flat.get(name, 0) + 1
+		per = threads.setdefault(tid, {})
+		per[name] = per.get(name, 0) + 1
+
+	print_profile("All threads", flat)
+	if "by-thread" in opts:
+		for tid in sorted(threads):
+			print_profile(thread_name(tid), threads[tid])
+	return 0
+
+if __name__ == "__main__":
+	sys.exit(main(sys.argv))
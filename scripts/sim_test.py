@@ -8,7 +8,10 @@ cpu       = "atmega328p"
 toolchain = "gcc"
 stage	= "./stage"
 # List of unit tests to run
-test_list = ["ut_logic", "ut_thread", "ut_semaphore", "ut_mutex", "ut_eventflag", "ut_heap", "ut_message", "ut_timers", "ut_sanity", "ut_mailbox", "ut_timer_precision" ]
+test_list = ["ut_logic", "ut_thread", "ut_semaphore", "ut_mutex", "ut_eventflag", "ut_heap", "ut_message", "ut_timers", "ut_sanity", "ut_mailbox", "ut_ringbuffer", "ut_blockpool", "ut_multiwait", "ut_dpc", "ut_timer_precision", "ut_threadstats", "ut_profile", "ut_eventtrace", "ut_tlog", "ut_sampleprofiler", "ut_csstats" ]
+
+# Tests whose kernel features are disabled in mark3cfg.h
+skipped_list = []
 
 # Run each test in succession
 for test in test_list:
@@ -16,8 +19,27 @@ for test in test_list:
 	test_cmd = "flavr --exitreset --silent --elffile %s/app/%s/%s/%s/%s.elf" % (stage, platform, cpu, toolchain, test)
 	child = pexpect.spawn( test_cmd )
 	print "--[Running Test: %s]--" % test 
-	index = child.expect (["--DONE--","(FAIL)", pexpect.EOF, pexpect.TIMEOUT], timeout=240)
-	if index == 0:
+
+	# Test cases that exercise a disabled feature make no checks, and report
+	# "(SKIP)" - count them, so that they aren't mistaken for passes.
+	ran = 0
+	skipped = 0
+	while True:
+		index = child.expect (["--DONE--","(FAIL)", pexpect.EOF, pexpect.TIMEOUT, "\\(PASS\\)", "\\(SKIP\\)"], timeout=240)
+		if index == 4:
+			ran += 1
+		elif index == 5:
+			skipped += 1
+		else:
+			break
+
+	if index == 0 and ran == 0 and skipped > 0:
+		print "		(SKIPPED -- feature disabled in mark3cfg.h)"
+		skipped_list.append(test)
+	elif index == 0 and skipped > 0:
+		print "		(PASS -- %d test cases skipped)" % skipped
+		skipped_list.append(test)
+	elif index == 0:
 		print "		(PASS)"
 	elif index == 1:
 		print "		(FAIL)"
@@ -28,3 +50,8 @@ for test in test_list:
 		print "		(FAIL -- TIMEOUT)"
 		break
 
+
+if skipped_list:
+	print "--[Tests not fully run - features disabled]--"
+	for test in skipped_list:
+		print "	%s" % test
@@ -0,0 +1,117 @@
+### Host side of the tokenized logging library (libs/tlog)
+###
+### Usage: tlog.py table header.h [header.h ...] > strings.json
+###        tlog.py decode strings.json capture.bin
+###
+### "table" collects the format strings from defines of the form
+###     #define NAME 0xNNNN /* SUBSTITUTE="format" */
+### as used by kernel/public/debugtokens.h.  "decode" expands a raw capture of
+### the bytes handed to the TLog output function back into text, one line per
+### record.  See libs/tlog/public/tlog.h for the record format.
+from __future__ import print_function
+import json
+import re
+import sys
+
+TLOG_SYNC     = 0xA5
+TLOG_MAX_ARGS = 3
+ARG_SIZES     = (1, 2, 4)
+
+DEFINE_RE = re.compile(r'^\s*#define\s+(\w+)\s+(0[xX][0-9a-fA-F]+|\d+)\b.*SUBSTITUTE="((?:[^"\\]|\\.)*)"')
+CONV_RE   = re.compile(r'%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l)?([diuxXc%])')
+
+#----------------------------------------------------------------------------
+def build_table(paths):
+	table = {}
+	for path in paths:
+		with open(path) as f:
+			for line in f:
+				m = DEFINE_RE.match(line)
+				if not m:
+					continue
+				ident = int(m.group(2), 0)
+				fmt = m.group(3).encode("latin-1").decode("unicode_escape")
+				if ident in table and table[ident]["format"] != fmt:
+					print("warning: 0x%04x redefined by %s" % (ident, m.group(1)), file=sys.stderr)
+				table[ident] = {"name": m.group(1), "format": fmt}
+	return table
+
+#----------------------------------------------------------------------------
+def expand(fmt, args):
+	# Arguments were sent as 32-bit values; the conversion gives the sign.
+	args = list(args)
+
+	def sub(m):
+		flags, _, conv = m.groups()
+		if conv == "%":
+			return "%"
+		value = args.pop(0) if args else 0
+		if conv in "di":
+			if value & 0x80000000:
+				value -= 0x100000000
+			return ("%" + flags + "d") % value
+		if conv == "c":
+			return chr(value & 0xFF)
+		return ("%" + flags + conv) % value
+
+	return CONV_RE.sub(sub, fmt)
+
+#----------------------------------------------------------------------------
+def read_records(data):
+	i = 0
+	while i + 4 <= len(data):
+		if data[i] != TLOG_SYNC:
+			i += 1
+			continue
+		ident = data[i + 1] | (data[i + 2] << 8)
+		desc = data[i + 3]
+		count = desc & 0x03
+		sizes = [(desc >> (2 + (n * 2))) & 0x03 for n in range(TLOG_MAX_ARGS)]
+		if count > TLOG_MAX_ARGS or any(s > 2 for s in sizes[:count]):
+			# Not a record - resynchronize on the next sync byte
+			i += 1
+			continue
+		end = i + 4 + sum(ARG_SIZES[s] for s in sizes[:count])
+		if end > len(data):
+			# Capture ends part way through a record
+			break
+		pos = i + 4
+		args = []
+		for n in range(count):
+			size = ARG_SIZES[sizes[n]]
+			args.append(sum(data[pos + b] << (8 * b) for b in range(size)))
+			pos += size
+		yield i, ident, args
+		i = pos
+
+#----------------------------------------------------------------------------
+def decode(table, data):
+	for offset, ident, args in read_records(data):
+		entry = table.get(ident)
+		if entry is None:
+			print(" ".join(["[%06x] unknown format 0x%04x" % (offset, ident)] +
+			               ["0x%x" % a for a in args]))
+			continue
+		print(expand(entry["format"], args))
+
+#----------------------------------------------------------------------------
+def main(argv):
+	if len(argv) >= 3 and argv[1] == "table":
+		table = build_table(argv[2:])
+		json.dump(dict(("0x%04x" % k, v) for k, v in sorted(table.items())),
+		          sys.stdout, indent=1, sort_keys=True)
+		print()
+		return 0
+	if len(argv) == 4 and argv[1] == "decode":
+		with open(argv[2]) as f:
+			table = dict((int(k, 16), v) for k, v in json.load(f).items())
+		with open(argv[3], "rb") as f:
+			data = bytearray(f.read())
+		decode(table, data)
+		return 0
+	print("usage: %s table header.h [...] > strings.json" % argv[0], file=sys.stderr)
+	print("       %s decode strings.json capture.bin" % argv[0], file=sys.stderr)
+	return 1
+
+if __name__ == "__main__":
+	sys.exit(main(sys.argv))
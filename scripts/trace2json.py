@@ -0,0 +1,135 @@
+### Convert a Mark3 event trace capture (KERNEL_USE_EVENT_TRACE) into Chrome
+### trace JSON, for viewing in Perfetto (ui.perfetto.dev) or chrome://tracing
+###
+### Usage: trace2json.py [--hex] [--big-endian] capture.bin > trace.json
+###
+### The capture is the raw stream of 16-bit words handed to the trace
+### callback, either as binary (default) or as whitespace-separated hex words
+### (--hex).  Each record is 4 words - see kernel/public/eventtrace.h.
+from __future__ import print_function
+import json
+import struct
+import sys
+
+# Event types - must match EventTraceType_t
+EVENT_SWITCH    = 1
+EVENT_BLOCK     = 2
+EVENT_UNBLOCK   = 3
+EVENT_ISR_ENTER = 4
+EVENT_ISR_EXIT  = 5
+EVENT_TIMER     = 6
+EVENT_USER      = 7
+
+IDLE_ID      = 0xFF     # Thread ID of the idle thread
+NO_THREAD    = 0xFE     # EVENT_TRACE_NO_THREAD
+
+PID          = 1
+ISR_TID_BASE = 1000     # Tracks for interrupts are numbered from here
+TIMER_TID    = 2000     # Track for timer expiries
+
+#----------------------------------------------------------------------------
+def read_words(path, is_hex, big_endian):
+	if is_hex:
+		with open(path) as f:
+			return [int(tok, 16) for tok in f.read().split()]
+	with open(path, "rb") as f:
+		data = f.read()
+	fmt = (">" if big_endian else "<") + "%dH" % (len(data) // 2)
+	return list(struct.unpack(fmt, data[:(len(data) // 2) * 2]))
+
+#----------------------------------------------------------------------------
+def read_records(words):
+	# Timestamps are the low 32 bits of the kernel time; unwrap them.
+	epoch = 0
+	last = None
+	for i in range(0, len(words) - 3, 4):
+		event = words[i] >> 8
+		ident = words[i] & 0xFF
+		ts = words[i + 1] | (words[i + 2] << 16)
+		if last is not None and ts < last and (last - ts) > 0x80000000:
+			epoch += 0x100000000
+		last = ts
+		yield event, ident, ts + epoch, words[i + 3]
+
+#----------------------------------------------------------------------------
+def thread_name(tid):
+	if tid == IDLE_ID:
+		return "idle"
+	return "thread %d" % tid
+
+#----------------------------------------------------------------------------
+def convert(records):
+	out = []
+	tracks = {}
+	running = None      # (thread ID, start time, priority)
+	isr_start = {}
+
+	def track(tid, name):
+		if tid not in tracks:
+			tracks[tid] = name
+
+	def instant(tid, ts, name, args):
+		out.append({"ph": "i", "s": "t", "pid": PID, "tid": tid, "ts": ts,
+		            "name": name, "args": args})
+
+	def complete(tid, ts, end, name, args):
+		out.append({"ph": "X", "pid": PID, "tid": tid, "ts": ts,
+		            "dur": max(end - ts, 0), "name": name, "args": args})
+
+	end = 0
+	for event, ident, ts, arg in records:
+		end = ts
+		if event == EVENT_SWITCH:
+			prev = arg & 0xFF
+			prio = arg >> 8
+			if running is not None:
+				complete(running[0], running[1], ts, "running",
+				         {"priority": running[2]})
+			elif prev != NO_THREAD:
+				track(prev, thread_name(prev))
+			track(ident, thread_name(ident))
+			running = (ident, ts, prio)
+		elif event in (EVENT_BLOCK, EVENT_UNBLOCK):
+			track(ident, thread_name(ident))
+			instant(ident, ts, "block" if event == EVENT_BLOCK else "unblock",
+			        {"object": "0x%04x" % arg})
+		elif event == EVENT_ISR_ENTER:
+			track(ISR_TID_BASE + ident, "ISR %d" % ident)
+			isr_start[ident] = ts
+		elif event == EVENT_ISR_EXIT:
+			if ident in isr_start:
+				complete(ISR_TID_BASE + ident, isr_start.pop(ident), ts,
+				         "ISR %d" % ident, {})
+		elif event == EVENT_TIMER:
+			track(TIMER_TID, "timers")
+			owner = "none" if ident == NO_THREAD else thread_name(ident)
+			instant(TIMER_TID, ts, "timer 0x%04x" % arg, {"owner": owner})
+		elif event == EVENT_USER:
+			tid = running[0] if running is not None else TIMER_TID
+			track(tid, thread_name(tid) if running is not None else "timers")
+			instant(tid, ts, "user %d" % ident, {"data": arg})
+
+	# Close off whatever was still running when the capture ended
+	if running is not None:
+		complete(running[0], running[1], end, "running", {"priority": running[2]})
+
+	for tid, name in tracks.items():
+		out.append({"ph": "M", "pid": PID, "tid": tid, "name": "thread_name",
+		            "args": {"name": name}})
+	out.append({"ph": "M", "pid": PID, "name": "process_name",
+	            "args": {"name": "Mark3"}})
+	return {"traceEvents": out}
+
+#----------------------------------------------------------------------------
+def main(argv):
+	args = [a for a in argv[1:] if not a.startswith("--")]
+	if len(args) != 1:
+		print("usage: %s [--hex] [--big-endian] capture" % argv[0], file=sys.stderr)
+		return 1
+	words = read_words(args[0], "--hex" in argv, "--big-endian" in argv)
+	json.dump(convert(read_records(words)), sys.stdout, indent=1)
+	print()
+	return 0
+
+if __name__ == "__main__":
+	sys.exit(main(sys.argv))
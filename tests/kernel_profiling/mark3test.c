@@ -10,6 +10,12 @@
 #include "ksemaphore.h"
 #include "mutex.h"
 #include "message.h"
+#include "mailbox.h"
+#include "eventflag.h"
+#include "blockpool.h"
+#include "dpc.h"
+#include "heap.h"
+#include "kerneltimer.h"
 #include "timerlist.h"
 
 //---------------------------------------------------------------------------
@@ -33,6 +39,20 @@ static K_UCHAR aucTxBuf[32];
 #define MAIN_STACK_SIZE            (384)
 #define IDLE_STACK_SIZE            (384)
 
+// Semaphore waiter threads share test thread 1's stack
+#define NUM_WAITERS                 (4)
+#define WAITER_STACK_SIZE           (TEST_STACK1_SIZE / NUM_WAITERS)
+#define NUM_WAITER_TESTS            (3)
+
+#define MBOX_ELEMENTS               (32)
+#define NUM_BATCH_TESTS             (4)
+
+#define POOL_BLOCK_SIZE             (8)
+#define POOL_BLOCKS                 (8)
+
+// The heap arena is carved from test thread 1's stack
+#define HEAP_TEST_SIZE              (64)
+
 //---------------------------------------------------------------------------
 static ProfileTimer_t stProfileOverhead;
 
@@ -50,7 +70,50 @@ static ProfileTimer_t stThreadExitTimer;
 static ProfileTimer_t stContextSwitchTimer;
 
 static ProfileTimer_t stSemaphoreFlyback;
+static ProfileTimer_t stNotifyFlyback;
+#if KERNEL_USE_DPC
+static ProfileTimer_t stDpcFlyback;
+#endif
+static ProfileTimer_t stGetTimeTimer;
 static ProfileTimer_t stSchedulerTimer;
+static ProfileTimer_t stSchedulerHighTimer;
+#if KERNEL_NUM_PRIORITIES >= 16
+static ProfileTimer_t stScheduler16Timer;
+#endif
+#if KERNEL_NUM_PRIORITIES >= 32
+static ProfileTimer_t stScheduler32Timer;
+#endif
+#if KERNEL_NUM_PRIORITIES >= 64
+static ProfileTimer_t stScheduler64Timer;
+#endif
+
+// Latency histograms for the timers where worst-case matters most
+static K_USHORT ausContextSwitchHist[PROFILE_HISTOGRAM_BUCKETS];
+static K_USHORT ausSemaphoreFlybackHist[PROFILE_HISTOGRAM_BUCKETS];
+static K_USHORT ausSchedulerHist[PROFILE_HISTOGRAM_BUCKETS];
+
+static ProfileTimer_t astSemPostWaitTimer[NUM_WAITER_TESTS];
+static const K_UCHAR aucWaiterCounts[NUM_WAITER_TESTS] = { 1, 2, NUM_WAITERS };
+static Thread_t astWaiterThread[NUM_WAITERS];
+
+static ProfileTimer_t astFlagSetWaitTimer[NUM_WAITER_TESTS];
+
+static ProfileTimer_t astMailBoxBatchTimer[NUM_BATCH_TESTS];
+static const K_UCHAR aucBatchSizes[NUM_BATCH_TESTS] = { 1, 4, 16, MBOX_ELEMENTS };
+static K_USHORT ausMBoxBuffer[MBOX_ELEMENTS];
+static K_USHORT ausMBoxData[MBOX_ELEMENTS];
+
+static ProfileTimer_t stBlockAllocTimer;
+static ProfileTimer_t stBlockFreeTimer;
+static ProfileTimer_t stBlockFlybackTimer;
+static K_ULONG aulPoolBuffer[(POOL_BLOCK_SIZE * POOL_BLOCKS) / sizeof(K_ULONG)];
+static void *apvPoolBlocks[POOL_BLOCKS];
+
+static ProfileTimer_t stHeapAllocTimer;
+static ProfileTimer_t stHeapFreeTimer;
+static ProfileTimer_t stHeapAllocWorstTimer;
+static ProfileTimer_t stHeapFreeWorstTimer;
+static Heap_t stHeap;
 #endif
 
 //---------------------------------------------------------------------------
@@ -158,12 +221,29 @@ void KUtil_Ultoa( K_ULONG ucData_, K_CHAR *szText_ )
 //---------------------------------------------------------------------------
 static void ProfileInit()
 {
-    
+    K_UCHAR i;
+
     ProfileTimer_Init( &stProfileOverhead );
     ProfileTimer_Init( &stSemInitTimer );
     ProfileTimer_Init( &stSemPendTimer );
     ProfileTimer_Init( &stSemPostTimer );
     ProfileTimer_Init( &stSemaphoreFlyback );
+    ProfileTimer_Init( &stNotifyFlyback );
+#if KERNEL_USE_DPC
+    ProfileTimer_Init( &stDpcFlyback );
+#endif
+    ProfileTimer_Init( &stGetTimeTimer );
+    for (i = 0; i < NUM_WAITER_TESTS; i++)
+    {
+        ProfileTimer_Init( &astSemPostWaitTimer[i] );
+    }
+    for (i = 0; i < NUM_BATCH_TESTS; i++)
+    {
+        ProfileTimer_Init( &astMailBoxBatchTimer[i] );
+    }
+    ProfileTimer_Init( &stBlockAllocTimer );
+    ProfileTimer_Init( &stBlockFreeTimer );
+    ProfileTimer_Init( &stBlockFlybackTimer );
     
     ProfileTimer_Init( &stMutexInitTimer );
     ProfileTimer_Init( &stMutexClaimTimer );
@@ -175,6 +255,20 @@ static void ProfileInit()
     ProfileTimer_Init( &stContextSwitchTimer );
     
     ProfileTimer_Init( &stSchedulerTimer );
+    ProfileTimer_Init( &stSchedulerHighTimer );
+#if KERNEL_NUM_PRIORITIES >= 16
+    ProfileTimer_Init( &stScheduler16Timer );
+#endif
+#if KERNEL_NUM_PRIORITIES >= 32
+    ProfileTimer_Init( &stScheduler32Timer );
+#endif
+#if KERNEL_NUM_PRIORITIES >= 64
+    ProfileTimer_Init( &stScheduler64Timer );
+#endif
+
+    ProfileTimer_SetHistogram( &stContextSwitchTimer, ausContextSwitchHist );
+    ProfileTimer_SetHistogram( &stSemaphoreFlyback, ausSemaphoreFlybackHist );
+    ProfileTimer_SetHistogram( &stSchedulerTimer, ausSchedulerHist );
 }
 
 //---------------------------------------------------------------------------
@@ -239,6 +333,308 @@ static void Semaphore_Profiling()
     return;
 }
 
+//---------------------------------------------------------------------------
+static void Notify_Flyback( void *unused_ )
+{
+    ProfileTimer_Start( &stNotifyFlyback );
+    Thread_NotifyWait( 0xFFFFFFFF, NULL );
+    ProfileTimer_Stop( &stNotifyFlyback );
+
+    Thread_Exit( Scheduler_GetCurrentThread() );
+}
+
+//---------------------------------------------------------------------------
+static void Notify_Profiling()
+{
+    K_USHORT i;
+
+    // Same as the semaphore flyback test, but signalling the waiting thread
+    // directly instead of through a kernel object.
+    for (i = 0; i < 100; i++)
+    {
+        Thread_Init( &stTestThread1, aucTestStack1, TEST_STACK1_SIZE, 2, (ThreadEntry_t)Notify_Flyback, 0);
+        Thread_Start( &stTestThread1 );
+
+        Thread_Notify( &stTestThread1, 0, NOTIFY_ACTION_INCREMENT );
+    }
+}
+
+#if KERNEL_USE_DPC
+//---------------------------------------------------------------------------
+static void Dpc_Flyback( void *unused_ )
+{
+    ProfileTimer_Stop( &stDpcFlyback );
+}
+
+//---------------------------------------------------------------------------
+static void Dpc_Profiling()
+{
+    Dpc_t stDpc;
+    K_USHORT i;
+
+    // Time from queueing a DPC until it starts running in the DPC thread
+    Dpc_Init( &stDpc, Dpc_Flyback, 0 );
+    for (i = 0; i < 100; i++)
+    {
+        ProfileTimer_Start( &stDpcFlyback );
+        Dpc_Queue( &stDpc );
+    }
+}
+#endif
+
+//---------------------------------------------------------------------------
+static void Time_Profiling()
+{
+    K_USHORT i;
+
+    for (i = 0; i < 100; i++)
+    {
+        ProfileTimer_Start( &stGetTimeTimer );
+        Kernel_GetTime();
+        ProfileTimer_Stop( &stGetTimeTimer );
+    }
+}
+
+//---------------------------------------------------------------------------
+static void Semaphore_Waiter( Semaphore_t *pstSe )
+{
+    while(1)
+    {
+        Semaphore_Pend( pstSe );
+    }
+}
+
+//---------------------------------------------------------------------------
+static void Semaphore_WaiterProfiling()
+{
+    Semaphore_t stSem;
+    K_USHORT i;
+    K_UCHAR j;
+
+    for (j = 0; j < NUM_WAITER_TESTS; j++)
+    {
+        // Block a number of threads of mixed priority on the semaphore.  Each
+        // waiter is higher-priority than this thread, and blocks as soon as
+        // it is started.
+        Semaphore_Init( &stSem, 0, 1 );
+        for (i = 0; i < aucWaiterCounts[j]; i++)
+        {
+            Thread_Init( &astWaiterThread[i], &aucTestStack1[i * WAITER_STACK_SIZE], WAITER_STACK_SIZE,
+                         2 + (i % 3), (ThreadEntry_t)Semaphore_Waiter, (void*)&stSem );
+            Thread_Start( &astWaiterThread[i] );
+        }
+
+        // Post with the scheduler disabled, so that only the post (and the
+        // choice of thread to wake) is measured.  The woken thread runs and
+        // blocks again once the scheduler is re-enabled.
+        for (i = 0; i < 100; i++)
+        {
+            Scheduler_SetScheduler(0);
+            ProfileTimer_Start( &astSemPostWaitTimer[j] );
+            Semaphore_Post( &stSem );
+            ProfileTimer_Stop( &astSemPostWaitTimer[j] );
+            Scheduler_SetScheduler(1);
+        }
+
+        for (i = 0; i < aucWaiterCounts[j]; i++)
+        {
+            Thread_Exit( &astWaiterThread[i] );
+        }
+    }
+}
+
+//---------------------------------------------------------------------------
+static void EventFlag_Waiter( EventFlag_t *pstFlag_ )
+{
+    // Each waiter blocks on its own bit, indexed by its position in the
+    // waiter array.
+    K_FLAG_MASK tMask = (K_FLAG_MASK)1 << (Scheduler_GetCurrentThread() - astWaiterThread);
+    while(1)
+    {
+        EventFlag_Wait( pstFlag_, tMask, EVENT_FLAG_ANY_CLEAR );
+    }
+}
+
+//---------------------------------------------------------------------------
+static void EventFlag_WaiterProfiling()
+{
+    EventFlag_t stFlag;
+    K_USHORT i;
+    K_UCHAR j;
+
+    for (j = 0; j < NUM_WAITER_TESTS; j++)
+    {
+        // Block a number of threads on the event flag, each waiting on a
+        // different bit.  Setting the first waiter's bit should cost the
+        // same regardless of how many other threads are blocked.
+        EventFlag_Init( &stFlag );
+        for (i = 0; i < aucWaiterCounts[j]; i++)
+        {
+            Thread_Init( &astWaiterThread[i], &aucTestStack1[i * WAITER_STACK_SIZE], WAITER_STACK_SIZE,
+                         2, (ThreadEntry_t)EventFlag_Waiter, (void*)&stFlag );
+            Thread_Start( &astWaiterThread[i] );
+        }
+
+        // Set with the scheduler disabled, so that only the set (and the
+        // wakeup of the matching thread) is measured.
+        for (i = 0; i < 100; i++)
+        {
+            Scheduler_SetScheduler(0);
+            ProfileTimer_Start( &astFlagSetWaitTimer[j] );
+            EventFlag_Set( &stFlag, 0x0001 );
+            ProfileTimer_Stop( &astFlagSetWaitTimer[j] );
+            Scheduler_SetScheduler(1);
+        }
+
+        for (i = 0; i < aucWaiterCounts[j]; i++)
+        {
+            Thread_Exit( &astWaiterThread[i] );
+        }
+    }
+}
+
+//---------------------------------------------------------------------------
+static void MailBox_Profiling()
+{
+    MailBox_t stMBox;
+    K_USHORT i;
+    K_USHORT k;
+    K_UCHAR j;
+
+    MailBox_Init( &stMBox, (void*)ausMBoxBuffer, sizeof(ausMBoxBuffer), sizeof(K_USHORT) );
+
+    // Time a full mailbox's worth of elements through send and receive,
+    // using the single-element calls, then batches of increasing size.
+    for (j = 0; j < NUM_BATCH_TESTS; j++)
+    {
+        K_UCHAR ucBatch = aucBatchSizes[j];
+        for (i = 0; i < 10; i++)
+        {
+            ProfileTimer_Start( &astMailBoxBatchTimer[j] );
+            if (ucBatch == 1)
+            {
+                for (k = 0; k < MBOX_ELEMENTS; k++)
+                {
+                    MailBox_Send( &stMBox, (void*)&ausMBoxData[k] );
+                }
+                for (k = 0; k < MBOX_ELEMENTS; k++)
+                {
+                    MailBox_ReceiveTail( &stMBox, (void*)&ausMBoxData[k] );
+                }
+            }
+            else
+            {
+                for (k = 0; k < MBOX_ELEMENTS; k += ucBatch)
+                {
+                    MailBox_SendN( &stMBox, (void*)&ausMBoxData[k], ucBatch );
+                }
+                for (k = 0; k < MBOX_ELEMENTS; k += ucBatch)
+                {
+                    MailBox_ReceiveTailN( &stMBox, (void*)&ausMBoxData[k], ucBatch );
+                }
+            }
+            ProfileTimer_Stop( &astMailBoxBatchTimer[j] );
+        }
+    }
+}
+
+//---------------------------------------------------------------------------
+static void BlockPool_Flyback( BlockPool_t *pstPool_ )
+{
+    ProfileTimer_Start( &stBlockFlybackTimer );
+    BlockPool_Alloc( pstPool_ );
+    ProfileTimer_Stop( &stBlockFlybackTimer );
+
+    Thread_Exit( Scheduler_GetCurrentThread() );
+}
+
+//---------------------------------------------------------------------------
+static void BlockPool_Profiling()
+{
+    BlockPool_t stPool;
+    K_USHORT i;
+    K_UCHAR j;
+
+    BlockPool_Init( &stPool, (void*)aulPoolBuffer, sizeof(aulPoolBuffer), POOL_BLOCK_SIZE );
+
+    // Uncontended allocation and free
+    for (i = 0; i < 10; i++)
+    {
+        for (j = 0; j < POOL_BLOCKS; j++)
+        {
+            ProfileTimer_Start( &stBlockAllocTimer );
+            apvPoolBlocks[j] = BlockPool_TryAlloc( &stPool );
+            ProfileTimer_Stop( &stBlockAllocTimer );
+        }
+        for (j = 0; j < POOL_BLOCKS; j++)
+        {
+            ProfileTimer_Start( &stBlockFreeTimer );
+            BlockPool_Free( &stPool, apvPoolBlocks[j] );
+            ProfileTimer_Stop( &stBlockFreeTimer );
+        }
+    }
+
+    // Allocation from an empty pool, satisfied by a free from another thread
+    for (j = 0; j < POOL_BLOCKS; j++)
+    {
+        apvPoolBlocks[j] = BlockPool_TryAlloc( &stPool );
+    }
+    for (i = 0; i < 100; i++)
+    {
+        Thread_Init( &stTestThread1, aucTestStack1, TEST_STACK1_SIZE, 2, (ThreadEntry_t)BlockPool_Flyback, (void*)&stPool);
+        Thread_Start( &stTestThread1 );
+
+        BlockPool_Free( &stPool, apvPoolBlocks[0] );
+    }
+}
+
+//---------------------------------------------------------------------------
+static void Heap_Profiling()
+{
+    void *apvData[4];
+    K_USHORT i;
+
+    Heap_Init( &stHeap, (void*)aucTestStack1, TEST_STACK1_SIZE, HEAP_LOCK_CRITICAL );
+
+    // Typical case - a block of the requested size is already free
+    apvData[0] = Heap_Alloc( &stHeap, HEAP_TEST_SIZE );
+    apvData[1] = Heap_Alloc( &stHeap, HEAP_TEST_SIZE );
+    Heap_Free( &stHeap, apvData[0] );
+    for (i = 0; i < 100; i++)
+    {
+        ProfileTimer_Start( &stHeapAllocTimer );
+        apvData[0] = Heap_Alloc( &stHeap, HEAP_TEST_SIZE );
+        ProfileTimer_Stop( &stHeapAllocTimer );
+
+        ProfileTimer_Start( &stHeapFreeTimer );
+        Heap_Free( &stHeap, apvData[0] );
+        ProfileTimer_Stop( &stHeapFreeTimer );
+    }
+    Heap_Free( &stHeap, apvData[1] );
+
+    for (i = 0; i < 100; i++)
+    {
+        // Worst-case allocation: the only free block is in a higher size
+        // range than the request, and must be split.
+        ProfileTimer_Start( &stHeapAllocWorstTimer );
+        apvData[0] = Heap_Alloc( &stHeap, 1 );
+        ProfileTimer_Stop( &stHeapAllocWorstTimer );
+
+        apvData[1] = Heap_Alloc( &stHeap, HEAP_TEST_SIZE );
+        apvData[2] = Heap_Alloc( &stHeap, HEAP_TEST_SIZE );
+        apvData[3] = Heap_Alloc( &stHeap, HEAP_TEST_SIZE );
+        Heap_Free( &stHeap, apvData[0] );
+        Heap_Free( &stHeap, apvData[2] );
+
+        // Worst-case free: the block is merged with free blocks on both sides
+        ProfileTimer_Start( &stHeapFreeWorstTimer );
+        Heap_Free( &stHeap, apvData[1] );
+        ProfileTimer_Stop( &stHeapFreeWorstTimer );
+
+        Heap_Free( &stHeap, apvData[3] );
+    }
+}
+
 //---------------------------------------------------------------------------
 static void Mutex_Profiling()
 {
@@ -327,6 +723,30 @@ static void Thread_Profiling()
     Scheduler_SetScheduler(1);
 }
 
+//---------------------------------------------------------------------------
+/*!
+ * Profile the scheduler with a thread ready at the given priority.  With the
+ * scheduler disabled, the test thread is made ready without being switched
+ * to, and is stopped again before re-enabling.
+ */
+static void Scheduler_ProfilePriority( ProfileTimer_t *pstTimer_, K_UCHAR ucPriority_ )
+{
+    K_USHORT i;
+
+    Scheduler_SetScheduler(0);
+    Thread_Init( &stTestThread1, aucTestStack1, TEST_STACK1_SIZE, ucPriority_, (ThreadEntry_t)Thread_ProfilingThread, NULL);
+    Thread_Start( &stTestThread1 );
+    for (i = 0; i < 100; i++)
+    {
+        ProfileTimer_Start( pstTimer_ );
+        Scheduler_Schedule();
+        ProfileTimer_Stop( pstTimer_ );
+    }
+    Thread_Stop( &stTestThread1 );
+    Scheduler_Schedule();
+    Scheduler_SetScheduler(1);
+}
+
 //---------------------------------------------------------------------------
 void Scheduler_Profiling()
 {
@@ -341,6 +761,22 @@ void Scheduler_Profiling()
         Scheduler_Schedule();
         ProfileTimer_Stop( &stSchedulerTimer );
     }    
+
+    // Compare against SC to verify that scheduling cost does not depend on
+    // the priority of the chosen thread.  SCH uses the highest configured
+    // priority; SC16/SC32/SC64 use the top level of a 16/32/64-priority map,
+    // which fall in different words of the ready bitmap when the build is
+    // configured with enough priorities to reach them.
+    Scheduler_ProfilePriority( &stSchedulerHighTimer, NUM_PRIORITIES - 1 );
+#if KERNEL_NUM_PRIORITIES >= 16
+    Scheduler_ProfilePriority( &stScheduler16Timer, 15 );
+#endif
+#if KERNEL_NUM_PRIORITIES >= 32
+    Scheduler_ProfilePriority( &stScheduler32Timer, 31 );
+#endif
+#if KERNEL_NUM_PRIORITIES >= 64
+    Scheduler_ProfilePriority( &stScheduler64Timer, 63 );
+#endif
 }
 
 //---------------------------------------------------------------------------
@@ -359,21 +795,95 @@ static void PrintWait( Driver_t *pstDriver_, K_USHORT usSize_, const K_CHAR *dat
 }
 
 //---------------------------------------------------------------------------
-void ProfilePrint( ProfileTimer_t *pstProfile, const K_CHAR *szName_ )
+static void PrintValue( Driver_t *pstDriver_, K_ULONG ulVal_ )
 {
-    Driver_t *pstUART = DriverList_FindByPath("/dev/tty");
     K_CHAR szBuf[16];
-    K_ULONG ulVal = ProfileTimer_GetAverage( pstProfile ) - ProfileTimer_GetAverage( &stProfileOverhead );
-    ulVal *= 8;
     int i;
     for( i = 0; i < 16; i++ )
     {
         szBuf[i] = 0;
     }
     szBuf[0] = '0';
+
+    KUtil_Ultoa(ulVal_, szBuf);
+    PrintWait( pstDriver_, KUtil_Strlen(szBuf), szBuf );
+}
+
+//---------------------------------------------------------------------------
+// Convert a raw profiling timer count to cycles, less the profiling overhead
+static K_ULONG ProfileCycles( K_ULONG ulTicks_ )
+{
+    K_ULONG ulOverhead = ProfileTimer_GetAverage( &stProfileOverhead );
+    if (ulTicks_ < ulOverhead)
+    {
+        return 0;
+    }
+    return (ulTicks_ - ulOverhead) * 8;
+}
+
+//---------------------------------------------------------------------------
+void ProfilePrint( ProfileTimer_t *pstProfile, const K_CHAR *szName_ )
+{
+    Driver_t *pstUART = DriverList_FindByPath("/dev/tty");
     
     PrintWait( pstUART, KUtil_Strlen(szName_), szName_ );    
     PrintWait( pstUART, 2, ": " );
+    PrintValue( pstUART, ProfileCycles( ProfileTimer_GetAverage( pstProfile ) ) );
+    PrintWait( pstUART, 1, "\n" );
+}
+
+//---------------------------------------------------------------------------
+// Print the best/worst case in cycles as <name>MIN/<name>MAX, followed by
+// the histogram as <name>HIST - one count per bucket, where bucket n holds
+// iterations of (8 * 2^n) to (8 * 2^(n+1)) - 1 raw cycles.
+void ProfilePrintStats( ProfileTimer_t *pstProfile, K_USHORT *pusHist_, const K_CHAR *szName_ )
+{
+    Driver_t *pstUART = DriverList_FindByPath("/dev/tty");
+    K_UCHAR i;
+
+    PrintWait( pstUART, KUtil_Strlen(szName_), szName_ );
+    PrintWait( pstUART, 5, "MIN: " );
+    PrintValue( pstUART, ProfileCycles( ProfileTimer_GetMin( pstProfile ) ) );
+    PrintWait( pstUART, 1, "\n" );
+
+    PrintWait( pstUART, KUtil_Strlen(szName_), szName_ );
+    PrintWait( pstUART, 5, "MAX: " );
+    PrintValue( pstUART, ProfileCycles( ProfileTimer_GetMax( pstProfile ) ) );
+    PrintWait( pstUART, 1, "\n" );
+
+    PrintWait( pstUART, KUtil_Strlen(szName_), szName_ );
+    PrintWait( pstUART, 5, "HIST:" );
+    for (i = 0; i < PROFILE_HISTOGRAM_BUCKETS; i++)
+    {
+        PrintWait( pstUART, 1, " " );
+        PrintValue( pstUART, pusHist_[i] );
+    }
+    PrintWait( pstUART, 1, "\n" );
+}
+
+//---------------------------------------------------------------------------
+void ProfilePrintRate( ProfileTimer_t *pstProfile, K_ULONG ulElements_, const K_CHAR *szName_ )
+{
+    Driver_t *pstUART = DriverList_FindByPath("/dev/tty");
+    K_CHAR szBuf[16];
+    K_ULONG ulCycles = ProfileTimer_GetAverage( pstProfile ) - ProfileTimer_GetAverage( &stProfileOverhead );
+    K_ULONG ulVal = 0;
+    int i;
+
+    // Convert the time per iteration to elements per second
+    ulCycles *= 8;
+    if (ulCycles)
+    {
+        ulVal = (SYSTEM_FREQ / ulCycles) * ulElements_;
+    }
+    for( i = 0; i < 16; i++ )
+    {
+        szBuf[i] = 0;
+    }
+    szBuf[0] = '0';
+
+    PrintWait( pstUART, KUtil_Strlen(szName_), szName_ );
+    PrintWait( pstUART, 2, ": " );
     KUtil_Ultoa(ulVal, szBuf);
     PrintWait( pstUART, KUtil_Strlen(szBuf), szBuf );
     PrintWait( pstUART, 1, "\n" );
@@ -389,11 +899,46 @@ void ProfilePrintResults()
     ProfilePrint( &stSemPendTimer, "SPo");
     ProfilePrint( &stSemPostTimer, "SPe");
     ProfilePrint( &stSemaphoreFlyback, "SF");
+    ProfilePrint( &stNotifyFlyback, "TNF");
+#if KERNEL_USE_DPC
+    ProfilePrint( &stDpcFlyback, "DPF");
+#endif
+    ProfilePrint( &stGetTimeTimer, "KGT");
+    ProfilePrint( &astSemPostWaitTimer[0], "SPW1");
+    ProfilePrint( &astSemPostWaitTimer[1], "SPW2");
+    ProfilePrint( &astSemPostWaitTimer[2], "SPW4");
+    ProfilePrint( &astFlagSetWaitTimer[0], "EFW1");
+    ProfilePrint( &astFlagSetWaitTimer[1], "EFW2");
+    ProfilePrint( &astFlagSetWaitTimer[2], "EFW4");
     ProfilePrint( &stThreadExitTimer, "TE");
     ProfilePrint( &stThreadInitTimer, "TI");
     ProfilePrint( &stThreadStartTimer, "TS");
     ProfilePrint( &stContextSwitchTimer, "CS");
     ProfilePrint( &stSchedulerTimer, "SC");
+    ProfilePrint( &stSchedulerHighTimer, "SCH");
+#if KERNEL_NUM_PRIORITIES >= 16
+    ProfilePrint( &stScheduler16Timer, "SC16");
+#endif
+#if KERNEL_NUM_PRIORITIES >= 32
+    ProfilePrint( &stScheduler32Timer, "SC32");
+#endif
+#if KERNEL_NUM_PRIORITIES >= 64
+    ProfilePrint( &stScheduler64Timer, "SC64");
+#endif
+    ProfilePrintRate( &astMailBoxBatchTimer[0], MBOX_ELEMENTS, "MB1");
+    ProfilePrintRate( &astMailBoxBatchTimer[1], MBOX_ELEMENTS, "MB4");
+    ProfilePrintRate( &astMailBoxBatchTimer[2], MBOX_ELEMENTS, "MB16");
+    ProfilePrintRate( &astMailBoxBatchTimer[3], MBOX_ELEMENTS, "MB32");
+    ProfilePrint( &stBlockAllocTimer, "BPA");
+    ProfilePrint( &stBlockFreeTimer, "BPF");
+    ProfilePrint( &stBlockFlybackTimer, "BPW");
+    ProfilePrint( &stHeapAllocTimer, "HA");
+    ProfilePrint( &stHeapFreeTimer, "HF");
+    ProfilePrint( &stHeapAllocWorstTimer, "HAW");
+    ProfilePrint( &stHeapFreeWorstTimer, "HFW");
+    ProfilePrintStats( &stContextSwitchTimer, ausContextSwitchHist, "CS");
+    ProfilePrintStats( &stSemaphoreFlyback, ausSemaphoreFlybackHist, "SF");
+    ProfilePrintStats( &stSchedulerTimer, ausSchedulerHist, "SC");
 }
 
 #endif
@@ -429,6 +974,16 @@ static void AppMain( void *unused )
         Profiler_Start();
         ProfileOverhead();        
         Semaphore_Profiling();
+        Notify_Profiling();
+#if KERNEL_USE_DPC
+        Dpc_Profiling();
+#endif
+        Time_Profiling();
+        Semaphore_WaiterProfiling();
+        EventFlag_WaiterProfiling();
+        MailBox_Profiling();
+        BlockPool_Profiling();
+        Heap_Profiling();
         Mutex_Profiling();
         Thread_Profiling();
         Scheduler_Profiling();
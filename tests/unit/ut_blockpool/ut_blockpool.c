@@ -0,0 +1,163 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+
+#include "kerneltypes.h"
+#include "kernel.h"
+#include "../ut_platform.h"
+#include "mark3.h"
+#include "blockpool.h"
+
+//===========================================================================
+// Local Defines
+//===========================================================================
+
+#define POOL_BLOCK_SIZE     (8)
+#define POOL_BLOCKS         (8)
+
+static Thread_t stPoolThread;
+static K_WORD akPoolStack[160];
+
+static BlockPool_t stPool;
+static K_ULONG aulPoolBuffer[(POOL_BLOCK_SIZE * POOL_BLOCKS) / sizeof(K_ULONG)];
+static void *apvBlocks[POOL_BLOCKS];
+
+static Timer_t stPoolTimer;
+static void * volatile pvThreadBlock;
+
+//===========================================================================
+// Define Test Cases Here
+//===========================================================================
+TEST(blockpool_alloc_free)
+{
+    K_UCHAR i;
+    K_UCHAR j;
+
+    BlockPool_Init( &stPool, (void*)aulPoolBuffer, sizeof(aulPoolBuffer), POOL_BLOCK_SIZE );
+    EXPECT_EQUALS( BlockPool_GetBlockSize( &stPool ), POOL_BLOCK_SIZE );
+    EXPECT_EQUALS( BlockPool_GetFree( &stPool ), POOL_BLOCKS );
+
+    // Allocate every block, and fill each with a unique pattern
+    for (i = 0; i < POOL_BLOCKS; i++)
+    {
+        apvBlocks[i] = BlockPool_TryAlloc( &stPool );
+        EXPECT_FAIL_FALSE( apvBlocks[i] );
+        EXPECT_GTE( (K_ADDR)apvBlocks[i], (K_ADDR)aulPoolBuffer );
+        EXPECT_LT( (K_ADDR)apvBlocks[i], (K_ADDR)aulPoolBuffer + sizeof(aulPoolBuffer) );
+        for (j = 0; j < POOL_BLOCK_SIZE; j++)
+        {
+            ((K_UCHAR*)apvBlocks[i])[j] = i;
+        }
+    }
+
+    // No block was handed out twice
+    for (i = 0; i < POOL_BLOCKS; i++)
+    {
+        for (j = 0; j < POOL_BLOCK_SIZE; j++)
+        {
+            EXPECT_EQUALS( ((K_UCHAR*)apvBlocks[i])[j], i );
+        }
+    }
+
+    EXPECT_FALSE( BlockPool_TryAlloc( &stPool ) );
+    EXPECT_EQUALS( BlockPool_GetFree( &stPool ), 0 );
+    EXPECT_EQUALS( BlockPool_GetInUse( &stPool ), POOL_BLOCKS );
+    EXPECT_EQUALS( BlockPool_GetHighWater( &stPool ), POOL_BLOCKS );
+    EXPECT_EQUALS( BlockPool_GetFailures( &stPool ), 1 );
+
+    for (i = 0; i < POOL_BLOCKS; i++)
+    {
+        BlockPool_Free( &stPool, apvBlocks[i] );
+    }
+    EXPECT_EQUALS( BlockPool_GetFree( &stPool ), POOL_BLOCKS );
+    EXPECT_EQUALS( BlockPool_GetInUse( &stPool ), 0 );
+
+    // The most recently freed block is re-used first
+    EXPECT_TRUE( BlockPool_Alloc( &stPool ) == apvBlocks[POOL_BLOCKS - 1] );
+
+    BlockPool_ResetStats( &stPool );
+    EXPECT_EQUALS( BlockPool_GetHighWater( &stPool ), 1 );
+    EXPECT_EQUALS( BlockPool_GetFailures( &stPool ), 0 );
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+void pool_alloc_thread(void *unused_)
+{
+    pvThreadBlock = BlockPool_Alloc( &stPool );
+    Thread_Exit( &stPoolThread );
+}
+
+TEST(blockpool_blocking_alloc)
+{
+    K_UCHAR i;
+
+    BlockPool_Init( &stPool, (void*)aulPoolBuffer, sizeof(aulPoolBuffer), POOL_BLOCK_SIZE );
+    for (i = 0; i < POOL_BLOCKS; i++)
+    {
+        apvBlocks[i] = BlockPool_Alloc( &stPool );
+    }
+
+    EXPECT_FALSE( BlockPool_TimedAlloc( &stPool, 10 ) );
+    EXPECT_EQUALS( BlockPool_GetFailures( &stPool ), 1 );
+
+    // A higher-priority thread blocks on the empty pool, and receives the
+    // block as soon as it is freed.
+    pvThreadBlock = NULL;
+    Thread_Init( &stPoolThread, akPoolStack, 160, 7, pool_alloc_thread, 0);
+    Thread_Start( &stPoolThread );
+    EXPECT_TRUE( pvThreadBlock == NULL );
+
+    BlockPool_Free( &stPool, apvBlocks[3] );
+    EXPECT_TRUE( pvThreadBlock == apvBlocks[3] );
+    EXPECT_EQUALS( BlockPool_GetFree( &stPool ), 0 );
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+void pool_timer_free(Thread_t *pstOwner_, void *pvData_)
+{
+    // Runs from the kernel timer interrupt
+    BlockPool_Free( &stPool, pvData_ );
+}
+
+TEST(blockpool_isr_free)
+{
+    K_UCHAR i;
+    void *pvBlock;
+
+    BlockPool_Init( &stPool, (void*)aulPoolBuffer, sizeof(aulPoolBuffer), POOL_BLOCK_SIZE );
+    for (i = 0; i < POOL_BLOCKS; i++)
+    {
+        apvBlocks[i] = BlockPool_Alloc( &stPool );
+    }
+
+    Timer_Init( &stPoolTimer );
+    Timer_Start( &stPoolTimer, false, 20, pool_timer_free, apvBlocks[5] );
+
+    pvBlock = BlockPool_TimedAlloc( &stPool, 100 );
+    EXPECT_TRUE( pvBlock == apvBlocks[5] );
+    EXPECT_EQUALS( BlockPool_GetFailures( &stPool ), 0 );
+}
+TEST_END
+
+//===========================================================================
+// Test Whitelist Goes Here
+//===========================================================================
+TEST_CASE_START
+  TEST_CASE(blockpool_alloc_free),
+  TEST_CASE(blockpool_blocking_alloc),
+  TEST_CASE(blockpool_isr_free),
+TEST_CASE_END
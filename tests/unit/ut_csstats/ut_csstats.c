@@ -0,0 +1,136 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+
+#include "kerneltypes.h"
+#include "kernel.h"
+#include "../ut_platform.h"
+#include "mark3.h"
+#include "csstats.h"
+
+//===========================================================================
+// Local Defines
+//===========================================================================
+
+#if KERNEL_USE_CS_STATS
+static CSStats_t stStats;
+
+//---------------------------------------------------------------------------
+// Kernel_GetTime() takes a nested critical section, which isn't timed
+static void busy_wait( K_ULONG ulUs_ )
+{
+    K_ULONGLONG ullStart = Kernel_GetTime();
+    while ((Kernel_GetTime() - ullStart) < ulUs_) { /* Spin */ }
+}
+#endif
+
+//===========================================================================
+// Define Test Cases Here
+//===========================================================================
+TEST(csstats_max)
+{
+#if KERNEL_USE_CS_STATS
+    K_USHORT usLine;
+
+    CSStats_Reset();
+
+    // A long section, then a short one - the long one is kept, with the
+    // location of its CS_ENTER()
+    usLine = __LINE__ + 1;
+    CS_ENTER();
+    busy_wait( 500 );
+    CS_EXIT();
+
+    CS_ENTER();
+    busy_wait( 50 );
+    CS_EXIT();
+
+    CSStats_Get( &stStats );
+    EXPECT_GTE( stStats.ulMaxUs, 500 );
+    EXPECT_LTE( stStats.ulMaxUs, 600 );
+    EXPECT_EQUALS( stStats.usMaxFile, __FILE_ID__ );
+    EXPECT_EQUALS( stStats.usMaxLine, usLine );
+    EXPECT_GTE( stStats.ulCount, 2 );
+#endif
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(csstats_nested)
+{
+#if KERNEL_USE_CS_STATS
+    K_USHORT usLine;
+
+    CSStats_Reset();
+
+    // Only the outermost section is timed, from where it started
+    usLine = __LINE__ + 1;
+    CS_ENTER();
+    busy_wait( 200 );
+    CS_ENTER();
+    busy_wait( 200 );
+    CS_EXIT();
+    CS_EXIT();
+
+    CSStats_Get( &stStats );
+    EXPECT_GTE( stStats.ulMaxUs, 400 );
+    EXPECT_LTE( stStats.ulMaxUs, 500 );
+    EXPECT_EQUALS( stStats.usMaxLine, usLine );
+#endif
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(csstats_histogram)
+{
+#if KERNEL_USE_CS_STATS
+    K_UCHAR i;
+    K_ULONG ulTotal = 0;
+
+    CSStats_Reset();
+
+    // 300us lands in the 256-511us bucket
+    for (i = 0; i < 3; i++)
+    {
+        CS_ENTER();
+        busy_wait( 300 );
+        CS_EXIT();
+    }
+
+    CSStats_Get( &stStats );
+    EXPECT_EQUALS( stStats.ausHistogram[8], 3 );
+    for (i = 0; i < CS_STATS_HISTOGRAM_BUCKETS; i++)
+    {
+        ulTotal += stStats.ausHistogram[i];
+    }
+    EXPECT_EQUALS( ulTotal, stStats.ulCount );
+
+    // Reset clears everything
+    CSStats_Reset();
+    CSStats_Get( &stStats );
+    EXPECT_EQUALS( stStats.ausHistogram[8], 0 );
+    EXPECT_LTE( stStats.ulMaxUs, 100 );
+#endif
+}
+TEST_END
+
+//===========================================================================
+// Test Whitelist Goes Here
+//===========================================================================
+TEST_CASE_START
+  TEST_CASE(csstats_max),
+  TEST_CASE(csstats_nested),
+  TEST_CASE(csstats_histogram),
+TEST_CASE_END
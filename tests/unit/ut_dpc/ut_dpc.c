@@ -0,0 +1,142 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+
+#include "kerneltypes.h"
+#include "kernel.h"
+#include "../ut_platform.h"
+#include "mark3.h"
+#include "dpc.h"
+
+//===========================================================================
+// Local Defines
+//===========================================================================
+#if KERNEL_USE_DPC
+static Dpc_t astDpc[3];
+static Timer_t stDpcTimer;
+
+static volatile K_UCHAR aucOrder[4];
+static volatile K_UCHAR ucOrderCount;
+static volatile K_USHORT usRuns;
+static volatile K_USHORT usBadContext;
+
+//===========================================================================
+// Define Test Cases Here
+//===========================================================================
+void dpc_record( void *pvData_ )
+{
+    Thread_t *pstCurrent = Scheduler_GetCurrentThread();
+
+    // Every DPC must run in the DPC thread, not in the caller's context
+    if (Thread_GetPriority( pstCurrent ) != DPC_THREAD_PRIORITY)
+    {
+        usBadContext++;
+    }
+
+    if (ucOrderCount < 4)
+    {
+        aucOrder[ucOrderCount++] = (K_UCHAR)(K_ADDR)pvData_;
+    }
+    usRuns++;
+}
+
+//---------------------------------------------------------------------------
+static void dpc_reset( void )
+{
+    K_UCHAR i;
+
+    for (i = 0; i < 3; i++)
+    {
+        Dpc_Init( &astDpc[i], dpc_record, (void*)(K_ADDR)(i + 1) );
+    }
+    ucOrderCount = 0;
+    usRuns = 0;
+    usBadContext = 0;
+}
+#endif
+
+//---------------------------------------------------------------------------
+TEST(dpc_queue)
+{
+#if KERNEL_USE_DPC
+    dpc_reset();
+
+    // The DPC thread outranks us, so the DPC runs before Dpc_Queue returns
+    EXPECT_TRUE( Dpc_Queue( &astDpc[0] ) );
+    EXPECT_EQUALS( usRuns, 1 );
+    EXPECT_FALSE( Dpc_IsQueued( &astDpc[0] ) );
+    EXPECT_EQUALS( usBadContext, 0 );
+
+    // ... and can be queued again once it has run
+    EXPECT_TRUE( Dpc_Queue( &astDpc[0] ) );
+    EXPECT_EQUALS( usRuns, 2 );
+#endif
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(dpc_order)
+{
+#if KERNEL_USE_DPC
+    dpc_reset();
+
+    // Hold the DPC thread off while the queue fills
+    Scheduler_SetScheduler( false );
+    EXPECT_TRUE( Dpc_Queue( &astDpc[1] ) );
+    EXPECT_TRUE( Dpc_Queue( &astDpc[0] ) );
+    EXPECT_TRUE( Dpc_Queue( &astDpc[2] ) );
+
+    // Queueing a DPC that is still pending doesn't run it twice
+    EXPECT_FALSE( Dpc_Queue( &astDpc[0] ) );
+    EXPECT_TRUE( Dpc_IsQueued( &astDpc[0] ) );
+    EXPECT_EQUALS( usRuns, 0 );
+    Scheduler_SetScheduler( true );
+
+    EXPECT_EQUALS( usRuns, 3 );
+    EXPECT_EQUALS( aucOrder[0], 2 );
+    EXPECT_EQUALS( aucOrder[1], 1 );
+    EXPECT_EQUALS( aucOrder[2], 3 );
+    EXPECT_EQUALS( usBadContext, 0 );
+#endif
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(dpc_timer)
+{
+#if KERNEL_USE_DPC
+    dpc_reset();
+
+    // Timer expiry work is moved out of the timer interrupt
+    Timer_Init( &stDpcTimer );
+    Timer_Start( &stDpcTimer, true, 5, Dpc_TimerCallback, (void*)&astDpc[0] );
+    Thread_Sleep(52);
+    Timer_Stop( &stDpcTimer );
+
+    EXPECT_GTE( usRuns, 9 );
+    EXPECT_LTE( usRuns, 11 );
+    EXPECT_EQUALS( usBadContext, 0 );
+#endif
+}
+TEST_END
+
+//===========================================================================
+// Test Whitelist Goes Here
+//===========================================================================
+TEST_CASE_START
+  TEST_CASE(dpc_queue),
+  TEST_CASE(dpc_order),
+  TEST_CASE(dpc_timer),
+TEST_CASE_END
@@ -131,6 +131,28 @@ void TimedWaitAll(void *time_)
     Thread_Exit( Scheduler_GetCurrentThread() );
 }
 
+#if KERNEL_EVENTFLAG_BITS == 32
+//---------------------------------------------------------------------------
+void WaitOnWideAll(void *mask_)
+{
+    K_FLAG_MASK tMask = *((K_FLAG_MASK*)mask_);
+    EventFlag_Wait( &stFlagGroup, tMask, EVENT_FLAG_ALL);
+    ucFlagCount++;
+
+    Thread_Exit( Scheduler_GetCurrentThread() );
+}
+
+//---------------------------------------------------------------------------
+void WaitOnWideAny(void *mask_)
+{
+    K_FLAG_MASK tMask = *((K_FLAG_MASK*)mask_);
+    EventFlag_Wait( &stFlagGroup, tMask, EVENT_FLAG_ANY);
+    ucFlagCount++;
+
+    Thread_Exit( Scheduler_GetCurrentThread() );
+}
+#endif
+
 //===========================================================================
 // Define Test Cases Here
 //===========================================================================
@@ -420,6 +442,65 @@ TEST(ut_flag_multiwait)
 }
 TEST_END
 
+#if KERNEL_EVENTFLAG_BITS == 32
+//===========================================================================
+TEST(ut_flag_wide)
+{
+    // Test - ensure that bits in the upper half of a 32-bit mask work, with
+    // threads waiting on different bits of the same object.
+    K_FLAG_MASK tMaskAll = 0x80000001;
+    K_FLAG_MASK tMaskAny = 0x00030000;
+
+    EventFlag_Init( &stFlagGroup );
+    ucFlagCount = 0;
+
+    Thread_Init( &stThread1, aucThreadStack1, THREAD1_STACK_SIZE, 7, WaitOnWideAll, (void*)&tMaskAll);
+    Thread_Init( &stThread2, aucThreadStack2, THREAD2_STACK_SIZE, 7, WaitOnWideAny, (void*)&tMaskAny);
+    Thread_Start( &stThread1 );
+    Thread_Start( &stThread2 );
+
+    Thread_Sleep(100);
+    EXPECT_EQUALS(ucFlagCount, 0);
+
+    // Half of the "all" pattern, and none of the "any" pattern
+    EventFlag_Set( &stFlagGroup, 0x80000000);
+    Thread_Sleep(100);
+    EXPECT_EQUALS(ucFlagCount, 0);
+
+    EventFlag_Set( &stFlagGroup, 0x00020000);
+    Thread_Sleep(100);
+    EXPECT_EQUALS(ucFlagCount, 1);
+
+    EventFlag_Set( &stFlagGroup, 0x00000001);
+    Thread_Sleep(100);
+    EXPECT_EQUALS(ucFlagCount, 2);
+    EXPECT_EQUALS(EventFlag_GetMask( &stFlagGroup ), 0x80020001);
+
+    // Test point - set the bits of the "all" pattern in the opposite order,
+    // so the waiting thread is still blocked after the first bit is set.
+    EventFlag_Init( &stFlagGroup );
+    ucFlagCount = 0;
+
+    Thread_Init( &stThread1, aucThreadStack1, THREAD1_STACK_SIZE, 7, WaitOnWideAll, (void*)&tMaskAll);
+    Thread_Start( &stThread1 );
+
+    Thread_Sleep(100);
+    EventFlag_Set( &stFlagGroup, 0x00000001);
+    Thread_Sleep(100);
+    EXPECT_EQUALS(ucFlagCount, 0);
+
+    EventFlag_Clear( &stFlagGroup, 0x00000001);
+    EventFlag_Set( &stFlagGroup, 0x80000000);
+    Thread_Sleep(100);
+    EXPECT_EQUALS(ucFlagCount, 0);
+
+    EventFlag_Set( &stFlagGroup, 0x00000001);
+    Thread_Sleep(100);
+    EXPECT_EQUALS(ucFlagCount, 1);
+}
+TEST_END
+#endif
+
 //===========================================================================
 TEST(ut_timedwait)
 {
@@ -539,5 +620,8 @@ TEST_CASE_START
   TEST_CASE(ut_waitany),
   TEST_CASE(ut_waitall),
   TEST_CASE(ut_flag_multiwait),
+#if KERNEL_EVENTFLAG_BITS == 32
+  TEST_CASE(ut_flag_wide),
+#endif
   TEST_CASE(ut_timedwait),
 TEST_CASE_END
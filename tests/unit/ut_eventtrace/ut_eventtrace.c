@@ -0,0 +1,256 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+
+#include "kerneltypes.h"
+#include "kernel.h"
+#include "../ut_platform.h"
+#include "mark3.h"
+#include "eventtrace.h"
+
+//===========================================================================
+// Local Defines
+//===========================================================================
+#if KERNEL_USE_EVENT_TRACE
+
+#define CAPTURE_RECORDS     (32)
+#define OFF_CODE            (0xEE)
+
+static Thread_t stWorkThread;
+static K_WORD akWorkStack[160];
+
+static Semaphore_t stSemA;
+static Semaphore_t stSemB;
+
+static K_USHORT ausCapture[ CAPTURE_RECORDS * EVENT_TRACE_RECORD_SIZE ];
+static volatile K_USHORT usCaptured;
+
+//---------------------------------------------------------------------------
+static void capture( K_USHORT *pusData_, K_USHORT usSize_ )
+{
+    K_USHORT i;
+    for (i = 0; i < usSize_; i++)
+    {
+        if (usCaptured < (CAPTURE_RECORDS * EVENT_TRACE_RECORD_SIZE))
+        {
+            ausCapture[usCaptured++] = pusData_[i];
+        }
+    }
+}
+
+//---------------------------------------------------------------------------
+static void start_capture( void )
+{
+    usCaptured = 0;
+    EventTrace_SetCallback( capture );
+    EventTrace_Enable( true );
+}
+
+//---------------------------------------------------------------------------
+static void stop_capture( void )
+{
+    // Hand everything recorded so far to the callback
+    EventTrace_Enable( false );
+    EventTrace_Flush();
+}
+
+//---------------------------------------------------------------------------
+#define RECORD(x)           (&ausCapture[(x) * EVENT_TRACE_RECORD_SIZE])
+#define RECORD_EVENT(x)     ((K_UCHAR)(RECORD(x)[0] >> 8))
+#define RECORD_ID(x)        ((K_UCHAR)(RECORD(x)[0] & 0xFF))
+#define RECORD_TIME(x)      ((K_ULONG)RECORD(x)[1] | ((K_ULONG)RECORD(x)[2] << 16))
+#define RECORD_ARG(x)       (RECORD(x)[3])
+
+//---------------------------------------------------------------------------
+/*!
+    Find the next scheduling record (switch, block or unblock) at or after
+    the given index, skipping over interrupts, timers and user markers.
+*/
+static K_USHORT next_sched( K_USHORT usIdx_ )
+{
+    K_USHORT usRecords = usCaptured / EVENT_TRACE_RECORD_SIZE;
+    while (usIdx_ < usRecords)
+    {
+        K_UCHAR ucEvent = RECORD_EVENT(usIdx_);
+        if ((ucEvent == EVENT_TRACE_SWITCH) ||
+            (ucEvent == EVENT_TRACE_BLOCK) ||
+            (ucEvent == EVENT_TRACE_UNBLOCK))
+        {
+            break;
+        }
+        usIdx_++;
+    }
+    return usIdx_;
+}
+
+//---------------------------------------------------------------------------
+static void work_thread( void *unused_ )
+{
+    while (1)
+    {
+        Semaphore_Pend( &stSemA );
+        Semaphore_Post( &stSemB );
+    }
+}
+#endif
+
+//===========================================================================
+// Define Test Cases Here
+//===========================================================================
+TEST(trace_user)
+{
+#if KERNEL_USE_EVENT_TRACE
+    K_USHORT usRecords;
+    K_USHORT i;
+    K_UCHAR ucNext = 0;
+
+    start_capture();
+    for (i = 0; i < 4; i++)
+    {
+        EventTrace_User( i, i * 3 );
+    }
+    stop_capture();
+
+    // Every record is handed over whole, and user events come out in order
+    // with their data intact.
+    EXPECT_EQUALS( usCaptured % EVENT_TRACE_RECORD_SIZE, 0 );
+    usRecords = usCaptured / EVENT_TRACE_RECORD_SIZE;
+    for (i = 0; i < usRecords; i++)
+    {
+        if ((RECORD_EVENT(i) == EVENT_TRACE_USER) && (RECORD_ID(i) == ucNext))
+        {
+            EXPECT_EQUALS( RECORD_ARG(i), ucNext * 3 );
+            ucNext++;
+        }
+    }
+    EXPECT_EQUALS( ucNext, 4 );
+
+    // Nothing is recorded while disabled, and a flushed record is never
+    // handed over twice
+    usCaptured = 0;
+    for (i = 0; i < (EVENT_TRACE_BUFFER_SIZE / EVENT_TRACE_RECORD_SIZE); i++)
+    {
+        EventTrace_User( OFF_CODE, 0 );
+    }
+    EventTrace_Flush();
+    EXPECT_EQUALS( usCaptured, 0 );
+#endif
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(trace_switch)
+{
+#if KERNEL_USE_EVENT_TRACE
+    Thread_t *pstMe = Scheduler_GetCurrentThread();
+    K_UCHAR ucWorker;
+    K_USHORT usIdx;
+
+    Semaphore_Init( &stSemA, 0, 1 );
+    Semaphore_Init( &stSemB, 0, 1 );
+    Thread_Init( &stWorkThread, akWorkStack, sizeof(akWorkStack), 6, work_thread, 0 );
+    Thread_Start( &stWorkThread );
+    ucWorker = Thread_GetID( &stWorkThread );
+
+    start_capture();
+    Semaphore_Post( &stSemA );
+    Semaphore_Pend( &stSemB );
+    stop_capture();
+
+    // Kicking the worker unblocks it and switches to it straight away...
+    usIdx = next_sched( 0 );
+    while ((usIdx < (usCaptured / EVENT_TRACE_RECORD_SIZE)) &&
+           !((RECORD_EVENT(usIdx) == EVENT_TRACE_UNBLOCK) && (RECORD_ID(usIdx) == ucWorker)))
+    {
+        usIdx = next_sched( usIdx + 1 );
+    }
+    EXPECT_EQUALS( RECORD_EVENT(usIdx), EVENT_TRACE_UNBLOCK );
+    EXPECT_EQUALS( RECORD_ARG(usIdx), (K_USHORT)(K_ADDR)&stSemA );
+
+    usIdx = next_sched( usIdx + 1 );
+    EXPECT_EQUALS( RECORD_EVENT(usIdx), EVENT_TRACE_SWITCH );
+    EXPECT_EQUALS( RECORD_ID(usIdx), ucWorker );
+    EXPECT_EQUALS( RECORD_ARG(usIdx) & 0xFF, Thread_GetID( pstMe ) );
+    EXPECT_EQUALS( RECORD_ARG(usIdx) >> 8, 6 );
+
+    // ... which blocks again once it's done, switching back
+    usIdx = next_sched( usIdx + 1 );
+    EXPECT_EQUALS( RECORD_EVENT(usIdx), EVENT_TRACE_BLOCK );
+    EXPECT_EQUALS( RECORD_ID(usIdx), ucWorker );
+
+    usIdx = next_sched( usIdx + 1 );
+    EXPECT_EQUALS( RECORD_EVENT(usIdx), EVENT_TRACE_SWITCH );
+    EXPECT_EQUALS( RECORD_ID(usIdx), Thread_GetID( pstMe ) );
+    EXPECT_EQUALS( RECORD_ARG(usIdx) & 0xFF, ucWorker );
+
+    Thread_Stop( &stWorkThread );
+#endif
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(trace_timer)
+{
+#if KERNEL_USE_EVENT_TRACE
+    K_USHORT usRecords;
+    K_USHORT i;
+    K_UCHAR ucMe = Thread_GetID( Scheduler_GetCurrentThread() );
+    K_UCHAR ucEnter = 0;
+    K_UCHAR ucExit = 0;
+    K_UCHAR ucTimer = 0;
+    K_UCHAR ucBackwards = 0;
+
+    start_capture();
+    Thread_Sleep(5);
+    stop_capture();
+
+    // The sleep timer fires from within the kernel timer interrupt, and
+    // records are in time order.
+    usRecords = usCaptured / EVENT_TRACE_RECORD_SIZE;
+    for (i = 0; i < usRecords; i++)
+    {
+        if (RECORD_EVENT(i) == EVENT_TRACE_ISR_ENTER)
+        {
+            ucEnter++;
+        }
+        else if (RECORD_EVENT(i) == EVENT_TRACE_ISR_EXIT)
+        {
+            ucExit++;
+        }
+        else if ((RECORD_EVENT(i) == EVENT_TRACE_TIMER) && (RECORD_ID(i) == ucMe))
+        {
+            EXPECT_EQUALS( ucEnter, ucExit + 1 );
+            ucTimer++;
+        }
+        if (i && (RECORD_TIME(i) < RECORD_TIME(i - 1)))
+        {
+            ucBackwards++;
+        }
+    }
+    EXPECT_GT( ucEnter, 0 );
+    EXPECT_EQUALS( ucTimer, 1 );
+    EXPECT_EQUALS( ucBackwards, 0 );
+#endif
+}
+TEST_END
+
+//===========================================================================
+// Test Whitelist Goes Here
+//===========================================================================
+TEST_CASE_START
+  TEST_CASE(trace_user),
+  TEST_CASE(trace_switch),
+  TEST_CASE(trace_timer),
+TEST_CASE_END
@@ -0,0 +1,330 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+
+#include "kerneltypes.h"
+#include "kernel.h"
+#include "../ut_platform.h"
+#include "mark3.h"
+#include "heap.h"
+
+//===========================================================================
+// Local Defines
+//===========================================================================
+
+#define HEAP_ARENA_SIZE     (256)
+
+static Heap_t stHeap;
+static K_ULONG aulArena[HEAP_ARENA_SIZE / sizeof(K_ULONG)];
+static HeapStats_t stStats;
+
+static Thread_t stHeapThread;
+static K_WORD akHeapStack[160];
+
+static Timer_t stHeapTimer;
+static volatile K_USHORT usIsrAllocs;
+static volatile K_USHORT usIsrErrors;
+static volatile K_USHORT usThreadErrors;
+static volatile bool exit_flag;
+
+//---------------------------------------------------------------------------
+static void FillBlock( void *pvData_, K_ADDR tSize_, K_UCHAR ucVal_ )
+{
+    K_ADDR i;
+    for (i = 0; i < tSize_; i++)
+    {
+        ((K_UCHAR*)pvData_)[i] = ucVal_;
+    }
+}
+
+//---------------------------------------------------------------------------
+static bool CheckBlock( void *pvData_, K_ADDR tSize_, K_UCHAR ucVal_ )
+{
+    K_ADDR i;
+    for (i = 0; i < tSize_; i++)
+    {
+        if (((K_UCHAR*)pvData_)[i] != ucVal_)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//===========================================================================
+// Define Test Cases Here
+//===========================================================================
+TEST(heap_alloc_free)
+{
+    static const K_UCHAR aucSizes[6] = { 1, 7, 16, 30, 5, 48 };
+    void *apvData[6];
+    K_ADDR tInitialFree;
+    K_UCHAR i;
+
+    Heap_Init( &stHeap, (void*)aulArena, sizeof(aulArena), HEAP_LOCK_NONE );
+    Heap_GetStats( &stHeap, &stStats );
+    tInitialFree = stStats.tFreeBytes;
+    EXPECT_EQUALS( stStats.usFreeBlocks, 1 );
+    EXPECT_EQUALS( stStats.usUsedBlocks, 0 );
+    EXPECT_EQUALS( stStats.tLargestFree, tInitialFree );
+
+    for (i = 0; i < 6; i++)
+    {
+        apvData[i] = Heap_Alloc( &stHeap, aucSizes[i] );
+        EXPECT_FAIL_FALSE( apvData[i] );
+        EXPECT_GTE( Heap_GetBlockSize( apvData[i] ), aucSizes[i] );
+        EXPECT_EQUALS( ((K_ADDR)apvData[i]) & (sizeof(void*) - 1), 0 );
+        FillBlock( apvData[i], aucSizes[i], i + 1 );
+    }
+
+    // No allocation overlaps another
+    for (i = 0; i < 6; i++)
+    {
+        EXPECT_TRUE( CheckBlock( apvData[i], aucSizes[i], i + 1 ) );
+    }
+
+    Heap_GetStats( &stHeap, &stStats );
+    EXPECT_EQUALS( stStats.usUsedBlocks, 6 );
+    EXPECT_EQUALS( stStats.tHighWater, stStats.tUsedBytes );
+
+    for (i = 0; i < 6; i++)
+    {
+        Heap_Free( &stHeap, apvData[i] );
+    }
+    Heap_Free( &stHeap, NULL );
+
+    // Everything merges back into a single block
+    Heap_GetStats( &stHeap, &stStats );
+    EXPECT_EQUALS( stStats.usFreeBlocks, 1 );
+    EXPECT_EQUALS( stStats.usUsedBlocks, 0 );
+    EXPECT_EQUALS( stStats.tUsedBytes, 0 );
+    EXPECT_EQUALS( stStats.tFreeBytes, tInitialFree );
+    EXPECT_EQUALS( stStats.ucFragmentation, 0 );
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(heap_coalesce)
+{
+    void *pvA;
+    void *pvB;
+    void *pvC;
+    void *pvD;
+
+    Heap_Init( &stHeap, (void*)aulArena, sizeof(aulArena), HEAP_LOCK_NONE );
+
+    pvA = Heap_Alloc( &stHeap, 32 );
+    pvB = Heap_Alloc( &stHeap, 32 );
+    pvC = Heap_Alloc( &stHeap, 32 );
+    pvD = Heap_Alloc( &stHeap, 32 );
+
+    // Free the blocks either side of B - they can't merge yet
+    Heap_Free( &stHeap, pvA );
+    Heap_Free( &stHeap, pvC );
+    Heap_GetStats( &stHeap, &stStats );
+    EXPECT_EQUALS( stStats.usFreeBlocks, 3 );
+    EXPECT_GT( stStats.ucFragmentation, 0 );
+
+    // Freeing B merges it with both neighbours
+    Heap_Free( &stHeap, pvB );
+    Heap_GetStats( &stHeap, &stStats );
+    EXPECT_EQUALS( stStats.usFreeBlocks, 2 );
+    EXPECT_EQUALS( stStats.usUsedBlocks, 1 );
+
+    // ... and the merged block can satisfy a larger request
+    pvA = Heap_Alloc( &stHeap, 96 );
+    EXPECT_FAIL_FALSE( pvA );
+
+    Heap_Free( &stHeap, pvA );
+    Heap_Free( &stHeap, pvD );
+    Heap_GetStats( &stHeap, &stStats );
+    EXPECT_EQUALS( stStats.usFreeBlocks, 1 );
+    EXPECT_EQUALS( stStats.ucFragmentation, 0 );
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(heap_exhaust)
+{
+    void *apvData[32];
+    K_UCHAR ucCount = 0;
+    K_UCHAR i;
+
+    Heap_Init( &stHeap, (void*)aulArena, sizeof(aulArena), HEAP_LOCK_NONE );
+
+    EXPECT_FALSE( Heap_Alloc( &stHeap, 0 ) );
+    EXPECT_FALSE( Heap_Alloc( &stHeap, HEAP_ARENA_SIZE ) );
+
+    while (ucCount < 32)
+    {
+        apvData[ucCount] = Heap_Alloc( &stHeap, 12 );
+        if (!apvData[ucCount])
+        {
+            break;
+        }
+        ucCount++;
+    }
+    EXPECT_GT( ucCount, 4 );
+    EXPECT_LT( ucCount, 32 );
+
+    Heap_GetStats( &stHeap, &stStats );
+    EXPECT_EQUALS( stStats.usFailures, 3 );
+    EXPECT_EQUALS( stStats.usUsedBlocks, ucCount );
+
+    for (i = 0; i < ucCount; i++)
+    {
+        Heap_Free( &stHeap, apvData[i] );
+    }
+    Heap_GetStats( &stHeap, &stStats );
+    EXPECT_EQUALS( stStats.usFreeBlocks, 1 );
+    EXPECT_GTE( stStats.tHighWater, (K_ADDR)ucCount * 12 );
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+void heap_timer_alloc(Thread_t *pstOwner_, void *pvData_)
+{
+    // Runs from the kernel timer interrupt
+    void *pvData = Heap_Alloc( &stHeap, 8 );
+    if (!pvData)
+    {
+        usIsrErrors++;
+        return;
+    }
+    FillBlock( pvData, 8, 0x5A );
+    if (!CheckBlock( pvData, 8, 0x5A ))
+    {
+        usIsrErrors++;
+    }
+    Heap_Free( &stHeap, pvData );
+    usIsrAllocs++;
+}
+
+void heap_thread(void *param_)
+{
+    K_UCHAR ucVal = (K_UCHAR)(K_ADDR)param_;
+    void *pvData;
+
+    while (!exit_flag)
+    {
+        pvData = Heap_Alloc( &stHeap, 20 );
+        if (!pvData)
+        {
+            usThreadErrors++;
+            continue;
+        }
+        FillBlock( pvData, 20, ucVal );
+        Thread_Yield();
+        if (!CheckBlock( pvData, 20, ucVal ))
+        {
+            usThreadErrors++;
+        }
+        Heap_Free( &stHeap, pvData );
+    }
+    Thread_Exit( &stHeapThread );
+}
+
+TEST(heap_isr_safe)
+{
+    // Share an ISR-safe heap between a timer interrupt and two threads
+    usIsrAllocs = 0;
+    usIsrErrors = 0;
+    usThreadErrors = 0;
+    exit_flag = false;
+
+    Heap_Init( &stHeap, (void*)aulArena, sizeof(aulArena), HEAP_LOCK_CRITICAL );
+
+    Thread_Init( &stHeapThread, akHeapStack, 160, 1, heap_thread, (void*)0x11 );
+    Thread_Start( &stHeapThread );
+
+    Timer_Init( &stHeapTimer );
+    Timer_Start( &stHeapTimer, true, 1, heap_timer_alloc, 0 );
+
+    {
+        void *pvData;
+        K_USHORT i;
+        for (i = 0; i < 1000; i++)
+        {
+            pvData = Heap_Alloc( &stHeap, 24 );
+            EXPECT_FAIL_FALSE( pvData );
+            FillBlock( pvData, 24, 0x22 );
+            Thread_Yield();
+            EXPECT_FAIL_FALSE( CheckBlock( pvData, 24, 0x22 ) );
+            Heap_Free( &stHeap, pvData );
+        }
+        Thread_Sleep(50);
+    }
+
+    Timer_Stop( &stHeapTimer );
+    exit_flag = true;
+    Thread_Sleep(10);
+
+    EXPECT_GT( usIsrAllocs, 0 );
+    EXPECT_EQUALS( usIsrErrors, 0 );
+    EXPECT_EQUALS( usThreadErrors, 0 );
+
+    Heap_GetStats( &stHeap, &stStats );
+    EXPECT_EQUALS( stStats.usFreeBlocks, 1 );
+    EXPECT_EQUALS( stStats.usUsedBlocks, 0 );
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(heap_thread_safe)
+{
+    // Share a mutex-protected heap between two threads of equal priority
+    usThreadErrors = 0;
+    exit_flag = false;
+
+    Heap_Init( &stHeap, (void*)aulArena, sizeof(aulArena), HEAP_LOCK_MUTEX );
+
+    Thread_Init( &stHeapThread, akHeapStack, 160, 1, heap_thread, (void*)0x33 );
+    Thread_Start( &stHeapThread );
+
+    {
+        void *pvData;
+        K_USHORT i;
+        for (i = 0; i < 1000; i++)
+        {
+            pvData = Heap_Alloc( &stHeap, 40 );
+            EXPECT_FAIL_FALSE( pvData );
+            FillBlock( pvData, 40, 0x44 );
+            Thread_Yield();
+            EXPECT_FAIL_FALSE( CheckBlock( pvData, 40, 0x44 ) );
+            Heap_Free( &stHeap, pvData );
+        }
+    }
+
+    exit_flag = true;
+    Thread_Sleep(10);
+
+    EXPECT_EQUALS( usThreadErrors, 0 );
+
+    Heap_GetStats( &stHeap, &stStats );
+    EXPECT_EQUALS( stStats.usFreeBlocks, 1 );
+    EXPECT_EQUALS( stStats.usUsedBlocks, 0 );
+}
+TEST_END
+
+//===========================================================================
+// Test Whitelist Goes Here
+//===========================================================================
+TEST_CASE_START
+  TEST_CASE(heap_alloc_free),
+  TEST_CASE(heap_coalesce),
+  TEST_CASE(heap_exhaust),
+  TEST_CASE(heap_isr_safe),
+  TEST_CASE(heap_thread_safe),
+TEST_CASE_END
@@ -188,6 +188,133 @@ TEST(mailbox_send_blocking)
 }
 TEST_END
 
+void mbox_peek_test(void *unused_)
+{
+    while(1)
+    {
+        K_UCHAR *pucSlot = (K_UCHAR*)MailBox_PeekTail( &stMBox );
+        MemUtil_CopyMemory( (void*)aucRxBuf, (void*)pucSlot, 16 );
+        MailBox_Release( &stMBox );
+    }
+}
+
+TEST(mailbox_reserve_peek)
+{
+    K_UCHAR *pucSlot;
+    int i, j;
+
+    MailBox_Init( &stMBox, (void*)aucMBoxBuffer, 128, 16);
+
+    // Fill every slot in place, and verify that the mailbox reports full
+    for (i = 0; i < 8; i++)
+    {
+        pucSlot = (K_UCHAR*)MailBox_Reserve( &stMBox );
+        EXPECT_TRUE( pucSlot != NULL );
+        if (pucSlot)
+        {
+            for (j = 0; j < 16; j++)
+            {
+                pucSlot[j] = (K_UCHAR)(i + j);
+            }
+            MailBox_Commit( &stMBox );
+        }
+    }
+    EXPECT_TRUE( MailBox_Reserve( &stMBox ) == NULL );
+    EXPECT_TRUE( MailBox_TimedReserve( &stMBox, 10 ) == NULL );
+
+    // Read the envelopes in place, oldest first
+    for (i = 0; i < 8; i++)
+    {
+        pucSlot = (K_UCHAR*)MailBox_PeekTail( &stMBox );
+        EXPECT_EQUALS( pucSlot[0], i );
+        EXPECT_EQUALS( pucSlot[15], i + 15 );
+        MailBox_Release( &stMBox );
+    }
+    EXPECT_TRUE( MailBox_IsEmpty( &stMBox ) );
+    EXPECT_TRUE( MailBox_TimedPeek( &stMBox, 10 ) == NULL );
+
+    // A copying send made while a slot is reserved (e.g. from an interrupt)
+    // must not disturb the scheduler state saved by the reservation.
+    pucSlot = (K_UCHAR*)MailBox_Reserve( &stMBox );
+    EXPECT_TRUE( pucSlot != NULL );
+    EXPECT_TRUE( MailBox_Send( &stMBox, (void*)aucTxBuf ) );
+    MailBox_Commit( &stMBox );
+    EXPECT_TRUE( Scheduler_IsEnabled() );
+    MailBox_Receive( &stMBox, (void*)aucRxBuf );
+    MailBox_Receive( &stMBox, (void*)aucRxBuf );
+    EXPECT_TRUE( MailBox_IsEmpty( &stMBox ) );
+
+    // Reserve/commit wakes a thread blocked in peek, and mixes with copying
+    // sends.
+    Thread_Init( &stMBoxThread, akMBoxStack, 160, 7, mbox_peek_test, 0);
+    Thread_Start( &stMBoxThread );
+    for (i = 0; i < 10; i++)
+    {
+        pucSlot = (K_UCHAR*)MailBox_Reserve( &stMBox );
+        EXPECT_TRUE( pucSlot != NULL );
+        if (pucSlot)
+        {
+            MemUtil_CopyMemory( (void*)pucSlot, (void*)aucTxBuf, 16 );
+            MailBox_Commit( &stMBox );
+        }
+        EXPECT_TRUE( MemUtil_CompareMemory((void*)aucRxBuf, (void*)aucTxBuf, 16) );
+        for (j = 0; j < 16; j++)
+        {
+            aucTxBuf[j]++;
+        }
+        EXPECT_TRUE( MailBox_Send( &stMBox, (void*)aucTxBuf ) );
+        EXPECT_TRUE( MemUtil_CompareMemory((void*)aucRxBuf, (void*)aucTxBuf, 16) );
+    }
+    Thread_Exit( &stMBoxThread );
+}
+TEST_END
+
+TEST(mailbox_send_recv_n)
+{
+    K_USHORT ausBuffer[8];
+    K_USHORT ausIn[10];
+    K_USHORT ausOut[10];
+    int i;
+
+    for (i = 0; i < 10; i++)
+    {
+        ausIn[i] = 100 + i;
+    }
+    MailBox_Init( &stMBox, (void*)ausBuffer, sizeof(ausBuffer), sizeof(K_USHORT));
+
+    // Batches come out of the tail in the order they were sent
+    EXPECT_EQUALS( MailBox_SendN( &stMBox, (void*)ausIn, 5 ), 5 );
+    EXPECT_EQUALS( MailBox_ReceiveTailN( &stMBox, (void*)ausOut, 3 ), 3 );
+    for (i = 0; i < 3; i++)
+    {
+        EXPECT_EQUALS( ausOut[i], 100 + i );
+    }
+
+    // Only as many envelopes as there are free slots are sent
+    EXPECT_EQUALS( MailBox_SendN( &stMBox, (void*)&ausIn[5], 5 ), 5 );
+    EXPECT_EQUALS( MailBox_SendN( &stMBox, (void*)ausIn, 5 ), 1 );
+    EXPECT_EQUALS( MailBox_SendN( &stMBox, (void*)ausIn, 5 ), 0 );
+    EXPECT_TRUE( MailBox_IsFull( &stMBox ) );
+
+    // Receiving across the end of the buffer, and stopping when empty
+    EXPECT_EQUALS( MailBox_ReceiveTailN( &stMBox, (void*)ausOut, 10 ), 8 );
+    for (i = 0; i < 7; i++)
+    {
+        EXPECT_EQUALS( ausOut[i], 103 + i );
+    }
+    EXPECT_EQUALS( ausOut[7], 100 );
+    EXPECT_TRUE( MailBox_IsEmpty( &stMBox ) );
+    EXPECT_EQUALS( MailBox_TimedReceiveN( &stMBox, (void*)ausOut, 10, 10 ), 0 );
+
+    // Receiving from the head returns the newest envelopes first
+    EXPECT_EQUALS( MailBox_SendN( &stMBox, (void*)ausIn, 4 ), 4 );
+    EXPECT_EQUALS( MailBox_ReceiveN( &stMBox, (void*)ausOut, 2 ), 2 );
+    EXPECT_EQUALS( ausOut[0], 103 );
+    EXPECT_EQUALS( ausOut[1], 102 );
+    EXPECT_EQUALS( MailBox_GetFreeSlots( &stMBox ), 6 );
+}
+TEST_END
+
 //===========================================================================
 // Test Whitelist Goes Here
 //===========================================================================
@@ -196,4 +323,6 @@ TEST_CASE_START
   TEST_CASE(mailbox_blocking_receive),
   TEST_CASE(mailbox_blocking_timed),
   TEST_CASE(mailbox_send_blocking),
+  TEST_CASE(mailbox_reserve_peek),
+  TEST_CASE(mailbox_send_recv_n),
 TEST_CASE_END
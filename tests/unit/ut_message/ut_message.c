@@ -231,6 +231,137 @@ TEST(ut_message_timed_rx)
 }
 TEST_END
 
+//===========================================================================
+static MessagePool_t stPool;
+static Message_t astPoolMsgs[2];
+
+void MsgPoolReturn(void *unused)
+{
+    // Hold both messages for a while, then return one to the bound pool
+    Message_t *pstMsg = MessageQueue_Receive( &stMsgQ );
+    Thread_Sleep(10);
+    MessagePool_Push( MessageQueue_GetPool( &stMsgQ ), pstMsg );
+    Thread_Exit( &stMsgThread );
+}
+
+TEST(ut_message_pool)
+{
+    // Test - verify that an independent pool bound to a queue allocates
+    // only its own messages, tracks its high-water mark and failures, and
+    // that pops can block until a message is returned.
+    Message_t *pstMsg1;
+    Message_t *pstMsg2;
+
+    MessagePool_Init( &stPool, astPoolMsgs, 2 );
+    MessageQueue_Init( &stMsgQ );
+    EXPECT_TRUE( MessageQueue_GetPool( &stMsgQ ) == GlobalMessagePool_GetPool() );
+    MessageQueue_SetPool( &stMsgQ, &stPool );
+
+    pstMsg1 = MessagePool_Pop( MessageQueue_GetPool( &stMsgQ ) );
+    pstMsg2 = MessagePool_Pop( &stPool );
+    EXPECT_FAIL_FALSE( pstMsg1 );
+    EXPECT_FAIL_FALSE( pstMsg2 );
+    EXPECT_FALSE( MessagePool_Pop( &stPool ) );
+    EXPECT_EQUALS( MessagePool_GetFree( &stPool ), 0 );
+    EXPECT_EQUALS( MessagePool_GetHighWater( &stPool ), 2 );
+    EXPECT_EQUALS( MessagePool_GetFailures( &stPool ), 1 );
+
+    // Draining this pool must not affect the global pool
+    pstMsg2 = GlobalMessagePool_Pop();
+    EXPECT_FAIL_FALSE( pstMsg2 );
+    GlobalMessagePool_Push( pstMsg2 );
+
+    // Timed pop on an empty pool times out
+    EXPECT_FALSE( MessagePool_TimedPop( &stPool, 10 ) );
+    EXPECT_EQUALS( MessagePool_GetFailures( &stPool ), 2 );
+
+    // A blocked pop is satisfied when the receiver returns a message
+    Thread_Init( &stMsgThread, aucMsgStack, MSG_STACK_SIZE, 7, MsgPoolReturn, 0);
+    Thread_Start( &stMsgThread );
+    MessageQueue_Send( &stMsgQ, pstMsg1 );
+
+    pstMsg2 = MessagePool_TimedPop( &stPool, 100 );
+    EXPECT_TRUE( pstMsg2 == pstMsg1 );
+    EXPECT_EQUALS( MessagePool_GetHighWater( &stPool ), 2 );
+
+    MessagePool_ResetStats( &stPool );
+    EXPECT_EQUALS( MessagePool_GetFailures( &stPool ), 0 );
+    EXPECT_EQUALS( MessagePool_GetHighWater( &stPool ), 2 );
+
+    MessagePool_Push( &stPool, pstMsg2 );
+    EXPECT_EQUALS( MessagePool_GetFree( &stPool ), 1 );
+
+    // Pushing a message that was never popped doesn't wrap the in-use count
+    MessagePool_Init( &stPool, astPoolMsgs, 1 );
+    MessagePool_Push( &stPool, &astPoolMsgs[1] );
+    MessagePool_ResetStats( &stPool );
+    EXPECT_EQUALS( MessagePool_GetHighWater( &stPool ), 0 );
+}
+TEST_END
+
+//===========================================================================
+TEST(ut_message_priority)
+{
+    // Test - verify that a queue in priority mode delivers the highest
+    // priority messages first, in FIFO order within each priority, and that
+    // a FIFO queue ignores message priorities.
+    static Message_t astPriMsgs[6];
+    static const K_UCHAR aucPri[6] = { 0, 2, 1, 2, 0, 3 };
+    static const K_USHORT ausExpected[6] = { 5, 1, 3, 2, 0, 4 };
+    Message_t *pstMsg;
+    K_UCHAR i;
+
+    MessageQueue_Init( &stMsgQ );
+    MessageQueue_SetPriorityOrder( &stMsgQ, true );
+
+    for (i = 0; i < 6; i++)
+    {
+        Message_Init( &astPriMsgs[i] );
+        Message_SetCode( &astPriMsgs[i], i );
+        Message_SetPriority( &astPriMsgs[i], aucPri[i] );
+        MessageQueue_Send( &stMsgQ, &astPriMsgs[i] );
+    }
+    EXPECT_EQUALS( MessageQueue_GetCount( &stMsgQ ), 6 );
+
+    for (i = 0; i < 6; i++)
+    {
+        pstMsg = MessageQueue_TimedReceive( &stMsgQ, 10 );
+        EXPECT_FAIL_FALSE( pstMsg );
+        EXPECT_EQUALS( Message_GetCode( pstMsg ), ausExpected[i] );
+    }
+
+    // Levels are re-used correctly once drained
+    MessageQueue_Send( &stMsgQ, &astPriMsgs[0] );
+    MessageQueue_Send( &stMsgQ, &astPriMsgs[5] );
+    EXPECT_EQUALS( Message_GetCode( MessageQueue_TimedReceive( &stMsgQ, 10 ) ), 5 );
+    EXPECT_EQUALS( Message_GetCode( MessageQueue_TimedReceive( &stMsgQ, 10 ) ), 0 );
+
+    // Out-of-range priorities are clamped to the highest level, and queue
+    // behind the messages already at that level
+    Message_SetPriority( &astPriMsgs[1], 200 );
+    EXPECT_EQUALS( Message_GetPriority( &astPriMsgs[1] ), MESSAGE_PRIORITY_LEVELS - 1 );
+    MessageQueue_Send( &stMsgQ, &astPriMsgs[5] );
+    MessageQueue_Send( &stMsgQ, &astPriMsgs[1] );
+    MessageQueue_Send( &stMsgQ, &astPriMsgs[2] );
+    EXPECT_EQUALS( Message_GetCode( MessageQueue_TimedReceive( &stMsgQ, 10 ) ), 5 );
+    EXPECT_EQUALS( Message_GetCode( MessageQueue_TimedReceive( &stMsgQ, 10 ) ), 1 );
+    EXPECT_EQUALS( Message_GetCode( MessageQueue_TimedReceive( &stMsgQ, 10 ) ), 2 );
+
+    // FIFO mode
+    MessageQueue_SetPriorityOrder( &stMsgQ, false );
+    for (i = 0; i < 6; i++)
+    {
+        MessageQueue_Send( &stMsgQ, &astPriMsgs[i] );
+    }
+    for (i = 0; i < 6; i++)
+    {
+        pstMsg = MessageQueue_TimedReceive( &stMsgQ, 10 );
+        EXPECT_FAIL_FALSE( pstMsg );
+        EXPECT_EQUALS( Message_GetCode( pstMsg ), i );
+    }
+}
+TEST_END
+
 //===========================================================================
 // Test Whitelist Goes Here
 //===========================================================================
@@ -238,4 +369,6 @@ TEST_CASE_START
   TEST_CASE(ut_message_tx_rx),
   TEST_CASE(ut_message_exhaust),
   TEST_CASE(ut_message_timed_rx),
+  TEST_CASE(ut_message_pool),
+  TEST_CASE(ut_message_priority),
 TEST_CASE_END
@@ -0,0 +1,300 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+
+#include "kerneltypes.h"
+#include "kernel.h"
+#include "../ut_platform.h"
+#include "mark3.h"
+#include "multiwait.h"
+
+//===========================================================================
+// Local Defines
+//===========================================================================
+#if KERNEL_USE_MULTIWAIT
+static Thread_t stWaitThread;
+static K_WORD akWaitStack[160];
+
+static Semaphore_t stSemA;
+static Semaphore_t stSemB;
+static EventFlag_t stFlag;
+static MailBox_t stMBox;
+static K_UCHAR aucMBoxBuffer[16];
+
+static Timer_t stPostTimer;
+
+static MultiWaitEntry_t astEntries[4];
+
+static volatile K_UCHAR aucHits[4];
+static volatile K_UCHAR ucFlagStep;
+static volatile bool exit_flag;
+#endif
+
+//===========================================================================
+// Define Test Cases Here
+//===========================================================================
+TEST(multiwait_ready)
+{
+#if KERNEL_USE_MULTIWAIT
+    Semaphore_Init( &stSemA, 0, 1 );
+    Semaphore_Init( &stSemB, 1, 1 );
+
+    MultiWait_InitSemaphore( &astEntries[0], &stSemA );
+    MultiWait_InitSemaphore( &astEntries[1], &stSemB );
+
+    // An object that is already ready is reported without blocking, and
+    // nothing is consumed by the wait.
+    EXPECT_EQUALS( MultiWait_Wait( astEntries, 2 ), 1 );
+    EXPECT_EQUALS( Semaphore_GetCount( &stSemB ), 1 );
+    EXPECT_EQUALS( MultiWait_Wait( astEntries, 2 ), 1 );
+
+    // Lowest index wins when more than one object is ready
+    Semaphore_Post( &stSemA );
+    EXPECT_EQUALS( MultiWait_Wait( astEntries, 2 ), 0 );
+
+    Semaphore_Pend( &stSemA );
+    Semaphore_Pend( &stSemB );
+#endif
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+#if KERNEL_USE_MULTIWAIT
+void post_sem_callback( Thread_t *pstOwner_, void *pvData_ )
+{
+    Semaphore_Post( (Semaphore_t*)pvData_ );
+}
+#endif
+
+TEST(multiwait_semaphore)
+{
+#if KERNEL_USE_MULTIWAIT
+    Semaphore_Init( &stSemA, 0, 1 );
+    Semaphore_Init( &stSemB, 0, 1 );
+
+    MultiWait_InitSemaphore( &astEntries[0], &stSemA );
+    MultiWait_InitSemaphore( &astEntries[1], &stSemB );
+
+    // Wake from interrupt context, on either object
+    Timer_Init( &stPostTimer );
+    Timer_Start( &stPostTimer, false, 10, post_sem_callback, (void*)&stSemB );
+    EXPECT_EQUALS( MultiWait_Wait( astEntries, 2 ), 1 );
+    EXPECT_EQUALS( Semaphore_GetCount( &stSemA ), 0 );
+    Semaphore_Pend( &stSemB );
+
+    Timer_Start( &stPostTimer, false, 10, post_sem_callback, (void*)&stSemA );
+    EXPECT_EQUALS( MultiWait_Wait( astEntries, 2 ), 0 );
+    Semaphore_Pend( &stSemA );
+#endif
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(multiwait_timeout)
+{
+#if KERNEL_USE_MULTIWAIT
+    Semaphore_Init( &stSemA, 0, 1 );
+    Semaphore_Init( &stSemB, 0, 1 );
+
+    MultiWait_InitSemaphore( &astEntries[0], &stSemA );
+    MultiWait_InitSemaphore( &astEntries[1], &stSemB );
+
+    EXPECT_EQUALS( MultiWait_TimedWait( astEntries, 2, 20 ), MULTIWAIT_TIMEOUT );
+
+    // Entries must be unlinked after a timeout; posting must not touch them
+    EXPECT_EQUALS( stSemA.pstMultiWait, 0 );
+    EXPECT_EQUALS( stSemB.pstMultiWait, 0 );
+
+    Timer_Init( &stPostTimer );
+    Timer_Start( &stPostTimer, false, 5, post_sem_callback, (void*)&stSemB );
+    EXPECT_EQUALS( MultiWait_TimedWait( astEntries, 2, 100 ), 1 );
+    Semaphore_Pend( &stSemB );
+#endif
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+#if KERNEL_USE_MULTIWAIT
+void set_flag_callback( Thread_t *pstOwner_, void *pvData_ )
+{
+    // First set only half of the "all" pattern, then complete it.
+    if (0 == ucFlagStep)
+    {
+        EventFlag_Set( &stFlag, 0x0001 );
+    }
+    else
+    {
+        EventFlag_Set( &stFlag, 0x0002 );
+    }
+    ucFlagStep++;
+}
+#endif
+
+TEST(multiwait_eventflag)
+{
+#if KERNEL_USE_MULTIWAIT
+    Semaphore_Init( &stSemA, 0, 1 );
+    EventFlag_Init( &stFlag );
+
+    MultiWait_InitSemaphore( &astEntries[0], &stSemA );
+    MultiWait_InitEventFlag( &astEntries[1], &stFlag, 0x0003, EVENT_FLAG_ALL );
+    MultiWait_InitEventFlag( &astEntries[2], &stFlag, 0x0030, EVENT_FLAG_ANY );
+
+    ucFlagStep = 0;
+    Timer_Init( &stPostTimer );
+    Timer_Start( &stPostTimer, true, 10, set_flag_callback, 0 );
+    EXPECT_EQUALS( MultiWait_TimedWait( astEntries, 3, 100 ), 1 );
+    Timer_Stop( &stPostTimer );
+
+    EXPECT_EQUALS( ucFlagStep, 2 );
+    EXPECT_EQUALS( EventFlag_GetMask( &stFlag ), 0x0003 );
+
+    // Any bit in the mask is enough
+    EventFlag_Clear( &stFlag, 0x0003 );
+    EventFlag_Set( &stFlag, 0x0020 );
+    EXPECT_EQUALS( MultiWait_TimedWait( astEntries, 3, 100 ), 2 );
+#endif
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+#if KERNEL_USE_MULTIWAIT
+void multiwait_thread( void *unused_ )
+{
+    K_UCHAR ucIdx;
+
+    while (!exit_flag)
+    {
+        ucIdx = MultiWait_TimedWait( astEntries, 3, 50 );
+        if (MULTIWAIT_TIMEOUT == ucIdx)
+        {
+            continue;
+        }
+        aucHits[ucIdx]++;
+
+        // Consume whatever made the entry ready
+        if (0 == ucIdx)
+        {
+            Semaphore_Pend( &stSemA );
+        }
+        else if (1 == ucIdx)
+        {
+            Semaphore_Pend( &stSemB );
+        }
+        else
+        {
+            K_UCHAR ucMail;
+            MailBox_Receive( &stMBox, &ucMail );
+        }
+    }
+    Thread_Exit( &stWaitThread );
+}
+#endif
+
+TEST(multiwait_threads)
+{
+#if KERNEL_USE_MULTIWAIT
+    K_UCHAR i;
+    K_UCHAR ucMail = 0x5A;
+
+    Semaphore_Init( &stSemA, 0, 1 );
+    Semaphore_Init( &stSemB, 0, 1 );
+    MailBox_Init( &stMBox, (void*)aucMBoxBuffer, sizeof(aucMBoxBuffer), 1 );
+
+    MultiWait_InitSemaphore( &astEntries[0], &stSemA );
+    MultiWait_InitSemaphore( &astEntries[1], &stSemB );
+    MultiWait_InitMailBox( &astEntries[2], &stMBox );
+
+    for (i = 0; i < 3; i++)
+    {
+        aucHits[i] = 0;
+    }
+    exit_flag = false;
+
+    // The waiter runs at a higher priority, so each post is handled before
+    // the next one is made.
+    Thread_Init( &stWaitThread, akWaitStack, 160, 7, multiwait_thread, 0 );
+    Thread_Start( &stWaitThread );
+
+    for (i = 0; i < 10; i++)
+    {
+        Semaphore_Post( &stSemA );
+        Semaphore_Post( &stSemB );
+        EXPECT_TRUE( MailBox_Send( &stMBox, &ucMail ) );
+    }
+
+    EXPECT_EQUALS( aucHits[0], 10 );
+    EXPECT_EQUALS( aucHits[1], 10 );
+    EXPECT_EQUALS( aucHits[2], 10 );
+    EXPECT_TRUE( MailBox_IsEmpty( &stMBox ) );
+
+    exit_flag = true;
+    Thread_Sleep(100);
+#endif
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+#if KERNEL_USE_MULTIWAIT
+void multiwait_stop_thread( void *unused_ )
+{
+    // Entries on the waiting thread's own stack, as in typical use
+    MultiWaitEntry_t astLocal[2];
+
+    MultiWait_InitSemaphore( &astLocal[0], &stSemA );
+    MultiWait_InitSemaphore( &astLocal[1], &stSemB );
+    MultiWait_Wait( astLocal, 2 );
+    aucHits[0]++;
+}
+#endif
+
+TEST(multiwait_stop)
+{
+#if KERNEL_USE_MULTIWAIT
+    Semaphore_Init( &stSemA, 0, 1 );
+    Semaphore_Init( &stSemB, 0, 1 );
+    aucHits[0] = 0;
+
+    // The waiter runs at a higher priority, so it is blocked in the
+    // multi-wait by the time Thread_Start() returns.
+    Thread_Init( &stWaitThread, akWaitStack, 160, 7, multiwait_stop_thread, 0 );
+    Thread_Start( &stWaitThread );
+    EXPECT_FALSE( stSemA.pstMultiWait == 0 );
+    EXPECT_FALSE( stSemB.pstMultiWait == 0 );
+
+    // Stopping the thread must unlink its entries from both objects
+    Thread_Stop( &stWaitThread );
+    EXPECT_EQUALS( stSemA.pstMultiWait, 0 );
+    EXPECT_EQUALS( stSemB.pstMultiWait, 0 );
+
+    Semaphore_Post( &stSemA );
+    EXPECT_EQUALS( Semaphore_GetCount( &stSemA ), 1 );
+    EXPECT_EQUALS( aucHits[0], 0 );
+    Semaphore_Pend( &stSemA );
+#endif
+}
+TEST_END
+
+//===========================================================================
+// Test Whitelist Goes Here
+//===========================================================================
+TEST_CASE_START
+  TEST_CASE(multiwait_ready),
+  TEST_CASE(multiwait_semaphore),
+  TEST_CASE(multiwait_timeout),
+  TEST_CASE(multiwait_eventflag),
+  TEST_CASE(multiwait_threads),
+  TEST_CASE(multiwait_stop),
+TEST_CASE_END
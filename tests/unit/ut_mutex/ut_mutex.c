@@ -83,6 +83,39 @@ TEST(ut_typical_mutex)
 }
 TEST_END
 
+//===========================================================================
+TEST(ut_recursive_mutex)
+{
+    // Test - Recursive claims by the owner must be matched by the same number
+    // of releases before a waiting thread is given the mutex.
+    Mutex_t stMutex;
+
+    Mutex_Init( &stMutex );
+
+    Mutex_Claim( &stMutex );
+    Mutex_Claim( &stMutex );
+    Mutex_Claim( &stMutex );
+
+    ucToken = 0x96;
+    Thread_Init( &stMutexThread, aucTestStack, MUTEX_STACK_SIZE, 7, TypicalMutexTest, (void*)&stMutex);
+    Thread_Start( &stMutexThread );
+
+    Mutex_Release( &stMutex );
+    Mutex_Release( &stMutex );
+    EXPECT_EQUALS( ucToken, 0x96 );
+
+    // Final release hands the mutex to the waiting thread
+    Mutex_Release( &stMutex );
+    EXPECT_EQUALS( ucToken, 0x69 );
+
+    // ... which releases it again, leaving the mutex free for us.
+    Mutex_Claim( &stMutex );
+    EXPECT_TRUE( stMutex.pstOwner == Scheduler_GetCurrentThread() );
+    Mutex_Release( &stMutex );
+    EXPECT_TRUE( stMutex.bReady );
+}
+TEST_END
+
 //===========================================================================
 void TimedMutexTest(void *mutex_)
 {
@@ -202,6 +235,7 @@ TEST_END
 //===========================================================================
 TEST_CASE_START
   TEST_CASE(ut_typical_mutex),
+  TEST_CASE(ut_recursive_mutex),
   TEST_CASE(ut_timed_mutex),
   TEST_CASE(ut_priority_mutex),
 TEST_CASE_END
@@ -63,7 +63,12 @@ void MyUnitTest_PrintTestResult( UnitTest_t *pstTest_ )
     {
         PrintString(".");
     }
-    if (UnitTest_GetPassed(pstTest_) == UnitTest_GetTotal(pstTest_))
+    if (UnitTest_GetTotal(pstTest_) == 0)
+    {
+        // Nothing was checked - the feature under test is configured out
+        PrintString("(SKIP)[");
+    }
+    else if (UnitTest_GetPassed(pstTest_) == UnitTest_GetTotal(pstTest_))
     {
         PrintString("(PASS)[");
     }
@@ -0,0 +1,159 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+
+#include "kerneltypes.h"
+#include "kernel.h"
+#include "../ut_platform.h"
+#include "mark3.h"
+#include "kernelprofile.h"
+#include "profile.h"
+
+//===========================================================================
+// Local Defines
+//===========================================================================
+#define NUM_SAMPLES         (3)
+
+static ProfileTimer_t stProfileTimer;
+static K_USHORT ausBuckets[PROFILE_HISTOGRAM_BUCKETS];
+
+// Sleep times chosen to land in different histogram buckets
+static const K_UCHAR aucSleepMs[NUM_SAMPLES] = { 16, 1, 4 };
+static K_ULONG aulSamples[NUM_SAMPLES];
+
+//---------------------------------------------------------------------------
+static void take_samples( void )
+{
+    K_UCHAR i;
+
+    for (i = 0; i < NUM_SAMPLES; i++)
+    {
+        ProfileTimer_Start( &stProfileTimer );
+        Thread_Sleep( aucSleepMs[i] );
+        ProfileTimer_Stop( &stProfileTimer );
+        aulSamples[i] = ProfileTimer_GetCurrent( &stProfileTimer );
+    }
+}
+
+//===========================================================================
+// Define Test Cases Here
+//===========================================================================
+TEST(profile_min_max)
+{
+    Profiler_Start();
+    ProfileTimer_Init( &stProfileTimer );
+
+    // Nothing recorded yet
+    EXPECT_EQUALS( ProfileTimer_GetMin( &stProfileTimer ), 0 );
+    EXPECT_EQUALS( ProfileTimer_GetMax( &stProfileTimer ), 0 );
+
+    take_samples();
+
+    EXPECT_EQUALS( ProfileTimer_GetIterations( &stProfileTimer ), NUM_SAMPLES );
+    EXPECT_EQUALS( ProfileTimer_GetMin( &stProfileTimer ), aulSamples[1] );
+    EXPECT_EQUALS( ProfileTimer_GetMax( &stProfileTimer ), aulSamples[0] );
+    EXPECT_LTE( ProfileTimer_GetMin( &stProfileTimer ), ProfileTimer_GetAverage( &stProfileTimer ) );
+    EXPECT_GTE( ProfileTimer_GetMax( &stProfileTimer ), ProfileTimer_GetAverage( &stProfileTimer ) );
+
+    Profiler_Stop();
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(profile_histogram)
+{
+    K_USHORT usTotal = 0;
+    K_UCHAR i;
+
+    Profiler_Start();
+    ProfileTimer_Init( &stProfileTimer );
+
+    // Attaching clears whatever was in the buckets
+    for (i = 0; i < PROFILE_HISTOGRAM_BUCKETS; i++)
+    {
+        ausBuckets[i] = 0xAA;
+    }
+    ProfileTimer_SetHistogram( &stProfileTimer, ausBuckets );
+
+    // Buckets are the log2 of the tick count, with the ends clamped
+    EXPECT_EQUALS( ProfileTimer_GetBucket( 0 ), 0 );
+    EXPECT_EQUALS( ProfileTimer_GetBucket( 1 ), 0 );
+    EXPECT_EQUALS( ProfileTimer_GetBucket( 3 ), 1 );
+    EXPECT_EQUALS( ProfileTimer_GetBucket( 4 ), 2 );
+    EXPECT_EQUALS( ProfileTimer_GetBucket( 300 ), 8 );
+    EXPECT_EQUALS( ProfileTimer_GetBucket( 0x7FFF ), 14 );
+    EXPECT_EQUALS( ProfileTimer_GetBucket( 0x10000 ), PROFILE_HISTOGRAM_BUCKETS - 1 );
+    EXPECT_EQUALS( ProfileTimer_GetBucket( 0xFFFFFFFF ), PROFILE_HISTOGRAM_BUCKETS - 1 );
+
+    take_samples();
+
+    // Every iteration lands in exactly one bucket
+    for (i = 0; i < NUM_SAMPLES; i++)
+    {
+        EXPECT_GT( ausBuckets[ ProfileTimer_GetBucket( aulSamples[i] ) ], 0 );
+    }
+    for (i = 0; i < PROFILE_HISTOGRAM_BUCKETS; i++)
+    {
+        usTotal += ausBuckets[i];
+    }
+    EXPECT_EQUALS( usTotal, NUM_SAMPLES );
+
+    Profiler_Stop();
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(profile_reset)
+{
+    K_USHORT usTotal = 0;
+    K_UCHAR i;
+
+    Profiler_Start();
+    ProfileTimer_Init( &stProfileTimer );
+    ProfileTimer_SetHistogram( &stProfileTimer, ausBuckets );
+    take_samples();
+
+    // Reset clears the statistics...
+    ProfileTimer_Reset( &stProfileTimer );
+    EXPECT_EQUALS( ProfileTimer_GetIterations( &stProfileTimer ), 0 );
+    EXPECT_EQUALS( ProfileTimer_GetAverage( &stProfileTimer ), 0 );
+    EXPECT_EQUALS( ProfileTimer_GetMin( &stProfileTimer ), 0 );
+    EXPECT_EQUALS( ProfileTimer_GetMax( &stProfileTimer ), 0 );
+    for (i = 0; i < PROFILE_HISTOGRAM_BUCKETS; i++)
+    {
+        usTotal += ausBuckets[i];
+    }
+    EXPECT_EQUALS( usTotal, 0 );
+
+    // ... but leaves the histogram attached
+    take_samples();
+    for (i = 0; i < PROFILE_HISTOGRAM_BUCKETS; i++)
+    {
+        usTotal += ausBuckets[i];
+    }
+    EXPECT_EQUALS( usTotal, NUM_SAMPLES );
+
+    Profiler_Stop();
+}
+TEST_END
+
+//===========================================================================
+// Test Whitelist Goes Here
+//===========================================================================
+TEST_CASE_START
+  TEST_CASE(profile_min_max),
+  TEST_CASE(profile_histogram),
+  TEST_CASE(profile_reset),
+TEST_CASE_END
@@ -0,0 +1,199 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+
+#include "kerneltypes.h"
+#include "kernel.h"
+#include "../ut_platform.h"
+#include "mark3.h"
+#include "ringbuffer.h"
+
+//===========================================================================
+// Local Defines
+//===========================================================================
+
+static Thread_t stRingThread;
+static K_WORD akRingStack[160];
+
+static RingBuffer_t stRing;
+static Semaphore_t stRingSem;
+static K_USHORT ausRingBuffer[8];
+
+static Timer_t stRingTimer;
+
+static volatile K_USHORT usProduced;
+static volatile K_USHORT usConsumed;
+static volatile K_USHORT usErrors;
+static volatile K_USHORT usDropped;
+static volatile bool exit_flag;
+
+//===========================================================================
+// Define Test Cases Here
+//===========================================================================
+TEST(ringbuffer_write_read)
+{
+    K_USHORT ausIn[10];
+    K_USHORT ausOut[10];
+    K_USHORT i;
+
+    for (i = 0; i < 10; i++)
+    {
+        ausIn[i] = i;
+    }
+
+    RingBuffer_Init( &stRing, (void*)ausRingBuffer, sizeof(ausRingBuffer), sizeof(K_USHORT) );
+    EXPECT_EQUALS( RingBuffer_GetCount( &stRing ), 0 );
+    EXPECT_EQUALS( RingBuffer_GetFree( &stRing ), 7 );
+    EXPECT_EQUALS( RingBuffer_Read( &stRing, ausOut, 1 ), 0 );
+
+    // Fill the buffer, including a partial bulk write once it's full
+    EXPECT_EQUALS( RingBuffer_Write( &stRing, ausIn, 5 ), 5 );
+    EXPECT_EQUALS( RingBuffer_GetCount( &stRing ), 5 );
+    EXPECT_EQUALS( RingBuffer_Write( &stRing, &ausIn[5], 5 ), 2 );
+    EXPECT_EQUALS( RingBuffer_GetFree( &stRing ), 0 );
+    EXPECT_EQUALS( RingBuffer_Write( &stRing, &ausIn[7], 1 ), 0 );
+
+    EXPECT_EQUALS( RingBuffer_Read( &stRing, ausOut, 3 ), 3 );
+    for (i = 0; i < 3; i++)
+    {
+        EXPECT_EQUALS( ausOut[i], i );
+    }
+
+    // This write wraps around the end of the buffer
+    EXPECT_EQUALS( RingBuffer_Write( &stRing, &ausIn[7], 3 ), 3 );
+    EXPECT_EQUALS( RingBuffer_GetCount( &stRing ), 7 );
+
+    // ... and so does this read
+    EXPECT_EQUALS( RingBuffer_Read( &stRing, ausOut, 10 ), 7 );
+    for (i = 0; i < 7; i++)
+    {
+        EXPECT_EQUALS( ausOut[i], i + 3 );
+    }
+    EXPECT_EQUALS( RingBuffer_GetCount( &stRing ), 0 );
+    EXPECT_EQUALS( RingBuffer_GetFree( &stRing ), 7 );
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(ringbuffer_timed_wait)
+{
+    K_USHORT usVal = 1337;
+
+    RingBuffer_Init( &stRing, (void*)ausRingBuffer, sizeof(ausRingBuffer), sizeof(K_USHORT) );
+    Semaphore_Init( &stRingSem, 0, 1 );
+    RingBuffer_SetSemaphore( &stRing, &stRingSem );
+
+    EXPECT_FALSE( RingBuffer_TimedWait( &stRing, 10 ) );
+
+    // Only the empty->non-empty transition posts the semaphore
+    EXPECT_EQUALS( RingBuffer_Write( &stRing, &usVal, 1 ), 1 );
+    EXPECT_EQUALS( stRingSem.usValue, 1 );
+    EXPECT_EQUALS( RingBuffer_Write( &stRing, &usVal, 1 ), 1 );
+    EXPECT_EQUALS( stRingSem.usValue, 1 );
+
+    EXPECT_TRUE( RingBuffer_TimedWait( &stRing, 10 ) );
+    EXPECT_EQUALS( RingBuffer_Read( &stRing, &usVal, 1 ), 1 );
+    EXPECT_EQUALS( usVal, 1337 );
+
+    // Data still pending - no need to block
+    EXPECT_TRUE( RingBuffer_TimedWait( &stRing, 10 ) );
+    EXPECT_EQUALS( RingBuffer_Read( &stRing, &usVal, 1 ), 1 );
+
+    // Buffer drained; nothing left to wait for
+    EXPECT_FALSE( RingBuffer_TimedWait( &stRing, 10 ) );
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+void ring_timer_producer(Thread_t *pstOwner_, void *pvData_)
+{
+    K_USHORT ausVal[2];
+
+    // Runs from the kernel timer interrupt
+    ausVal[0] = usProduced;
+    ausVal[1] = usProduced + 1;
+    if (RingBuffer_Write( &stRing, ausVal, 2 ) != 2)
+    {
+        usDropped++;
+        return;
+    }
+    usProduced += 2;
+}
+
+void ring_consumer(void *unused_)
+{
+    K_USHORT ausOut[4];
+    K_USHORT usRead;
+    K_USHORT i;
+
+    while (!exit_flag)
+    {
+        if (!RingBuffer_TimedWait( &stRing, 10 ))
+        {
+            continue;
+        }
+        usRead = RingBuffer_Read( &stRing, ausOut, 4 );
+        for (i = 0; i < usRead; i++)
+        {
+            if (ausOut[i] != usConsumed)
+            {
+                usErrors++;
+            }
+            usConsumed++;
+        }
+    }
+    Thread_Exit( &stRingThread );
+}
+
+TEST(ringbuffer_isr_stream)
+{
+    usProduced = 0;
+    usConsumed = 0;
+    usErrors = 0;
+    usDropped = 0;
+    exit_flag = false;
+
+    RingBuffer_Init( &stRing, (void*)ausRingBuffer, sizeof(ausRingBuffer), sizeof(K_USHORT) );
+    Semaphore_Init( &stRingSem, 0, 1 );
+    RingBuffer_SetSemaphore( &stRing, &stRingSem );
+
+    Thread_Init( &stRingThread, akRingStack, 160, 7, ring_consumer, 0);
+    Thread_Start( &stRingThread );
+
+    Timer_Init( &stRingTimer );
+    Timer_Start( &stRingTimer, true, 2, ring_timer_producer, 0 );
+
+    Thread_Sleep(200);
+    Timer_Stop( &stRingTimer );
+    Thread_Sleep(20);
+
+    exit_flag = true;
+    Thread_Sleep(20);
+
+    EXPECT_GTE( usProduced, 80 );
+    EXPECT_EQUALS( usConsumed, usProduced );
+    EXPECT_EQUALS( usErrors, 0 );
+    EXPECT_EQUALS( usDropped, 0 );
+}
+TEST_END
+
+//===========================================================================
+// Test Whitelist Goes Here
+//===========================================================================
+TEST_CASE_START
+  TEST_CASE(ringbuffer_write_read),
+  TEST_CASE(ringbuffer_timed_wait),
+  TEST_CASE(ringbuffer_isr_stream),
+TEST_CASE_END
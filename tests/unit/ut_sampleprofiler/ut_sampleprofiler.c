@@ -0,0 +1,125 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+
+#include "kerneltypes.h"
+#include "kernel.h"
+#include "../ut_platform.h"
+#include "mark3.h"
+#include "sampleprofiler.h"
+
+//===========================================================================
+// Local Defines
+//===========================================================================
+
+#if KERNEL_USE_SAMPLE_PROFILER
+static ProfileSample_t astSamples[ SAMPLE_PROFILER_BUFFER_SIZE ];
+
+//---------------------------------------------------------------------------
+static void busy_wait( K_ULONG ulUs_ )
+{
+    K_ULONGLONG ullStart = Kernel_GetTime();
+    while ((Kernel_GetTime() - ullStart) < ulUs_) { /* Spin */ }
+}
+#endif
+
+//===========================================================================
+// Define Test Cases Here
+//===========================================================================
+TEST(sampleprofiler_samples)
+{
+#if KERNEL_USE_SAMPLE_PROFILER
+    K_USHORT usCount;
+    K_USHORT i;
+
+    // One sample per 1ms tick, all taken while this thread was spinning
+    SampleProfiler_Start( 1 );
+    busy_wait( 10000 );
+    SampleProfiler_Stop();
+
+    usCount = SampleProfiler_Read( astSamples, SAMPLE_PROFILER_BUFFER_SIZE );
+    EXPECT_GTE( usCount, 9 );
+    EXPECT_LTE( usCount, 11 );
+    for (i = 0; i < usCount; i++)
+    {
+        EXPECT_EQUALS( astSamples[i].ucThreadID, Thread_GetID( Scheduler_GetCurrentThread() ) );
+        EXPECT_TRUE( astSamples[i].kPC != 0 );
+    }
+
+    // Reading drains the buffer, and nothing is sampled once stopped
+    busy_wait( 5000 );
+    EXPECT_EQUALS( SampleProfiler_Read( astSamples, SAMPLE_PROFILER_BUFFER_SIZE ), 0 );
+    EXPECT_EQUALS( SampleProfiler_GetDropped(), 0 );
+#endif
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(sampleprofiler_interval)
+{
+#if KERNEL_USE_SAMPLE_PROFILER
+    K_USHORT usCount;
+
+    // Every 4th tick
+    SampleProfiler_Start( 4 );
+    busy_wait( 20000 );
+    SampleProfiler_Stop();
+
+    usCount = SampleProfiler_Read( astSamples, SAMPLE_PROFILER_BUFFER_SIZE );
+    EXPECT_GTE( usCount, 4 );
+    EXPECT_LTE( usCount, 6 );
+#endif
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(sampleprofiler_overflow)
+{
+#if KERNEL_USE_SAMPLE_PROFILER
+    K_USHORT usCount = 0;
+    K_USHORT usRead;
+
+    // Run for longer than the buffer holds - the excess is dropped
+    SampleProfiler_Start( 1 );
+    busy_wait( (SAMPLE_PROFILER_BUFFER_SIZE + 10) * 1000UL );
+    SampleProfiler_Stop();
+
+    EXPECT_GTE( SampleProfiler_GetDropped(), 9 );
+
+    // Partial reads return the buffered samples, oldest first
+    do
+    {
+        usRead = SampleProfiler_Read( astSamples, 5 );
+        EXPECT_LTE( usRead, 5 );
+        usCount += usRead;
+    } while (usRead);
+    EXPECT_EQUALS( usCount, SAMPLE_PROFILER_BUFFER_SIZE );
+
+    // Restarting clears the dropped count
+    SampleProfiler_Start( 1 );
+    SampleProfiler_Stop();
+    EXPECT_EQUALS( SampleProfiler_GetDropped(), 0 );
+#endif
+}
+TEST_END
+
+//===========================================================================
+// Test Whitelist Goes Here
+//===========================================================================
+TEST_CASE_START
+  TEST_CASE(sampleprofiler_samples),
+  TEST_CASE(sampleprofiler_interval),
+  TEST_CASE(sampleprofiler_overflow),
+TEST_CASE_END
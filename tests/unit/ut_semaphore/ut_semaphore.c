@@ -152,6 +152,57 @@ TEST(ut_semaphore_timed)
 
 TEST_END
 
+//===========================================================================
+#define ORDER_THREADS       (4)
+#define ORDER_STACK_SIZE    (128)
+static Thread_t astOrderThread[ORDER_THREADS];
+static K_WORD aucOrderStack[ORDER_THREADS][ORDER_STACK_SIZE];
+static K_UCHAR aucWakeOrder[ORDER_THREADS];
+static volatile K_UCHAR ucWakeCount;
+
+//===========================================================================
+void WakeOrderFunction(void *para)
+{
+    Semaphore_Pend( &stSem1 );
+    aucWakeOrder[ucWakeCount++] = (K_UCHAR)(K_ADDR)para;
+    Thread_Exit( Scheduler_GetCurrentThread() );
+}
+
+//===========================================================================
+TEST(ut_semaphore_wake_order)
+{
+    // Test - threads blocked on a Semaphore_t are woken highest-priority
+    // first, regardless of the order in which they blocked.  Each thread is
+    // higher priority than the test thread, so it blocks as soon as it is
+    // started.
+    static const K_UCHAR aucPriority[ORDER_THREADS] = { 3, 5, 3, 4 };
+    K_UCHAR i;
+
+    Semaphore_Init( &stSem1, 0, 1 );
+    ucWakeCount = 0;
+    for (i = 0; i < ORDER_THREADS; i++)
+    {
+        Thread_Init( &astOrderThread[i], aucOrderStack[i], ORDER_STACK_SIZE, aucPriority[i],
+                     WakeOrderFunction, (void*)(K_ADDR)i );
+        Thread_Start( &astOrderThread[i] );
+    }
+
+    for (i = 0; i < ORDER_THREADS; i++)
+    {
+        Semaphore_Post( &stSem1 );
+    }
+
+    EXPECT_EQUALS(ucWakeCount, ORDER_THREADS);
+    EXPECT_EQUALS(aucWakeOrder[0], 1);
+    EXPECT_EQUALS(aucWakeOrder[1], 3);
+#if KERNEL_USE_PRIORITY_WAITLISTS
+    // Threads of equal priority are woken in the order they blocked
+    EXPECT_EQUALS(aucWakeOrder[2], 0);
+    EXPECT_EQUALS(aucWakeOrder[3], 2);
+#endif
+}
+TEST_END
+
 //===========================================================================
 // Test Whitelist Goes Here
 //===========================================================================
@@ -159,4 +210,5 @@ TEST_CASE_START
   TEST_CASE(ut_semaphore_count),
   TEST_CASE(ut_semaphore_post_pend),
   TEST_CASE(ut_semaphore_timed),
+  TEST_CASE(ut_semaphore_wake_order),
 TEST_CASE_END
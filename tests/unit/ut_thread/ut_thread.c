@@ -24,6 +24,7 @@ See license.txt for more information
 #include "kerneltimer.h"
 #include "driver.h"
 #include "memutil.h"
+#include "timer.h"
 //===========================================================================
 // Local Defines
 //===========================================================================
@@ -39,6 +40,14 @@ static Thread_t stThread3;
 static Semaphore_t stSem1;
 static Semaphore_t stSem2;
 
+#if KERNEL_USE_THREAD_NOTIFY
+static K_WORD aucNotifyStack[TEST_STACK_SIZE];
+static Thread_t stNotifyThread;
+static Timer_t stNotifyTimer;
+static volatile K_ULONG ulNotifyTotal;
+static volatile K_ULONG ulNotifyWakes;
+#endif
+
 static volatile K_ULONG ulRR1;
 static volatile K_ULONG ulRR2;
 static volatile K_ULONG ulRR3;
@@ -108,6 +117,97 @@ TEST(ut_thread_exit)
 }
 TEST_END
 
+#if KERNEL_USE_THREAD_NOTIFY
+//===========================================================================
+static void Thread_tNotifyEntryPoint(void *unused_)
+{
+    K_ULONG ulValue;
+
+    while(1)
+    {
+        Thread_NotifyWait( 0xFFFFFFFF, &ulValue );
+        ulNotifyTotal += ulValue;
+        ulNotifyWakes++;
+    }
+
+    unused_ = unused_;
+}
+
+//===========================================================================
+static void Thread_tNotifyTimerCallback( Thread_t *pstOwner_, void *pvData_ )
+{
+    // Runs from the kernel timer interrupt
+    Thread_Notify( (Thread_t*)pvData_, 0, NOTIFY_ACTION_INCREMENT );
+}
+
+//===========================================================================
+TEST(ut_thread_notify)
+{
+    K_ULONG ulValue;
+    Thread_t *pstSelf = Scheduler_GetCurrentThread();
+
+    // A notification sent before the wait is consumed without blocking, and
+    // only the requested bits are cleared on the way out.
+    Thread_Notify( pstSelf, 0x05, NOTIFY_ACTION_SET_BITS );
+    Thread_NotifyWait( 0x01, &ulValue );
+    EXPECT_EQUALS( ulValue, 0x05 );
+    EXPECT_EQUALS( Thread_GetNotifyValue( pstSelf ), 0x04 );
+
+    // Several notifications before a wait collapse into one pending wakeup
+    Thread_Notify( pstSelf, 0, NOTIFY_ACTION_OVERWRITE );
+    Thread_Notify( pstSelf, 0, NOTIFY_ACTION_INCREMENT );
+    Thread_Notify( pstSelf, 0, NOTIFY_ACTION_INCREMENT );
+    Thread_Notify( pstSelf, 0, NOTIFY_ACTION_INCREMENT );
+    Thread_NotifyWait( 0xFFFFFFFF, &ulValue );
+    EXPECT_EQUALS( ulValue, 3 );
+    EXPECT_EQUALS( Thread_GetNotifyValue( pstSelf ), 0 );
+
+    Thread_Notify( pstSelf, 0x1234, NOTIFY_ACTION_OVERWRITE );
+    Thread_NotifyWait( 0, NULL );
+    EXPECT_EQUALS( Thread_GetNotifyValue( pstSelf ), 0x1234 );
+    Thread_Notify( pstSelf, 0, NOTIFY_ACTION_NONE );
+    Thread_NotifyWait( 0xFFFFFFFF, &ulValue );
+    EXPECT_EQUALS( ulValue, 0x1234 );
+
+#if KERNEL_USE_TIMEOUTS
+    // Nothing pending - the wait times out
+    EXPECT_FALSE( Thread_NotifyTimedWait( 0xFFFFFFFF, &ulValue, 20 ) );
+    Thread_Notify( pstSelf, 0x10, NOTIFY_ACTION_SET_BITS );
+    EXPECT_TRUE( Thread_NotifyTimedWait( 0xFFFFFFFF, &ulValue, 20 ) );
+    EXPECT_EQUALS( ulValue, 0x10 );
+#endif
+
+    // A higher-priority thread blocked on its notification value runs as
+    // soon as it is notified.
+    ulNotifyTotal = 0;
+    ulNotifyWakes = 0;
+    Thread_Init( &stNotifyThread, aucNotifyStack, TEST_STACK_SIZE, 7, Thread_tNotifyEntryPoint, NULL);
+    Thread_Start( &stNotifyThread );
+
+    Thread_Notify( &stNotifyThread, 0x03, NOTIFY_ACTION_SET_BITS );
+    EXPECT_EQUALS( ulNotifyWakes, 1 );
+    EXPECT_EQUALS( ulNotifyTotal, 3 );
+    Thread_Notify( &stNotifyThread, 0x40, NOTIFY_ACTION_OVERWRITE );
+    EXPECT_EQUALS( ulNotifyWakes, 2 );
+    EXPECT_EQUALS( ulNotifyTotal, 0x43 );
+
+    // ... and from interrupt context
+    ulNotifyTotal = 0;
+    ulNotifyWakes = 0;
+    Timer_Init( &stNotifyTimer );
+    Timer_Start( &stNotifyTimer, true, 5, Thread_tNotifyTimerCallback, (void*)&stNotifyThread );
+    Thread_Sleep(52);
+    Timer_Stop( &stNotifyTimer );
+
+    // Each tick is handled before the next, so no increments are merged
+    EXPECT_GTE( ulNotifyWakes, 9 );
+    EXPECT_EQUALS( ulNotifyTotal, ulNotifyWakes );
+
+    Thread_Exit( &stNotifyThread );
+}
+TEST_END
+#endif
+
 //===========================================================================
 static ProfileTimer_t stProfiler1;
 static void Thread_tSleepEntryPoint(void *unused_)
@@ -369,6 +469,9 @@ TEST_CASE_START
   TEST_CASE(ut_thread_create),
   TEST_CASE(ut_thread_stop),
   TEST_CASE(ut_thread_exit),
+#if KERNEL_USE_THREAD_NOTIFY
+  TEST_CASE(ut_thread_notify),
+#endif
   TEST_CASE(ut_thread_sleep),
   TEST_CASE(ut_roundrobin),
   TEST_CASE(ut_quanta),
@@ -0,0 +1,162 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+
+#include "kerneltypes.h"
+#include "kernel.h"
+#include "../ut_platform.h"
+#include "mark3.h"
+#include "threadstats.h"
+
+//===========================================================================
+// Local Defines
+//===========================================================================
+
+#if KERNEL_USE_THREAD_STATS
+static Thread_t stWorkThread;
+static K_WORD akWorkStack[160];
+
+static Semaphore_t stSemA;
+static Semaphore_t stSemB;
+
+static ThreadStats_t stStats;
+
+static volatile K_ULONG ulWorkUs;
+
+//---------------------------------------------------------------------------
+static void busy_wait( K_ULONG ulUs_ )
+{
+    K_ULONGLONG ullStart = Kernel_GetTime();
+    while ((Kernel_GetTime() - ullStart) < ulUs_) { /* Spin */ }
+}
+
+//---------------------------------------------------------------------------
+static void work_thread( void *unused_ )
+{
+    while (1)
+    {
+        // Do the requested amount of work each time we're kicked, then
+        // report back.
+        Semaphore_Pend( &stSemA );
+        busy_wait( ulWorkUs );
+        Semaphore_Post( &stSemB );
+    }
+}
+
+//---------------------------------------------------------------------------
+static void start_worker( void )
+{
+    Semaphore_Init( &stSemA, 0, 1 );
+    Semaphore_Init( &stSemB, 0, 1 );
+
+    // Higher priority than the test thread, so it runs as soon as it's kicked
+    Thread_Init( &stWorkThread, akWorkStack, sizeof(akWorkStack), 6, work_thread, 0 );
+    Thread_Start( &stWorkThread );
+}
+#endif
+
+//===========================================================================
+// Define Test Cases Here
+//===========================================================================
+TEST(threadstats_runtime)
+{
+#if KERNEL_USE_THREAD_STATS
+    start_worker();
+    ThreadStats_Reset( &stWorkThread );
+
+    ulWorkUs = 20000;
+    Semaphore_Post( &stSemA );
+    Semaphore_Pend( &stSemB );
+
+    // The worker's time is charged to it, and it was switched in once
+    ThreadStats_Get( &stWorkThread, &stStats );
+    EXPECT_GTE( (K_ULONG)stStats.ullRunTime, 20000 );
+    EXPECT_LTE( (K_ULONG)stStats.ullRunTime, 22000 );
+    EXPECT_EQUALS( stStats.ulSwitches, 1 );
+
+    // ... while the running thread sees its own time so far
+    ThreadStats_Reset( Scheduler_GetCurrentThread() );
+    busy_wait( 10000 );
+    ThreadStats_Get( Scheduler_GetCurrentThread(), &stStats );
+    EXPECT_GTE( (K_ULONG)stStats.ullRunTime, 10000 );
+    EXPECT_LTE( (K_ULONG)stStats.ullRunTime, 12000 );
+
+    // Reset clears the counters
+    ThreadStats_Reset( &stWorkThread );
+    ThreadStats_Get( &stWorkThread, &stStats );
+    EXPECT_EQUALS( (K_ULONG)stStats.ullRunTime, 0 );
+    EXPECT_EQUALS( stStats.ulSwitches, 0 );
+
+    Thread_Stop( &stWorkThread );
+#endif
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(threadstats_switches)
+{
+#if KERNEL_USE_THREAD_STATS
+    K_UCHAR i;
+
+    start_worker();
+    ThreadStats_Reset( &stWorkThread );
+
+    ulWorkUs = 0;
+    for (i = 0; i < 10; i++)
+    {
+        Semaphore_Post( &stSemA );
+        Semaphore_Pend( &stSemB );
+    }
+
+    ThreadStats_Get( &stWorkThread, &stStats );
+    EXPECT_EQUALS( stStats.ulSwitches, 10 );
+
+    Thread_Stop( &stWorkThread );
+#endif
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(threadstats_cpu_load)
+{
+#if KERNEL_USE_THREAD_STATS && KERNEL_USE_IDLE_FUNC
+    // Nothing to do but sleep - almost all of the time is idle
+    ThreadStats_StartWindow();
+    Thread_Sleep(100);
+    EXPECT_LTE( ThreadStats_GetCPULoad(), 5 );
+
+    // Busy for half of the window
+    ThreadStats_StartWindow();
+    busy_wait( 50000 );
+    Thread_Sleep(50);
+    EXPECT_GTE( ThreadStats_GetCPULoad(), 45 );
+    EXPECT_LTE( ThreadStats_GetCPULoad(), 55 );
+
+    // Fully busy
+    ThreadStats_StartWindow();
+    busy_wait( 50000 );
+    EXPECT_GTE( ThreadStats_GetCPULoad(), 99 );
+#endif
+}
+TEST_END
+
+//===========================================================================
+// Test Whitelist Goes Here
+//===========================================================================
+TEST_CASE_START
+  TEST_CASE(threadstats_runtime),
+  TEST_CASE(threadstats_switches),
+  TEST_CASE(threadstats_cpu_load),
+TEST_CASE_END
@@ -0,0 +1,247 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+
+#include "kerneltypes.h"
+#include "kernel.h"
+#include "../ut_platform.h"
+#include "mark3.h"
+#include "timerscheduler.h"
+
+//===========================================================================
+// Local Defines
+//===========================================================================
+
+#define LOOP_ITERATIONS     (20)    //!< Iterations of each periodic loop
+#define LOOP_PERIOD_MS      (5)     //!< Period of each periodic loop
+#define LOOP_WORK_MS        (2)     //!< Time spent "working" each iteration
+
+#if KERNEL_TIMERS_TICKLESS
+#define MS_TICKS(x)         MSECONDS_TO_TICKS(x)
+#define JITTER_TICKS        MSECONDS_TO_TICKS(1)
+#else
+#define MS_TICKS(x)         ((K_ULONG)(x))
+#define JITTER_TICKS        (1)
+#endif
+
+//---------------------------------------------------------------------------
+/*!
+    Spin for the given number of ticks, standing in for the work done by
+    each iteration of a control loop.
+*/
+static void busy_wait( K_ULONG ulTicks_ )
+{
+    K_ULONG ulStart = TimerScheduler_GetTicks();
+    while ((TimerScheduler_GetTicks() - ulStart) < ulTicks_) { /* Spin */ }
+}
+
+//---------------------------------------------------------------------------
+/*!
+    Return how far a release landed from its ideal time, in ticks.
+*/
+static K_ULONG release_error( K_ULONG ulActual_, K_ULONG ulIdeal_ )
+{
+    K_LONG lError = (K_LONG)(ulActual_ - ulIdeal_);
+    if (lError < 0)
+    {
+        return (K_ULONG)(-lError);
+    }
+    return (K_ULONG)lError;
+}
+
+//---------------------------------------------------------------------------
+static Timer_t stTimeTimer;
+static volatile K_ULONGLONG ullLastIsrTime;
+static volatile K_USHORT usIsrBackwards;
+static volatile K_USHORT usIsrCalls;
+
+static void time_callback( Thread_t *pstOwner_, void *pvData_ )
+{
+    K_ULONGLONG ullNow = Kernel_GetTime();
+    if (ullNow < ullLastIsrTime)
+    {
+        usIsrBackwards++;
+    }
+    ullLastIsrTime = ullNow;
+    usIsrCalls++;
+}
+
+//===========================================================================
+// Define Test Cases Here
+//===========================================================================
+TEST(ut_tick_count)
+{
+    K_ULONG ulStart;
+    K_ULONG ulPrev;
+    K_ULONG ulNow;
+    K_USHORT i;
+
+    // The count never goes backwards
+    ulPrev = TimerScheduler_GetTicks();
+    for (i = 0; i < 1000; i++)
+    {
+        ulNow = TimerScheduler_GetTicks();
+        EXPECT_TRUE( (K_LONG)(ulNow - ulPrev) >= 0 );
+        ulPrev = ulNow;
+    }
+
+    // ... and it advances at the timer rate
+    ulStart = TimerScheduler_GetTicks();
+    Thread_Sleep(50);
+    ulNow = TimerScheduler_GetTicks();
+
+    EXPECT_GTE( ulNow - ulStart, MS_TICKS(50) );
+    EXPECT_LTE( ulNow - ulStart, MS_TICKS(50) + (2 * JITTER_TICKS) );
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(ut_kernel_time)
+{
+    K_ULONGLONG ullStart;
+    K_ULONGLONG ullPrev;
+    K_ULONGLONG ullNow;
+    K_ULONG ulElapsed;
+    K_USHORT usBackwards = 0;
+    K_USHORT i;
+
+    // Never goes backwards, across many timer interrupts
+    ullPrev = Kernel_GetTime();
+    for (i = 0; i < 10000; i++)
+    {
+        ullNow = Kernel_GetTime();
+        if (ullNow < ullPrev)
+        {
+            usBackwards++;
+        }
+        ullPrev = ullNow;
+    }
+    EXPECT_EQUALS( usBackwards, 0 );
+
+    // ... including when read from the timer interrupt
+    ullLastIsrTime = 0;
+    usIsrBackwards = 0;
+    usIsrCalls = 0;
+    Timer_Init( &stTimeTimer );
+    Timer_Start( &stTimeTimer, true, 1, time_callback, 0 );
+    for (i = 0; i < 10000; i++)
+    {
+        ullNow = Kernel_GetTime();
+        if (ullNow < ullPrev)
+        {
+            usBackwards++;
+        }
+        ullPrev = ullNow;
+    }
+    Timer_Stop( &stTimeTimer );
+    EXPECT_EQUALS( usBackwards, 0 );
+    EXPECT_EQUALS( usIsrBackwards, 0 );
+    EXPECT_GT( usIsrCalls, 0 );
+
+    // Advances in microseconds
+    ullStart = Kernel_GetTime();
+    Thread_Sleep(100);
+    ulElapsed = (K_ULONG)(Kernel_GetTime() - ullStart);
+
+    EXPECT_GTE( ulElapsed, 100000 );
+    EXPECT_LTE( ulElapsed, 103000 );
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(ut_sleep_until)
+{
+    K_ULONG ulLastWake;
+    K_ULONG ulStart;
+    K_UCHAR i;
+
+    // Each release lands on the deadline, which advances by one period.
+    ulStart = TimerScheduler_GetTicks();
+    ulLastWake = ulStart;
+    for (i = 1; i <= 5; i++)
+    {
+        EXPECT_TRUE( Thread_SleepUntil( &ulLastWake, MS_TICKS(LOOP_PERIOD_MS) ) );
+        EXPECT_EQUALS( ulLastWake, ulStart + (i * MS_TICKS(LOOP_PERIOD_MS)) );
+        EXPECT_LTE( release_error( TimerScheduler_GetTicks(), ulLastWake ), JITTER_TICKS );
+    }
+
+    // Overrun by more than two periods - the missed deadlines return
+    // immediately, then the loop is back on its original schedule.
+    busy_wait( MS_TICKS((2 * LOOP_PERIOD_MS) + 1) );
+    EXPECT_FALSE( Thread_SleepUntil( &ulLastWake, MS_TICKS(LOOP_PERIOD_MS) ) );
+    EXPECT_FALSE( Thread_SleepUntil( &ulLastWake, MS_TICKS(LOOP_PERIOD_MS) ) );
+    EXPECT_TRUE( Thread_SleepUntil( &ulLastWake, MS_TICKS(LOOP_PERIOD_MS) ) );
+    EXPECT_EQUALS( ulLastWake, ulStart + (8 * MS_TICKS(LOOP_PERIOD_MS)) );
+    EXPECT_LTE( release_error( TimerScheduler_GetTicks(), ulLastWake ), JITTER_TICKS );
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(ut_sleep_jitter)
+{
+    K_ULONG ulStart;
+    K_ULONG ulLastWake;
+    K_ULONG ulError;
+    K_ULONG ulSleepDrift;
+    K_ULONG ulUntilMaxError;
+    K_UCHAR i;
+
+    // Relative sleep: "work, then sleep for a period".  Each iteration is
+    // pushed back by the work done in it, so the loop drifts.
+    ulStart = TimerScheduler_GetTicks();
+    for (i = 0; i < LOOP_ITERATIONS; i++)
+    {
+        busy_wait( MS_TICKS(LOOP_WORK_MS) );
+        Thread_Sleep( LOOP_PERIOD_MS );
+    }
+    ulSleepDrift = (TimerScheduler_GetTicks() - ulStart) -
+                   (LOOP_ITERATIONS * MS_TICKS(LOOP_PERIOD_MS));
+
+    // Absolute sleep: releases stay on multiples of the period.
+    ulUntilMaxError = 0;
+    ulStart = TimerScheduler_GetTicks();
+    ulLastWake = ulStart;
+    for (i = 0; i < LOOP_ITERATIONS; i++)
+    {
+        busy_wait( MS_TICKS(LOOP_WORK_MS) );
+        Thread_SleepUntil( &ulLastWake, MS_TICKS(LOOP_PERIOD_MS) );
+
+        ulError = release_error( TimerScheduler_GetTicks(),
+                                 ulStart + ((i + 1) * MS_TICKS(LOOP_PERIOD_MS)) );
+        if (ulError > ulUntilMaxError)
+        {
+            ulUntilMaxError = ulError;
+        }
+    }
+
+    // The relative loop has lost at least the work time on every iteration,
+    // while the absolute loop's error is bounded and doesn't accumulate.
+    EXPECT_GTE( ulSleepDrift, LOOP_ITERATIONS * MS_TICKS(LOOP_WORK_MS) );
+    EXPECT_LTE( ulUntilMaxError, JITTER_TICKS );
+    EXPECT_LTE( release_error( TimerScheduler_GetTicks(),
+                               ulStart + (LOOP_ITERATIONS * MS_TICKS(LOOP_PERIOD_MS)) ),
+                JITTER_TICKS );
+}
+TEST_END
+
+//===========================================================================
+// Test Whitelist Goes Here
+//===========================================================================
+TEST_CASE_START
+  TEST_CASE(ut_tick_count),
+  TEST_CASE(ut_kernel_time),
+  TEST_CASE(ut_sleep_until),
+  TEST_CASE(ut_sleep_jitter),
+TEST_CASE_END
@@ -27,6 +27,11 @@ See license.txt for more information
 #include "driver.h"
 #include "memutil.h"
 
+#if defined(AVR)
+#include <avr/io.h>
+#include <avr/sleep.h>
+#endif
+
 //===========================================================================
 // Local Defines
 //===========================================================================
@@ -47,6 +52,87 @@ static void TimerCallback( Thread_t *pstOwner_, void *pvVal_ )
     ulCallbackCount++;
 }
 
+static Timer_t stTimer4;
+static K_UCHAR aucExpiryOrder[4];
+static volatile K_UCHAR ucExpiryCount;
+static volatile K_ULONG aulRepeatCount[2];
+
+static void OrderCallback( Thread_t *pstOwner_, void *pvVal_ )
+{
+    if (ucExpiryCount < 4)
+    {
+        aucExpiryOrder[ucExpiryCount] = (K_UCHAR)(K_ADDR)pvVal_;
+    }
+    ucExpiryCount++;
+    Semaphore_Post( &stTimerSem );
+}
+
+static void RepeatCallback( Thread_t *pstOwner_, void *pvVal_ )
+{
+    aulRepeatCount[(K_ADDR)pvVal_]++;
+}
+
+#if KERNEL_TIMERS_DELTA_LIST
+static K_ULONG ulSpinLoops;
+static K_ULONGLONG ullRestartStart;
+static volatile K_ULONG ulRestartFireUs;
+static volatile K_UCHAR aucRestartCount[3];
+
+static void SpinCallback( Thread_t *pstOwner_, void *pvVal_ )
+{
+    K_ULONG i;
+
+    // Hold off the timer interrupt, so that the timers behind this one are
+    // overdue by the time they're serviced.
+    for (i = 0; i < ulSpinLoops; i++)
+    {
+        Kernel_GetTime();
+    }
+}
+
+static void RestartCallback( Thread_t *pstOwner_, void *pvVal_ )
+{
+    aucRestartCount[(K_ADDR)pvVal_]++;
+
+    // Restart the other timer, which expired alongside this one and has not
+    // had its callback run yet.
+    if (!(K_ADDR)pvVal_)
+    {
+        Timer_Start( &stTimer2, false, 20, RestartCallback, (void*)1 );
+    }
+}
+
+static void FireTimeCallback( Thread_t *pstOwner_, void *pvVal_ )
+{
+    ulRestartFireUs = (K_ULONG)(Kernel_GetTime() - ullRestartStart);
+    Semaphore_Post( &stTimerSem );
+}
+#endif
+
+#if KERNEL_USE_IDLE_FUNC && KERNEL_TIMERS_TICKLESS
+static volatile K_ULONG ulIdleWakeups;
+
+static void WakeupCountIdle( void )
+{
+    // Sleep until the next interrupt.  The idle function is re-run each time
+    // the CPU wakes without any thread becoming ready, so each return from
+    // sleep accounts for one wakeup.
+#if defined(AVR)
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    cli();
+    sleep_enable();
+    sei();
+    sleep_cpu();
+    sleep_disable();
+    sei();
+#else
+    __WFI();
+#endif
+
+    ulIdleWakeups++;
+}
+#endif
+
 //===========================================================================
 // Define Test Cases Here
 //===========================================================================
@@ -283,6 +369,144 @@ TEST(ut_timer_multi)
 }
 TEST_END
 
+TEST(ut_timer_ordering)
+{
+    Semaphore_Init( &stTimerSem, 0, 4);
+
+    // Timers must expire in order of their expiry time, regardless of the
+    // order in which they were started, or whether the timer list is
+    // tick-based or tickless.
+    ucExpiryCount = 0;
+    Timer_Start( &stTimer1, false, 30, OrderCallback, (void*)3 );
+    Timer_Start( &stTimer2, false, 10, OrderCallback, (void*)1 );
+    Timer_Start( &stTimer3, false, 20, OrderCallback, (void*)2 );
+    Timer_Start( &stTimer4, false, 15, OrderCallback, (void*)4 );
+
+    // Test point - a timer stopped from the middle of the list never fires,
+    // and does not disturb the expiry of the timers behind it.
+    Timer_Stop( &stTimer4 );
+
+    Semaphore_Pend( &stTimerSem );
+    Semaphore_Pend( &stTimerSem );
+    Semaphore_Pend( &stTimerSem );
+    Thread_Sleep(20);
+
+    EXPECT_EQUALS(ucExpiryCount, 3);
+    EXPECT_EQUALS(aucExpiryOrder[0], 1);
+    EXPECT_EQUALS(aucExpiryOrder[1], 2);
+    EXPECT_EQUALS(aucExpiryOrder[2], 3);
+
+    // Test point - stopping timers that have already expired is harmless
+    Timer_Stop( &stTimer1 );
+    Timer_Stop( &stTimer2 );
+    Timer_Stop( &stTimer3 );
+
+    // Test point - periodic timers sharing the list with a one-shot timer
+    // keep their own period.  Expect 10 and 4 expiries in 100ms, allowing
+    // for one expiry of slop either way.
+    aulRepeatCount[0] = 0;
+    aulRepeatCount[1] = 0;
+    ucExpiryCount = 0;
+    Timer_Start( &stTimer1, true, 25, RepeatCallback, (void*)1 );
+    Timer_Start( &stTimer2, true, 10, RepeatCallback, (void*)0 );
+    Timer_Start( &stTimer3, false, 100, OrderCallback, (void*)1 );
+
+    Semaphore_Pend( &stTimerSem );
+    Timer_Stop( &stTimer1 );
+    Timer_Stop( &stTimer2 );
+
+    EXPECT_GTE(aulRepeatCount[0], 9);
+    EXPECT_LTE(aulRepeatCount[0], 11);
+    EXPECT_GTE(aulRepeatCount[1], 3);
+    EXPECT_LTE(aulRepeatCount[1], 5);
+}
+TEST_END
+
+TEST(ut_timer_restart_expired)
+{
+#if KERNEL_TIMERS_DELTA_LIST
+    K_ULONGLONG ullStart;
+    K_ULONG ulLoops = 0;
+
+    Semaphore_Init( &stTimerSem, 0, 1);
+
+    // Work out how many iterations of SpinCallback's loop take 10ms.  Keep a
+    // timer running so that the time base advances in tickless builds.
+    Timer_Start( &stTimer4, true, 100, RepeatCallback, (void*)0 );
+    ullStart = Kernel_GetTime();
+    while ((Kernel_GetTime() - ullStart) < 10000)
+    {
+        ulLoops++;
+    }
+    Timer_Stop( &stTimer4 );
+    ulSpinLoops = ulLoops;
+
+    // Timers 1 and 2 expire together while timer 3's callback is spinning,
+    // and are serviced ~5ms overdue; timer 1's callback then restarts timer 2
+    // before its callback has run.
+    aucRestartCount[0] = 0;
+    aucRestartCount[1] = 0;
+    aucRestartCount[2] = 0;
+    ullRestartStart = Kernel_GetTime();
+    Timer_Start( &stTimer3, false, 5, SpinCallback, 0 );
+    Timer_Start( &stTimer1, false, 10, RestartCallback, (void*)0 );
+    Timer_Start( &stTimer2, false, 10, RestartCallback, (void*)2 );
+    Timer_Start( &stTimer4, false, 30, FireTimeCallback, 0 );
+
+    Semaphore_Pend( &stTimerSem );
+
+    // Test point - the timer behind the restarted one still fires on time,
+    // and isn't pushed out by the restarted timer's overdue time.
+    EXPECT_GTE(ulRestartFireUs, 29000);
+    EXPECT_LTE(ulRestartFireUs, 32000);
+
+    // Test point - the restarted timer runs only its new callback, once the
+    // new interval is up.
+    Thread_Sleep(10);
+    EXPECT_EQUALS(aucRestartCount[0], 1);
+    EXPECT_EQUALS(aucRestartCount[1], 1);
+    EXPECT_EQUALS(aucRestartCount[2], 0);
+
+    Timer_Stop( &stTimer2 );
+#endif
+}
+TEST_END
+
+TEST(ut_timer_idle_wakeups)
+{
+#if KERNEL_USE_IDLE_FUNC && KERNEL_TIMERS_TICKLESS
+    K_ULONG ulWakeups;
+    K_CHAR acData[13];
+    idle_func_t pfPrevIdle = Kernel_GetIdleFunc();
+
+    // Mostly-idle workload - a 100ms periodic timer, and a thread sleeping
+    // for one second.  Count how many times the CPU comes out of idle.
+    Kernel_SetIdleFunc( WakeupCountIdle );
+
+    aulRepeatCount[0] = 0;
+    ulIdleWakeups = 0;
+    Timer_Start( &stTimer1, true, 100, RepeatCallback, (void*)0 );
+    Thread_Sleep(1000);
+    Timer_Stop( &stTimer1 );
+    ulWakeups = ulIdleWakeups;
+    Kernel_SetIdleFunc( pfPrevIdle );
+
+    EXPECT_GTE(aulRepeatCount[0], 9);
+
+    // Test point - we wake for the timer expiries (and little else), rather
+    // than once per millisecond.  Allow some slack for other interrupts.
+    // The CPU did go idle, so the port runs the idle function at all.
+    EXPECT_GT(ulWakeups, 0);
+    EXPECT_LT(ulWakeups, 50);
+
+    // Report the number of wakeups avoided over the one-second window
+    PrintString("\nIdle wakeups avoided: ");
+    MemUtil_DecimalToString32( (ulWakeups < 1000) ? (1000 - ulWakeups) : 0, acData );
+    PrintString( acData );
+    PrintString("/1000\n");
+#endif
+}
+TEST_END
 
 //===========================================================================
 // Test Whitelist Goes Here
@@ -292,4 +516,7 @@ TEST_CASE_START
   TEST_CASE(ut_timer_longrun),
   TEST_CASE(ut_timer_repeat),
   TEST_CASE(ut_timer_multi),
+  TEST_CASE(ut_timer_ordering),
+  TEST_CASE(ut_timer_restart_expired),
+  TEST_CASE(ut_timer_idle_wakeups),
 TEST_CASE_END
@@ -0,0 +1,136 @@
+/*===========================================================================
+     _____        _____        _____        _____
+ ___|    _|__  __|_    |__  __|__   |__  __| __  |__  ______
+|    \  /  | ||    \      ||     |     ||  |/ /     ||___   |
+|     \/   | ||     \     ||     \     ||     \     ||___   |
+|__/\__/|__|_||__|\__\  __||__|\__\  __||__|\__\  __||______|
+    |_____|      |_____|      |_____|      |_____|
+
+--[Mark3 Realtime Platform]--------------------------------------------------
+
+Copyright (c) 2012-2015 Funkenstein Software Consulting, all rights reserved.
+See license.txt for more information
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+
+#include "kerneltypes.h"
+#include "kernel.h"
+#include "../ut_platform.h"
+#include "mark3.h"
+#include "tlog.h"
+
+//===========================================================================
+// Local Defines
+//===========================================================================
+
+#define LOG_NO_ARGS         0x3000  /* SUBSTITUTE="No arguments" */
+#define LOG_SMALL           0x3001  /* SUBSTITUTE="Small %u" */
+#define LOG_MIXED           0x3002  /* SUBSTITUTE="Mixed %u %u %lu" */
+#define LOG_NEGATIVE        0x3003  /* SUBSTITUTE="Negative %d" */
+
+static K_UCHAR aucCapture[ 2 * TLOG_MAX_RECORD ];
+static K_UCHAR ucCaptureLen;
+static K_UCHAR ucCaptureCalls;
+
+//---------------------------------------------------------------------------
+static void capture_output( const K_UCHAR *pucData_, K_UCHAR ucLen_ )
+{
+    K_UCHAR i;
+    for (i = 0; (i < ucLen_) && (ucCaptureLen < sizeof(aucCapture)); i++)
+    {
+        aucCapture[ucCaptureLen++] = pucData_[i];
+    }
+    ucCaptureCalls++;
+}
+
+//---------------------------------------------------------------------------
+static void capture_reset( void )
+{
+    ucCaptureLen = 0;
+    ucCaptureCalls = 0;
+}
+
+//===========================================================================
+// Define Test Cases Here
+//===========================================================================
+TEST(tlog_no_args)
+{
+    TLog_SetOutput( capture_output );
+    capture_reset();
+
+    TLog_Write0( LOG_NO_ARGS );
+
+    // Sync, format ID, and a descriptor with no arguments - in one call
+    EXPECT_EQUALS( ucCaptureCalls, 1 );
+    EXPECT_EQUALS( ucCaptureLen, 4 );
+    EXPECT_EQUALS( aucCapture[0], TLOG_SYNC );
+    EXPECT_EQUALS( aucCapture[1], 0x00 );
+    EXPECT_EQUALS( aucCapture[2], 0x30 );
+    EXPECT_EQUALS( aucCapture[3], 0x00 );
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(tlog_arg_sizes)
+{
+    TLog_SetOutput( capture_output );
+
+    // A small value goes out as a single byte
+    capture_reset();
+    TLog_Write1( LOG_SMALL, 42 );
+    EXPECT_EQUALS( ucCaptureLen, 5 );
+    EXPECT_EQUALS( aucCapture[1], 0x01 );
+    EXPECT_EQUALS( aucCapture[3], 0x01 );
+    EXPECT_EQUALS( aucCapture[4], 42 );
+
+    // 1, 2 and 4 byte arguments in the same record
+    capture_reset();
+    TLog_Write3( LOG_MIXED, 0x12, 0x3456, 0x789ABCDEUL );
+    EXPECT_EQUALS( ucCaptureCalls, 1 );
+    EXPECT_EQUALS( ucCaptureLen, 4 + 1 + 2 + 4 );
+    EXPECT_EQUALS( aucCapture[3], (3 | (0 << 2) | (1 << 4) | (2 << 6)) );
+    EXPECT_EQUALS( aucCapture[4], 0x12 );
+    EXPECT_EQUALS( aucCapture[5], 0x56 );
+    EXPECT_EQUALS( aucCapture[6], 0x34 );
+    EXPECT_EQUALS( aucCapture[7], 0xDE );
+    EXPECT_EQUALS( aucCapture[8], 0xBC );
+    EXPECT_EQUALS( aucCapture[9], 0x9A );
+    EXPECT_EQUALS( aucCapture[10], 0x78 );
+
+    // Negative values are sign-extended, so they go out in full
+    capture_reset();
+    TLog_Write1( LOG_NEGATIVE, (K_ULONG)(K_LONG)-2 );
+    EXPECT_EQUALS( ucCaptureLen, 8 );
+    EXPECT_EQUALS( aucCapture[3], (1 | (2 << 2)) );
+    EXPECT_EQUALS( aucCapture[4], 0xFE );
+    EXPECT_EQUALS( aucCapture[7], 0xFF );
+}
+TEST_END
+
+//---------------------------------------------------------------------------
+TEST(tlog_disabled)
+{
+    // Nothing is built or written without an output
+    TLog_SetOutput( 0 );
+    capture_reset();
+    TLog_Write2( LOG_MIXED, 1, 2 );
+    EXPECT_EQUALS( ucCaptureCalls, 0 );
+
+    TLog_SetOutput( capture_output );
+    TLog_Write2( LOG_MIXED, 1, 2 );
+    EXPECT_EQUALS( ucCaptureCalls, 1 );
+    EXPECT_EQUALS( ucCaptureLen, 6 );
+
+    TLog_SetOutput( 0 );
+}
+TEST_END
+
+//===========================================================================
+// Test Whitelist Goes Here
+//===========================================================================
+TEST_CASE_START
+  TEST_CASE(tlog_no_args),
+  TEST_CASE(tlog_arg_sizes),
+  TEST_CASE(tlog_disabled),
+TEST_CASE_END